@@ -0,0 +1,21 @@
+# Attempt to load Google Benchmark as CONFIG silently
+find_package(benchmark CONFIG QUIET)
+
+# If it was not found, fetch it instead.
+# Read the documentation of FetchContent first!
+# https://cmake.org/cmake/help/latest/module/FetchContent.html
+if(NOT benchmark_FOUND)
+
+    include(FetchContent)
+
+    set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+    set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+
+    FetchContent_Declare(benchmark
+      URL https://github.com/google/benchmark/archive/refs/tags/v1.8.3.zip
+    )
+    FetchContent_MakeAvailable(benchmark)
+
+    set(benchmark_FOUND 1)
+
+endif()
@@ -45,6 +45,56 @@ void SIMPLEBLE_EXPORT set_jvm(JavaVM* jvm);
 #endif
 
 #if defined(__linux__) && !defined(__ANDROID__)
-namespace SimpleBLE::Advanced::Linux {}
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace SimpleBLE::Advanced::Linux {
+
+struct SIMPLEBLE_EXPORT BusTraffic {
+    uint64_t messages = 0;
+    uint64_t bytes = 0;
+};
+
+struct SIMPLEBLE_EXPORT BusLatency {
+    uint64_t count = 0;
+    double mean_us = 0;
+    uint64_t p50_us = 0;
+    uint64_t p99_us = 0;
+    uint64_t max_us = 0;
+};
+
+struct SIMPLEBLE_EXPORT BusStats {
+    // Keyed by message type ("method_call", "method_return", "error", "signal").
+    std::map<std::string, BusTraffic> received_by_type;
+    std::map<std::string, BusTraffic> sent_by_type;
+
+    // Keyed by interface, for the messages that carry one.
+    std::map<std::string, BusTraffic> received_by_interface;
+    std::map<std::string, BusTraffic> sent_by_interface;
+
+    // Round trip of method calls, keyed by "interface.member".
+    std::map<std::string, BusLatency> call_latency;
+
+    // Time between a message being picked up from the bus and being handled.
+    BusLatency dispatch_lag;
+
+    // Time spent by signals waiting for a dispatch worker, see `Config::SimpleBluez::dispatch_workers`.
+    BusLatency worker_lag;
+
+    // Messages waiting in the incoming queue, sampled on every dispatch pass.
+    double queue_depth_mean = 0;
+    uint64_t queue_depth_max = 0;
+    uint64_t queue_depth_last = 0;
+};
+
+/**
+ * Snapshot of the DBus statistics of the BlueZ backend, collected while
+ * `Config::SimpleBluez::collect_bus_stats` is enabled. Empty for the legacy backend.
+ */
+BusStats SIMPLEBLE_EXPORT get_bus_stats();
+
+}  // namespace SimpleBLE::Advanced::Linux
 
 #endif
\ No newline at end of file
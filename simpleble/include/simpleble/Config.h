@@ -1,5 +1,7 @@
 #pragma once
 #include <chrono>
+#include <cstddef>
+#include <string>
 
 namespace SimpleBLE {
 namespace Config {
@@ -7,11 +9,26 @@ namespace Config {
         extern bool use_legacy_bluez_backend;
         extern std::chrono::steady_clock::duration connection_timeout;
         extern std::chrono::steady_clock::duration disconnection_timeout;
+        // Bound on connect, read, write and notify calls, 25 seconds by default as in libdbus.
+        extern std::chrono::steady_clock::duration method_call_timeout;
+        extern size_t dispatch_workers;
+        extern bool connection_per_adapter;
+        extern bool lazy_loading;
+        extern bool collect_bus_stats;
+        extern std::string bus_address;
+        extern std::string record_file;
 
         static void reset() {
             use_legacy_bluez_backend = true;
             connection_timeout = std::chrono::seconds(2);
             disconnection_timeout = std::chrono::seconds(1);
+            method_call_timeout = std::chrono::seconds(25);
+            dispatch_workers = 0;
+            connection_per_adapter = false;
+            lazy_loading = false;
+            collect_bus_stats = false;
+            bus_address = "";
+            record_file = "";
         }
     }
 
@@ -6,6 +6,13 @@ namespace Config {
         bool use_legacy_bluez_backend = true;
         std::chrono::steady_clock::duration connection_timeout = std::chrono::seconds(2);
         std::chrono::steady_clock::duration disconnection_timeout = std::chrono::seconds(1);
+        std::chrono::steady_clock::duration method_call_timeout = std::chrono::seconds(25);
+        size_t dispatch_workers = 0;
+        bool connection_per_adapter = false;
+        bool lazy_loading = false;
+        bool collect_bus_stats = false;
+        std::string bus_address = "";
+        std::string record_file = "";
     }  // namespace SimpleBluez
 
     namespace WinRT {
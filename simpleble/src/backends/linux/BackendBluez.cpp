@@ -3,6 +3,8 @@
 #include "BackendUtils.h"
 #include "CommonUtils.h"
 
+#include <simpleble/Advanced.h>
+#include <simpleble/Config.h>
 #include <simplebluez/Bluez.h>
 
 #include <atomic>
@@ -32,10 +34,50 @@ class BackendBluez : public BackendSingleton<BackendBluez> {
 
 std::shared_ptr<BackendBase> BACKEND_LINUX() { return BackendBluez::get(); }
 
-BackendBluez::BackendBluez(buildToken) {
+static Advanced::Linux::BusLatency bus_latency(const SimpleDBus::Histogram& histogram) {
+    return {histogram.count(), histogram.mean_us(), histogram.percentile_us(50), histogram.percentile_us(99),
+            histogram.max_us()};
+}
+
+static std::map<std::string, Advanced::Linux::BusTraffic> bus_traffic(
+    const std::map<std::string, SimpleDBus::ConnectionStats::Traffic>& traffic) {
+    std::map<std::string, Advanced::Linux::BusTraffic> result;
+    for (auto& [key, value] : traffic) {
+        result[key] = {value.messages, value.bytes};
+    }
+    return result;
+}
+
+Advanced::Linux::BusStats BACKEND_LINUX_BUS_STATS() {
+    SimpleDBus::ConnectionStats stats = BackendBluez::get()->bluez.stats();
+
+    Advanced::Linux::BusStats result;
+    result.received_by_type = bus_traffic(stats.received_by_type);
+    result.sent_by_type = bus_traffic(stats.sent_by_type);
+    result.received_by_interface = bus_traffic(stats.received_by_interface);
+    result.sent_by_interface = bus_traffic(stats.sent_by_interface);
+    for (auto& [method, histogram] : stats.call_latency) {
+        result.call_latency[method] = bus_latency(histogram);
+    }
+    result.dispatch_lag = bus_latency(stats.dispatch_lag);
+    result.worker_lag = bus_latency(stats.worker_lag);
+    result.queue_depth_mean = stats.queue_depth.mean();
+    result.queue_depth_max = stats.queue_depth.max;
+    result.queue_depth_last = stats.queue_depth.last;
+    return result;
+}
+
+BackendBluez::BackendBluez(buildToken) : bluez(Config::SimpleBluez::bus_address) {
     static std::mutex get_mutex;       // Static mutex to ensure thread safety when accessing the logger
     std::scoped_lock lock(get_mutex);  // Unlock the mutex on function return
 
+    bluez.set_dispatch_workers(Config::SimpleBluez::dispatch_workers);
+    bluez.set_connection_per_adapter(Config::SimpleBluez::connection_per_adapter);
+    bluez.set_lazy_loading(Config::SimpleBluez::lazy_loading);
+    bluez.set_stats_enabled(Config::SimpleBluez::collect_bus_stats);
+    if (!Config::SimpleBluez::record_file.empty()) {
+        bluez.start_recording(Config::SimpleBluez::record_file);
+    }
     bluez.init();
     async_thread_active = true;
     async_thread = new std::thread(&BackendBluez::async_thread_function, this);
@@ -45,6 +87,7 @@ BackendBluez::BackendBluez(buildToken) {
 
 BackendBluez::~BackendBluez() {
     async_thread_active = false;
+    bluez.wakeup();
     while (!async_thread->joinable()) {
         std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
@@ -83,7 +126,10 @@ void BackendBluez::async_thread_function() {
 
     while (async_thread_active) {
         SAFE_RUN({ bluez.run_async(); });
-        std::this_thread::sleep_for(std::chrono::microseconds(100));
+
+        // Sleep until there is bus traffic to process. The timeout is only a safety net,
+        // the destructor wakes up the thread when it needs to stop.
+        SAFE_RUN({ bluez.process_events(1000); });
     }
 }
 
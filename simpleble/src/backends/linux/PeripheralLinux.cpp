@@ -23,6 +23,10 @@ const SimpleBLE::BluetoothUUID BATTERY_CHARACTERISTIC_UUID = "00002a19-0000-1000
 using namespace SimpleBLE;
 using namespace std::chrono_literals;
 
+static std::chrono::milliseconds method_call_timeout() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Config::SimpleBluez::method_call_timeout);
+}
+
 PeripheralLinux::PeripheralLinux(std::shared_ptr<SimpleBluez::Device> device,
                                  std::shared_ptr<SimpleBluez::Adapter> adapter)
     : device_(std::move(device)), adapter_(std::move(adapter)) {}
@@ -217,7 +221,7 @@ ByteArray PeripheralLinux::read(BluetoothUUID const& service, BluetoothUUID cons
     }
 
     // Otherwise, attempt to read the characteristic using default mechanisms
-    return _get_characteristic(service, characteristic)->read();
+    return _get_characteristic(service, characteristic)->read(method_call_timeout());
 }
 
 void PeripheralLinux::write_request(BluetoothUUID const& service, BluetoothUUID const& characteristic,
@@ -225,7 +229,7 @@ void PeripheralLinux::write_request(BluetoothUUID const& service, BluetoothUUID
     // TODO: Check if the characteristic is writable.
     // TODO: SimpleBluez::Characteristic::write_request() should also take ByteArray by const reference (but that's
     // another library)
-    _get_characteristic(service, characteristic)->write_request(data);
+    _get_characteristic(service, characteristic)->write_request(data, method_call_timeout());
 }
 
 void PeripheralLinux::write_command(BluetoothUUID const& service, BluetoothUUID const& characteristic,
@@ -233,7 +237,7 @@ void PeripheralLinux::write_command(BluetoothUUID const& service, BluetoothUUID
     // TODO: Check if the characteristic is writable.
     // TODO: SimpleBluez::Characteristic::write_command() should also take ByteArray by const reference (but that's
     // another library)
-    _get_characteristic(service, characteristic)->write_command(data);
+    _get_characteristic(service, characteristic)->write_command(data, method_call_timeout());
 }
 
 void PeripheralLinux::notify(BluetoothUUID const& service, BluetoothUUID const& characteristic,
@@ -253,7 +257,7 @@ void PeripheralLinux::notify(BluetoothUUID const& service, BluetoothUUID const&
     // TODO: Check if the property can be notified.
     auto characteristic_object = _get_characteristic(service, characteristic);
     characteristic_object->set_on_value_changed([callback](SimpleBluez::ByteArray new_value) { callback(new_value); });
-    characteristic_object->start_notify();
+    characteristic_object->start_notify(method_call_timeout());
 }
 
 void PeripheralLinux::indicate(BluetoothUUID const& service, BluetoothUUID const& characteristic,
@@ -352,7 +356,7 @@ void PeripheralLinux::_cleanup_characteristics() noexcept {
 
 bool PeripheralLinux::_attempt_connect() {
     try {
-        device_->connect();
+        device_->connect(method_call_timeout());
     } catch (SimpleDBus::Exception::SendFailed const& e) {
         return false;
     }
@@ -42,6 +42,7 @@ BackendBluezLegacy::BackendBluezLegacy(buildToken) {
 
 BackendBluezLegacy::~BackendBluezLegacy() {
     async_thread_active = false;
+    bluez.wakeup();
     while (!async_thread->joinable()) {
         std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
@@ -80,7 +81,10 @@ void BackendBluezLegacy::async_thread_function() {
 
     while (async_thread_active) {
         SAFE_RUN({ bluez.run_async(); });
-        std::this_thread::sleep_for(std::chrono::microseconds(100));
+
+        // Sleep until there is bus traffic to process. The timeout is only a safety net,
+        // the destructor wakes up the thread when it needs to stop.
+        SAFE_RUN({ bluez.process_events(1000); });
     }
 }
 
@@ -24,6 +24,8 @@ class Bluez {
 
     void init();
     void run_async();
+    void process_events(int timeout_ms);
+    void wakeup();
 
     std::vector<std::shared_ptr<Adapter>> get_adapters();
     std::shared_ptr<Agent> get_agent();
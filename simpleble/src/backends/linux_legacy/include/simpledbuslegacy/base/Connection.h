@@ -1,9 +1,11 @@
 #pragma once
 
 #include <dbus/dbus.h>
+#include <chrono>
 #include <mutex>
 #include <unordered_map>
 #include <functional>
+#include <vector>
 #include "Message.h"
 
 namespace SimpleDBusLegacy {
@@ -26,6 +28,18 @@ class Connection {
     void read_write_dispatch();
     Message pop_message();
 
+    // ----- EVENT LOOP -----
+    /**
+     * @brief Block until the bus has pending I/O, an internal DBus timeout expires,
+     *        `wakeup()` is called or `timeout_ms` elapses, then perform the pending I/O.
+     *
+     * @param timeout_ms Maximum time to block, in milliseconds. A negative value blocks indefinitely.
+     *
+     * @note Incoming messages are only queued, use `pop_message()` to retrieve them.
+     */
+    void process_events(int timeout_ms);
+    void wakeup();
+
     void send(Message& msg);
     Message send_with_reply_and_block(Message& msg);
 
@@ -45,6 +59,27 @@ class Connection {
 
     static DBusHandlerResult static_message_handler(DBusConnection* connection, DBusMessage* message, void* user_data);
     std::unordered_map<std::string, std::function<void(Message&)>> _message_handlers;
+
+    // ----- EVENT LOOP -----
+    int _epoll_fd = -1;
+    int _wakeup_fd = -1;
+
+    std::mutex _watch_mutex;
+    std::unordered_map<int, std::vector<DBusWatch*>> _watches;
+    std::unordered_map<DBusTimeout*, std::chrono::steady_clock::time_point> _timeouts;
+
+    void _watch_update(int fd);
+    int _timeout_next(int timeout_ms);
+    void _timeout_handle();
+
+    static dbus_bool_t static_add_watch(DBusWatch* watch, void* data);
+    static void static_remove_watch(DBusWatch* watch, void* data);
+    static void static_toggle_watch(DBusWatch* watch, void* data);
+    static dbus_bool_t static_add_timeout(DBusTimeout* timeout, void* data);
+    static void static_remove_timeout(DBusTimeout* timeout, void* data);
+    static void static_toggle_timeout(DBusTimeout* timeout, void* data);
+    static void static_wakeup_main(void* data);
+    static void static_dispatch_status(DBusConnection* connection, DBusDispatchStatus new_status, void* data);
 };
 
 }  // namespace SimpleDBusLegacy
@@ -38,6 +38,10 @@ void Bluez::run_async() {
     }
 }
 
+void Bluez::process_events(int timeout_ms) { _conn->process_events(timeout_ms); }
+
+void Bluez::wakeup() { _conn->wakeup(); }
+
 std::vector<std::shared_ptr<Adapter>> Bluez::get_adapters() { return _bluez_root->get_adapters(); }
 
 std::shared_ptr<Agent> Bluez::get_agent() { return _bluez_root->get_agent(); }
@@ -1,6 +1,13 @@
 #include <simpledbuslegacy/base/Connection.h>
 #include <simpledbuslegacy/base/Exceptions.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
 #include <chrono>
+#include <cstring>
+#include <stdexcept>
 #include <thread>
 
 using namespace SimpleDBusLegacy;
@@ -24,13 +31,42 @@ void Connection::init() {
     dbus_error_init(&err);
 
     dbus_threads_init_default();
-    _conn = dbus_bus_get(_dbus_bus_type, &err);
+
+    // NOTE: A private connection is used as we take over the main loop integration of the
+    // connection, which would otherwise conflict with any other user of the shared connection.
+    _conn = dbus_bus_get_private(_dbus_bus_type, &err);
     if (dbus_error_is_set(&err)) {
         std::string err_name = err.name;
         std::string err_message = err.message;
         dbus_error_free(&err);
         throw Exception::DBusException(err_name, err_message);
     }
+
+    _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    _wakeup_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (_epoll_fd < 0 || _wakeup_fd < 0) {
+        std::string err_message = strerror(errno);
+        if (_epoll_fd >= 0) close(_epoll_fd);
+        if (_wakeup_fd >= 0) close(_wakeup_fd);
+        _epoll_fd = -1;
+        _wakeup_fd = -1;
+        dbus_connection_close(_conn);
+        dbus_connection_unref(_conn);
+        throw std::runtime_error("Failed to create event loop: " + err_message);
+    }
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = _wakeup_fd;
+    epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _wakeup_fd, &event);
+
+    dbus_connection_set_watch_functions(_conn, &Connection::static_add_watch, &Connection::static_remove_watch,
+                                        &Connection::static_toggle_watch, this, nullptr);
+    dbus_connection_set_timeout_functions(_conn, &Connection::static_add_timeout, &Connection::static_remove_timeout,
+                                          &Connection::static_toggle_timeout, this, nullptr);
+    dbus_connection_set_wakeup_main_function(_conn, &Connection::static_wakeup_main, this, nullptr);
+    dbus_connection_set_dispatch_status_function(_conn, &Connection::static_dispatch_status, this, nullptr);
+
     _initialized = true;
 }
 
@@ -50,10 +86,26 @@ void Connection::uninit() {
         message = pop_message();
     } while (message.is_valid());
 
+    // Detach the event loop before releasing the connection.
+    dbus_connection_set_dispatch_status_function(_conn, nullptr, nullptr, nullptr);
+    dbus_connection_set_wakeup_main_function(_conn, nullptr, nullptr, nullptr);
+    dbus_connection_set_timeout_functions(_conn, nullptr, nullptr, nullptr, nullptr, nullptr);
+    dbus_connection_set_watch_functions(_conn, nullptr, nullptr, nullptr, nullptr, nullptr);
+
+    dbus_connection_close(_conn);
     dbus_connection_unref(_conn);
+
+    close(_wakeup_fd);
+    close(_epoll_fd);
+    _wakeup_fd = -1;
+    _epoll_fd = -1;
+    _watches.clear();
+    _timeouts.clear();
+
     _initialized = false;
 }
 
+
 bool Connection::is_initialized() { return _initialized; }
 
 void Connection::add_match(std::string rule) {
@@ -122,6 +174,81 @@ void Connection::read_write_dispatch() {
     while (dbus_connection_dispatch(_conn) == DBUS_DISPATCH_DATA_REMAINS) {}
 }
 
+void Connection::process_events(int timeout_ms) {
+    if (!_initialized) {
+        throw Exception::NotInitialized();
+    }
+
+    epoll_event events[8];
+    int count = epoll_wait(_epoll_fd, events, 8, _timeout_next(timeout_ms));
+    if (count < 0) {
+        if (errno == EINTR) {
+            return;
+        }
+        throw std::runtime_error(std::string("Failed to wait for events: ") + strerror(errno));
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+
+    for (int i = 0; i < count; i++) {
+        int fd = events[i].data.fd;
+
+        if (fd == _wakeup_fd) {
+            uint64_t value;
+            while (read(_wakeup_fd, &value, sizeof(value)) > 0) {}
+            continue;
+        }
+
+        unsigned int flags = 0;
+        if (events[i].events & EPOLLIN) flags |= DBUS_WATCH_READABLE;
+        if (events[i].events & EPOLLOUT) flags |= DBUS_WATCH_WRITABLE;
+        if (events[i].events & EPOLLERR) flags |= DBUS_WATCH_ERROR;
+        if (events[i].events & EPOLLHUP) flags |= DBUS_WATCH_HANGUP;
+
+        // Handling a watch can cause libdbus to add or remove watches, so the
+        // watch list is re-validated before every call into libdbus.
+        std::vector<DBusWatch*> watches;
+        {
+            std::lock_guard<std::mutex> watch_lock(_watch_mutex);
+            auto it = _watches.find(fd);
+            if (it != _watches.end()) {
+                watches = it->second;
+            }
+        }
+
+        for (DBusWatch* watch : watches) {
+            {
+                std::lock_guard<std::mutex> watch_lock(_watch_mutex);
+                auto it = _watches.find(fd);
+                if (it == _watches.end() || std::find(it->second.begin(), it->second.end(), watch) == it->second.end()) {
+                    continue;
+                }
+            }
+
+            if (!dbus_watch_get_enabled(watch)) {
+                continue;
+            }
+
+            unsigned int watch_flags = flags & (dbus_watch_get_flags(watch) | DBUS_WATCH_ERROR | DBUS_WATCH_HANGUP);
+            if (watch_flags != 0) {
+                dbus_watch_handle(watch, watch_flags);
+            }
+        }
+    }
+
+    _timeout_handle();
+}
+
+void Connection::wakeup() {
+    if (_wakeup_fd < 0) {
+        return;
+    }
+
+    uint64_t value = 1;
+    // The result is ignored, a failed write means the counter is already non-zero.
+    [[maybe_unused]] ssize_t result = write(_wakeup_fd, &value, sizeof(value));
+}
+
 Message Connection::pop_message() {
     // TODO: DEPRECATE
     if (!_initialized) {
@@ -216,4 +343,149 @@ DBusHandlerResult Connection::static_message_handler(DBusConnection* connection,
     }
 
     return DBUS_HANDLER_RESULT_HANDLED;
-}
\ No newline at end of file
+}
+
+// ----- EVENT LOOP -----
+
+void Connection::_watch_update(int fd) {
+    // NOTE: Must be called with `_watch_mutex` held.
+    auto it = _watches.find(fd);
+    if (it == _watches.end()) {
+        return;
+    }
+
+    if (it->second.empty()) {
+        epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+        _watches.erase(it);
+        return;
+    }
+
+    epoll_event event = {};
+    event.data.fd = fd;
+    for (DBusWatch* watch : it->second) {
+        if (!dbus_watch_get_enabled(watch)) {
+            continue;
+        }
+
+        unsigned int flags = dbus_watch_get_flags(watch);
+        if (flags & DBUS_WATCH_READABLE) event.events |= EPOLLIN;
+        if (flags & DBUS_WATCH_WRITABLE) event.events |= EPOLLOUT;
+    }
+
+    if (epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, fd, &event) < 0 && errno == ENOENT) {
+        epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &event);
+    }
+}
+
+int Connection::_timeout_next(int timeout_ms) {
+    std::lock_guard<std::mutex> watch_lock(_watch_mutex);
+
+    auto now = std::chrono::steady_clock::now();
+    for (auto& [timeout, deadline] : _timeouts) {
+        if (!dbus_timeout_get_enabled(timeout)) {
+            continue;
+        }
+
+        auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - now).count();
+        int remaining_ms = static_cast<int>(std::max<decltype(remaining)>(remaining, 0));
+        if (timeout_ms < 0 || remaining_ms < timeout_ms) {
+            timeout_ms = remaining_ms;
+        }
+    }
+
+    return timeout_ms;
+}
+
+void Connection::_timeout_handle() {
+    std::vector<DBusTimeout*> expired;
+    {
+        std::lock_guard<std::mutex> watch_lock(_watch_mutex);
+        auto now = std::chrono::steady_clock::now();
+        for (auto& [timeout, deadline] : _timeouts) {
+            if (dbus_timeout_get_enabled(timeout) && deadline <= now) {
+                // DBus timeouts are periodic until they get removed or disabled.
+                deadline = now + std::chrono::milliseconds(dbus_timeout_get_interval(timeout));
+                expired.push_back(timeout);
+            }
+        }
+    }
+
+    for (DBusTimeout* timeout : expired) {
+        {
+            std::lock_guard<std::mutex> watch_lock(_watch_mutex);
+            if (_timeouts.find(timeout) == _timeouts.end()) {
+                continue;
+            }
+        }
+        dbus_timeout_handle(timeout);
+    }
+}
+
+dbus_bool_t Connection::static_add_watch(DBusWatch* watch, void* data) {
+    Connection* conn = static_cast<Connection*>(data);
+    int fd = dbus_watch_get_unix_fd(watch);
+
+    std::lock_guard<std::mutex> watch_lock(conn->_watch_mutex);
+    conn->_watches[fd].push_back(watch);
+    conn->_watch_update(fd);
+    return TRUE;
+}
+
+void Connection::static_remove_watch(DBusWatch* watch, void* data) {
+    Connection* conn = static_cast<Connection*>(data);
+    int fd = dbus_watch_get_unix_fd(watch);
+
+    std::lock_guard<std::mutex> watch_lock(conn->_watch_mutex);
+    auto it = conn->_watches.find(fd);
+    if (it != conn->_watches.end()) {
+        it->second.erase(std::remove(it->second.begin(), it->second.end(), watch), it->second.end());
+        conn->_watch_update(fd);
+    }
+}
+
+void Connection::static_toggle_watch(DBusWatch* watch, void* data) {
+    Connection* conn = static_cast<Connection*>(data);
+
+    std::lock_guard<std::mutex> watch_lock(conn->_watch_mutex);
+    conn->_watch_update(dbus_watch_get_unix_fd(watch));
+}
+
+dbus_bool_t Connection::static_add_timeout(DBusTimeout* timeout, void* data) {
+    Connection* conn = static_cast<Connection*>(data);
+
+    std::lock_guard<std::mutex> watch_lock(conn->_watch_mutex);
+    auto interval = std::chrono::milliseconds(dbus_timeout_get_interval(timeout));
+    conn->_timeouts[timeout] = std::chrono::steady_clock::now() + interval;
+    return TRUE;
+}
+
+void Connection::static_remove_timeout(DBusTimeout* timeout, void* data) {
+    Connection* conn = static_cast<Connection*>(data);
+
+    std::lock_guard<std::mutex> watch_lock(conn->_watch_mutex);
+    conn->_timeouts.erase(timeout);
+}
+
+void Connection::static_toggle_timeout(DBusTimeout* timeout, void* data) {
+    Connection* conn = static_cast<Connection*>(data);
+
+    {
+        // Re-enabled timeouts start counting from the moment they get enabled.
+        std::lock_guard<std::mutex> watch_lock(conn->_watch_mutex);
+        auto interval = std::chrono::milliseconds(dbus_timeout_get_interval(timeout));
+        conn->_timeouts[timeout] = std::chrono::steady_clock::now() + interval;
+    }
+
+    // The event loop might be blocked waiting for a longer period of time.
+    conn->wakeup();
+}
+
+void Connection::static_wakeup_main(void* data) { static_cast<Connection*>(data)->wakeup(); }
+
+void Connection::static_dispatch_status(DBusConnection* connection, DBusDispatchStatus new_status, void* data) {
+    // Messages can be queued without the socket becoming readable (for example, if they were
+    // read while another thread was waiting for a reply), so the event loop must be woken up.
+    if (new_status == DBUS_DISPATCH_DATA_REMAINS) {
+        static_cast<Connection*>(data)->wakeup();
+    }
+}
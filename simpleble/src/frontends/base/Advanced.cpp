@@ -29,6 +29,26 @@ void set_jvm(JavaVM* jvm) { SimpleJNI::VM::jvm(jvm); }
 #endif
 
 #if defined(__linux__) && !defined(__ANDROID__)
-namespace SimpleBLE::Advanced::Linux {}
+
+#include <simpleble/Config.h>
+
+namespace SimpleBLE {
+// NOTE: Defined by the BlueZ backend.
+Advanced::Linux::BusStats BACKEND_LINUX_BUS_STATS();
+}  // namespace SimpleBLE
+
+namespace SimpleBLE::Advanced::Linux {
+
+BusStats get_bus_stats() {
+    if constexpr (SIMPLEBLE_BACKEND_LINUX) {
+        if (!Config::SimpleBluez::use_legacy_bluez_backend) {
+            return BACKEND_LINUX_BUS_STATS();
+        }
+    }
+
+    return {};
+}
+
+}  // namespace SimpleBLE::Advanced::Linux
 
 #endif
\ No newline at end of file
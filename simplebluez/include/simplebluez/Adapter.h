@@ -11,6 +11,12 @@
 
 namespace SimpleBluez {
 
+// Provides the connection that the adapter at `path` and all of its devices are served on.
+typedef std::function<std::shared_ptr<SimpleDBus::Connection>(const std::string& path)> AdapterConnectionFactory;
+
+// Builds the proxies of the object at `path` if their loading was deferred.
+typedef std::function<void(const std::string& path)> ObjectLoader;
+
 class Adapter : public SimpleDBus::Proxy {
   public:
     typedef Adapter1::DiscoveryFilter DiscoveryFilter;
@@ -18,6 +24,8 @@ class Adapter : public SimpleDBus::Proxy {
     Adapter(std::shared_ptr<SimpleDBus::Connection> conn, const std::string& bus_name, const std::string& path);
     virtual ~Adapter();
 
+    void set_object_loader(ObjectLoader loader);
+
     std::string identifier() const;
     std::string address();
     bool discovering();
@@ -40,6 +48,8 @@ class Adapter : public SimpleDBus::Proxy {
 
     std::shared_ptr<Adapter1> adapter1();
 
+    ObjectLoader _object_loader;
+
     kvn::safe_callback<void(std::shared_ptr<Device> device)> _on_device_updated;
 };
 
@@ -6,6 +6,12 @@
 #include <simplebluez/Adapter.h>
 #include <simplebluez/Agent.h>
 
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
 
 namespace SimpleBluez {
@@ -13,6 +19,12 @@ namespace SimpleBluez {
 class Bluez {
   public:
     Bluez();
+
+    /**
+     * @brief Connect to a peer at `address` instead of the system bus, such as a
+     *        `SimpleDBus::Replayer` serving a recording. An empty address uses the bus.
+     */
+    explicit Bluez(const std::string& address);
     virtual ~Bluez();
 
     // Delete copy and move operations
@@ -21,16 +33,73 @@ class Bluez {
     Bluez(Bluez&&) = delete;
     Bluez& operator=(Bluez&&) = delete;
 
+    /**
+     * @brief Handle signals on a pool of `workers` threads, so that the callbacks of different
+     *        devices run in parallel while those of each device keep their order. Must be
+     *        called before `init`.
+     */
+    void set_dispatch_workers(size_t workers);
+
+    /**
+     * @brief Serve every adapter and its devices over a private bus connection, with its own
+     *        event loop thread, so that the traffic of one adapter can't hold back that of the
+     *        others. `run_async` keeps driving the object tree and the agent. Must be called
+     *        before `init`, and is ignored when connected to a peer address.
+     */
+    void set_connection_per_adapter(bool enabled);
+
+    /**
+     * @brief Only build adapters, and paired or connected devices, at startup. The other devices
+     *        BlueZ has cached are built along with their services, characteristics and descriptors
+     *        when they are looked up with `Adapter::device_get` or when they are first signalled,
+     *        such as when they are seen while scanning. Must be called before `init`.
+     */
+    void set_lazy_loading(bool enabled);
+
     void init();
     void run_async();
+    void process_events(int timeout_ms);
+    void wakeup();
+
+    /**
+     * @brief Start or stop collecting statistics of the underlying bus connections, which
+     *        are reported together.
+     */
+    void set_stats_enabled(bool enabled);
+    SimpleDBus::ConnectionStats stats();
+
+    /**
+     * @brief Record all bus traffic into `filename`, to be replayed by a `SimpleDBus::Replayer`.
+     *
+     * @note Only the main connection is recorded, adapter connections are not.
+     */
+    void start_recording(const std::string& filename);
+    void stop_recording();
 
     std::vector<std::shared_ptr<Adapter>> get_adapters();
     std::shared_ptr<Agent> get_agent();
     void register_agent();
 
   private:
+    struct AdapterConnection {
+        std::shared_ptr<SimpleDBus::Connection> conn;
+        std::thread thread;
+        std::atomic_bool active = true;
+    };
+
+    std::string _address;
     std::shared_ptr<SimpleDBus::Connection> _conn;
     std::shared_ptr<SimpleBluez::BluezRoot> _bluez_root;
+
+    size_t _dispatch_workers = 0;
+    bool _stats_enabled = false;
+    bool _connection_per_adapter = false;
+    bool _lazy_loading = false;
+
+    std::mutex _adapter_connections_mutex;
+    std::map<std::string, std::unique_ptr<AdapterConnection>> _adapter_connections;
+
+    std::shared_ptr<SimpleDBus::Connection> _adapter_connection(const std::string& path);
 };
 
 }  // namespace SimpleBluez
@@ -12,10 +12,16 @@ class BluezOrg : public SimpleDBus::Proxy {
     BluezOrg(std::shared_ptr<SimpleDBus::Connection> conn, const std::string& bus_name, const std::string& path);
     virtual ~BluezOrg() = default;
 
+    void set_adapter_connection_factory(AdapterConnectionFactory factory);
+    void set_object_loader(ObjectLoader loader);
+
     std::vector<std::shared_ptr<Adapter>> get_adapters();
     void register_agent(std::shared_ptr<Agent> agent);
 
   private:
+    AdapterConnectionFactory _adapter_connection_factory;
+    ObjectLoader _object_loader;
+
     std::shared_ptr<SimpleDBus::Proxy> path_create(const std::string& path) override;
 };
 
@@ -14,11 +14,17 @@ class BluezOrgBluez : public SimpleDBus::Proxy {
     BluezOrgBluez(std::shared_ptr<SimpleDBus::Connection> conn, const std::string& bus_name, const std::string& path);
     virtual ~BluezOrgBluez() = default;
 
+    void set_adapter_connection_factory(AdapterConnectionFactory factory);
+    void set_object_loader(ObjectLoader loader);
+
     void register_agent(std::shared_ptr<Agent> agent);
 
     std::vector<std::shared_ptr<Adapter>> get_adapters();
 
   private:
+    AdapterConnectionFactory _adapter_connection_factory;
+    ObjectLoader _object_loader;
+
     std::shared_ptr<SimpleDBus::Proxy> path_create(const std::string& path) override;
     std::shared_ptr<AgentManager1> agentmanager1();
 };
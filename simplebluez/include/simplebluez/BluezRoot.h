@@ -1,11 +1,18 @@
 #pragma once
 
 #include <simpledbus/advanced/Proxy.h>
+#include <simpledbus/base/Cursor.h>
+#include <simpledbus/base/Message.h>
 #include <simpledbus/interfaces/ObjectManager.h>
 
 #include <simplebluez/Adapter.h>
 #include <simplebluez/Agent.h>
 
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace SimpleBluez {
@@ -15,8 +22,28 @@ class BluezRoot : public SimpleDBus::Proxy {
     BluezRoot(std::shared_ptr<SimpleDBus::Connection> conn, const std::string& bus_name, const std::string& path);
     virtual ~BluezRoot() = default;
 
+    /**
+     * @brief Serve adapters created from now on over the connections provided by `factory`
+     *        instead of the connection of this proxy.
+     */
+    void set_adapter_connection_factory(AdapterConnectionFactory factory);
+
+    /**
+     * @brief Only build the proxies of adapters, and of paired or connected devices, when the
+     *        managed objects are loaded. Other devices are built along with their attributes
+     *        when they are first looked up or signalled. Must be called before
+     *        `load_managed_objects`.
+     */
+    void set_lazy_loading(bool enabled);
+
     void load_managed_objects();
 
+    /**
+     * @brief Build the deferred proxies of the device `path` belongs to. Returns whether any
+     *        proxy was built.
+     */
+    bool load_deferred(std::string_view path);
+
     std::vector<std::shared_ptr<Adapter>> get_adapters();
     std::shared_ptr<Agent> get_agent();
     void register_agent();
@@ -25,8 +52,23 @@ class BluezRoot : public SimpleDBus::Proxy {
     void on_registration() override;
 
   private:
+    AdapterConnectionFactory _adapter_connection_factory;
+
     std::shared_ptr<Agent> _agent;
 
+    bool _lazy_loading = false;
+    std::mutex _deferred_mutex;
+    // Objects not built yet, read out of the reply of GetManagedObjects, which is kept for as
+    // long as any of them is left.
+    SimpleDBus::Message _deferred_reply;
+    std::map<std::string, SimpleDBus::Cursor, std::less<>> _deferred_objects;
+    // Devices whose deferred objects are being built, with the number of threads building them.
+    std::map<std::string, size_t, std::less<>> _loading_devices;
+
+    // Drops the deferred object `path` if `options` removes all of its interfaces, returning
+    // whether it did so. Objects being built are left to the regular removal.
+    bool unload_deferred(std::string_view path, const SimpleDBus::Holder& options);
+
     std::shared_ptr<SimpleDBus::Proxy> path_create(const std::string& path) override;
     std::shared_ptr<SimpleDBus::Interfaces::ObjectManager> object_manager();
 };
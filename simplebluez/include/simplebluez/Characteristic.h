@@ -6,6 +6,7 @@
 #include <simplebluez/Types.h>
 #include <simplebluez/interfaces/GattCharacteristic1.h>
 
+#include <chrono>
 #include <cstdlib>
 
 namespace SimpleBluez {
@@ -18,10 +19,11 @@ class Characteristic : public SimpleDBus::Proxy {
     std::shared_ptr<Descriptor> get_descriptor(const std::string& uuid);
 
     // ----- METHODS -----
-    ByteArray read();
-    void write_request(ByteArray value);
-    void write_command(ByteArray value);
-    void start_notify();
+    // NOTE: In-flight calls fail with `SimpleDBus::Connection::ERROR_CANCELLED` if the device disconnects.
+    ByteArray read(std::chrono::milliseconds timeout = SimpleDBus::Connection::TIMEOUT_DEFAULT);
+    void write_request(ByteArray value, std::chrono::milliseconds timeout = SimpleDBus::Connection::TIMEOUT_DEFAULT);
+    void write_command(ByteArray value, std::chrono::milliseconds timeout = SimpleDBus::Connection::TIMEOUT_DEFAULT);
+    void start_notify(std::chrono::milliseconds timeout = SimpleDBus::Connection::TIMEOUT_DEFAULT);
     void stop_notify();
 
     // ----- PROPERTIES -----
@@ -37,7 +37,7 @@ class Device : public SimpleDBus::Proxy {
     bool services_resolved();
 
     // ----- METHODS -----
-    void connect();
+    void connect(std::chrono::milliseconds timeout = SimpleDBus::Connection::TIMEOUT_DEFAULT);
     void disconnect();
     void pair();
     void cancel_pairing();
@@ -40,7 +40,12 @@ class Adapter1 : public SimpleDBus::Interface {
     std::string Address();
 
   protected:
-    void property_changed(std::string option_name) override;
+    // ----- PROPERTY TABLE -----
+    static constexpr SimpleDBus::Property<bool> PROPERTY_DISCOVERING{0, "Discovering"};
+    static constexpr SimpleDBus::Property<bool> PROPERTY_POWERED{1, "Powered"};
+    static constexpr SimpleDBus::Property<std::string> PROPERTY_ADDRESS{2, "Address"};
+
+    static const SimpleDBus::PropertyTable& property_table();
 
   private:
     static const SimpleDBus::AutoRegisterInterface<Adapter1> registry;
@@ -23,7 +23,12 @@ class Battery1 : public SimpleDBus::Interface {
     kvn::safe_callback<void()> OnPercentageChanged;
 
   protected:
-    void property_changed(std::string option_name) override;
+    // ----- PROPERTY TABLE -----
+    static constexpr SimpleDBus::Property<uint8_t> PROPERTY_PERCENTAGE{0, "Percentage"};
+
+    static const SimpleDBus::PropertyTable& property_table();
+
+    void on_property_changed(SimpleDBus::PropertyId id) override;
 
   private:
     static const SimpleDBus::AutoRegisterInterface<Battery1> registry;
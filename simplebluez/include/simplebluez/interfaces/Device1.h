@@ -5,6 +5,7 @@
 
 #include "kvn/kvn_safe_callback.hpp"
 
+#include <chrono>
 #include <string>
 
 #include "simplebluez/Types.h"
@@ -17,7 +18,7 @@ class Device1 : public SimpleDBus::Interface {
     virtual ~Device1();
 
     // ----- METHODS -----
-    void Connect();
+    void Connect(std::chrono::milliseconds timeout = SimpleDBus::Connection::TIMEOUT_DEFAULT);
     void Disconnect();
     void Pair();
     void CancelPairing();
@@ -42,7 +43,24 @@ class Device1 : public SimpleDBus::Interface {
     kvn::safe_callback<void()> OnDisconnected;
 
   protected:
-    void property_changed(std::string option_name) override;
+    // ----- PROPERTY TABLE -----
+    static constexpr SimpleDBus::Property<std::string> PROPERTY_ADDRESS{0, "Address"};
+    static constexpr SimpleDBus::Property<std::string> PROPERTY_ADDRESS_TYPE{1, "AddressType"};
+    static constexpr SimpleDBus::Property<std::string> PROPERTY_ALIAS{2, "Alias"};
+    static constexpr SimpleDBus::Property<std::string> PROPERTY_NAME{3, "Name"};
+    static constexpr SimpleDBus::Property<uint16_t> PROPERTY_APPEARANCE{4, "Appearance"};
+    static constexpr SimpleDBus::Property<int16_t> PROPERTY_RSSI{5, "RSSI"};
+    static constexpr SimpleDBus::Property<int16_t> PROPERTY_TX_POWER{6, "TxPower"};
+    static constexpr SimpleDBus::Property<std::vector<std::string>> PROPERTY_UUIDS{7, "UUIDs"};
+    static constexpr SimpleDBus::Property<SimpleDBus::Holder> PROPERTY_MANUFACTURER_DATA{8, "ManufacturerData"};
+    static constexpr SimpleDBus::Property<SimpleDBus::Holder> PROPERTY_SERVICE_DATA{9, "ServiceData"};
+    static constexpr SimpleDBus::Property<bool> PROPERTY_PAIRED{10, "Paired"};
+    static constexpr SimpleDBus::Property<bool> PROPERTY_CONNECTED{11, "Connected"};
+    static constexpr SimpleDBus::Property<bool> PROPERTY_SERVICES_RESOLVED{12, "ServicesResolved"};
+
+    static const SimpleDBus::PropertyTable& property_table();
+
+    void on_property_changed(SimpleDBus::PropertyId id) override;
 
     int16_t _rssi = INT16_MIN;
     int16_t _tx_power = INT16_MIN;
@@ -56,6 +74,9 @@ class Device1 : public SimpleDBus::Interface {
     std::map<std::string, ByteArray> _service_data;
 
   private:
+    // Subscribes to the updates of the device while it is connected or paired.
+    void match_update();
+
     static const SimpleDBus::AutoRegisterInterface<Device1> registry;
 };
 
@@ -7,6 +7,7 @@
 
 #include <simplebluez/Types.h>
 
+#include <chrono>
 #include <string>
 
 namespace SimpleBluez {
@@ -19,10 +20,10 @@ class GattCharacteristic1 : public SimpleDBus::Interface {
     virtual ~GattCharacteristic1();
 
     // ----- METHODS -----
-    void StartNotify();
+    void StartNotify(std::chrono::milliseconds timeout = SimpleDBus::Connection::TIMEOUT_DEFAULT);
     void StopNotify();
-    void WriteValue(const ByteArray& value, WriteType type);
-    ByteArray ReadValue();
+    void WriteValue(const ByteArray& value, WriteType type, std::chrono::milliseconds timeout = SimpleDBus::Connection::TIMEOUT_DEFAULT);
+    ByteArray ReadValue(std::chrono::milliseconds timeout = SimpleDBus::Connection::TIMEOUT_DEFAULT);
 
     // ----- PROPERTIES -----
     std::string UUID();
@@ -35,13 +36,25 @@ class GattCharacteristic1 : public SimpleDBus::Interface {
     kvn::safe_callback<void()> OnValueChanged;
 
   protected:
-    void property_changed(std::string option_name) override;
-    void update_value(SimpleDBus::Holder& new_value);
+    // ----- PROPERTY TABLE -----
+    static constexpr SimpleDBus::Property<std::string> PROPERTY_UUID{0, "UUID"};
+    // Every notification is reported, even if it carries the same value as the previous one.
+    static constexpr SimpleDBus::Property<SimpleDBus::Holder> PROPERTY_VALUE{1, "Value", true};
+    static constexpr SimpleDBus::Property<bool> PROPERTY_NOTIFYING{2, "Notifying"};
+    static constexpr SimpleDBus::Property<std::vector<std::string>> PROPERTY_FLAGS{3, "Flags"};
+    static constexpr SimpleDBus::Property<uint16_t> PROPERTY_MTU{4, "MTU"};
+
+    static const SimpleDBus::PropertyTable& property_table();
+
+    void on_property_changed(SimpleDBus::PropertyId id) override;
+    void update_value(const SimpleDBus::Holder& new_value);
+    void update_value(ByteArray new_value);
 
-    std::string _uuid;
     ByteArray _value;
 
   private:
+    const SimpleDBus::CallTemplate _write_value_call;
+
     static const SimpleDBus::AutoRegisterInterface<GattCharacteristic1> registry;
 };
 
@@ -28,10 +28,16 @@ class GattDescriptor1 : public SimpleDBus::Interface {
     kvn::safe_callback<void()> OnValueChanged;
 
   protected:
-    void property_changed(std::string option_name) override;
-    void update_value(SimpleDBus::Holder& new_value);
+    // ----- PROPERTY TABLE -----
+    static constexpr SimpleDBus::Property<std::string> PROPERTY_UUID{0, "UUID"};
+    static constexpr SimpleDBus::Property<SimpleDBus::Holder> PROPERTY_VALUE{1, "Value"};
+
+    static const SimpleDBus::PropertyTable& property_table();
+
+    void on_property_changed(SimpleDBus::PropertyId id) override;
+    void update_value(const SimpleDBus::Holder& new_value);
+    void update_value(ByteArray new_value);
 
-    std::string _uuid;
     ByteArray _value;
 
   private:
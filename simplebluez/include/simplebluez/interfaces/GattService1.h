@@ -17,9 +17,10 @@ class GattService1 : public SimpleDBus::Interface {
     std::string UUID();
 
   protected:
-    void property_changed(std::string option_name) override;
+    // ----- PROPERTY TABLE -----
+    static constexpr SimpleDBus::Property<std::string> PROPERTY_UUID{0, "UUID"};
 
-    std::string _uuid;
+    static const SimpleDBus::PropertyTable& property_table();
 
   private:
     static const SimpleDBus::AutoRegisterInterface<GattService1> registry;
@@ -10,6 +10,8 @@ Adapter::Adapter(std::shared_ptr<SimpleDBus::Connection> conn, const std::string
 
 Adapter::~Adapter() {}
 
+void Adapter::set_object_loader(ObjectLoader loader) { _object_loader = std::move(loader); }
+
 std::shared_ptr<SimpleDBus::Proxy> Adapter::path_create(const std::string& path) {
     auto child = Proxy::create<Device>(_conn, _bus_name, path);
     child->on_signal_received.load([this, child]() { _on_device_updated(child); });
@@ -38,6 +40,9 @@ void Adapter::discovery_start() { adapter1()->StartDiscovery(); }
 void Adapter::discovery_stop() { adapter1()->StopDiscovery(); }
 
 std::shared_ptr<Device> Adapter::device_get(const std::string& path) {
+    if (_object_loader) {
+        _object_loader(path);
+    }
     return std::dynamic_pointer_cast<Device>(path_get(path));
 }
 
@@ -1,4 +1,5 @@
 #include <simplebluez/Bluez.h>
+#include <simpledbus/base/Logging.h>
 #include <simpledbus/interfaces/ObjectManager.h>
 
 using namespace SimpleBluez;
@@ -9,19 +10,67 @@ using namespace SimpleBluez;
 #define DBUS_BUS DBUS_BUS_SYSTEM
 #endif
 
+// NOTE: Only the object tree and the adapters are always tracked, updates of devices and
+//       characteristics are subscribed to by their interfaces while they are in use.
+static const char* MATCH_OBJECT_MANAGER =
+    "type='signal',sender='org.bluez',path='/',interface='org.freedesktop.DBus.ObjectManager'";
+static const char* MATCH_ADAPTER_PROPERTIES =
+    "type='signal',sender='org.bluez',interface='org.freedesktop.DBus.Properties',member='PropertiesChanged',"
+    "arg0='org.bluez.Adapter1'";
+
 Bluez::Bluez() : _conn(std::make_shared<SimpleDBus::Connection>(DBUS_BUS)) {}
 
+Bluez::Bluez(const std::string& address)
+    : _address(address),
+      _conn(address.empty() ? std::make_shared<SimpleDBus::Connection>(DBUS_BUS)
+                            : std::make_shared<SimpleDBus::Connection>(address)) {}
+
 Bluez::~Bluez() {
+    {
+        std::scoped_lock lock(_adapter_connections_mutex);
+        for (auto& [path, adapter_conn] : _adapter_connections) {
+            adapter_conn->active = false;
+            adapter_conn->conn->set_signal_fallback(nullptr);
+            adapter_conn->conn->wakeup();
+            adapter_conn->thread.join();
+        }
+    }
+
+    _conn->set_signal_fallback(nullptr);
     if (_conn->is_initialized()) {
-        _conn->remove_match("type='signal',sender='org.bluez'");
+        _conn->remove_match(MATCH_OBJECT_MANAGER);
+        _conn->remove_match(MATCH_ADAPTER_PROPERTIES);
     }
 }
 
+void Bluez::set_dispatch_workers(size_t workers) {
+    // Signals are sharded by device, i.e. the first four segments of /org/bluez/hciX/dev_Y,
+    // so that the updates of a device and of its attributes are handled in order.
+    _dispatch_workers = workers;
+    _conn->set_dispatch_workers(workers, 4);
+}
+
+void Bluez::set_connection_per_adapter(bool enabled) { _connection_per_adapter = enabled && _address.empty(); }
+
+void Bluez::set_lazy_loading(bool enabled) { _lazy_loading = enabled; }
+
 void Bluez::init() {
     _conn->init();
-    _conn->add_match("type='signal',sender='org.bluez'");
+    _conn->add_match(MATCH_OBJECT_MANAGER);
+    if (!_connection_per_adapter) {
+        _conn->add_match(MATCH_ADAPTER_PROPERTIES);
+    }
 
     _bluez_root = SimpleDBus::Proxy::create<BluezRoot>(_conn, "org.bluez", "/");
+    _bluez_root->set_lazy_loading(_lazy_loading);
+    if (_lazy_loading) {
+        // Signals of objects that haven't been built yet build them on arrival.
+        _conn->set_signal_fallback([this](std::string_view path) { return _bluez_root->load_deferred(path); });
+    }
+    if (_connection_per_adapter) {
+        _bluez_root->set_adapter_connection_factory(
+            [this](const std::string& path) { return _adapter_connection(path); });
+    }
     _bluez_root->load_managed_objects();
 }
 
@@ -29,8 +78,79 @@ void Bluez::run_async() {
     _conn->read_write_dispatch();
 }
 
+void Bluez::process_events(int timeout_ms) { _conn->process_events(timeout_ms); }
+
+void Bluez::wakeup() { _conn->wakeup(); }
+
+void Bluez::set_stats_enabled(bool enabled) {
+    _stats_enabled = enabled;
+    _conn->set_stats_enabled(enabled);
+
+    std::scoped_lock lock(_adapter_connections_mutex);
+    for (auto& [path, adapter_conn] : _adapter_connections) {
+        adapter_conn->conn->set_stats_enabled(enabled);
+    }
+}
+
+SimpleDBus::ConnectionStats Bluez::stats() {
+    SimpleDBus::ConnectionStats stats = _conn->stats();
+
+    std::scoped_lock lock(_adapter_connections_mutex);
+    for (auto& [path, adapter_conn] : _adapter_connections) {
+        stats.merge(adapter_conn->conn->stats());
+    }
+    return stats;
+}
+
+void Bluez::start_recording(const std::string& filename) { _conn->start_recording(filename); }
+
+void Bluez::stop_recording() { _conn->stop_recording(); }
+
 std::vector<std::shared_ptr<Adapter>> Bluez::get_adapters() { return _bluez_root->get_adapters(); }
 
 std::shared_ptr<Agent> Bluez::get_agent() { return _bluez_root->get_agent(); }
 
 void Bluez::register_agent() { _bluez_root->register_agent(); }
+
+std::shared_ptr<SimpleDBus::Connection> Bluez::_adapter_connection(const std::string& path) {
+    std::scoped_lock lock(_adapter_connections_mutex);
+
+    // An adapter that comes back is served again over the connection it had before.
+    auto it = _adapter_connections.find(path);
+    if (it != _adapter_connections.end()) {
+        return it->second->conn;
+    }
+
+    auto adapter_conn = std::make_unique<AdapterConnection>();
+    adapter_conn->conn = std::make_shared<SimpleDBus::Connection>(DBUS_BUS);
+    adapter_conn->conn->set_dispatch_workers(_dispatch_workers, 4);
+    adapter_conn->conn->set_stats_enabled(_stats_enabled);
+    if (_lazy_loading) {
+        adapter_conn->conn->set_signal_fallback(
+            [this](std::string_view path) { return _bluez_root->load_deferred(path); });
+    }
+    // Objects are announced on the main connection, so updates of a new device can arrive here
+    // before its proxy exists. They are kept until it does, rather than dropped.
+    adapter_conn->conn->set_signal_hold(std::chrono::seconds(2));
+    adapter_conn->conn->init();
+
+    // Adapter updates are otherwise only subscribed to by the main connection.
+    adapter_conn->conn->add_match(std::string(MATCH_ADAPTER_PROPERTIES) + ",path='" + path + "'");
+
+    AdapterConnection* raw = adapter_conn.get();
+    adapter_conn->thread = std::thread([raw]() {
+        while (raw->active) {
+            // Exceptions escaping a handler must not take the process down with the thread.
+            try {
+                raw->conn->read_write_dispatch();
+                raw->conn->process_events(100);
+            } catch (const std::exception& ex) {
+                LOG_ERROR("Exception in adapter event loop: {}", ex.what());
+            } catch (...) {
+                LOG_ERROR("Unknown exception in adapter event loop");
+            }
+        }
+    });
+
+    return _adapter_connections.emplace(path, std::move(adapter_conn)).first->second->conn;
+}
@@ -14,6 +14,15 @@ void BluezOrg::register_agent(std::shared_ptr<Agent> agent) {
     std::dynamic_pointer_cast<BluezOrgBluez>(path_get("/org/bluez"))->register_agent(agent);
 }
 
+void BluezOrg::set_adapter_connection_factory(AdapterConnectionFactory factory) {
+    _adapter_connection_factory = std::move(factory);
+}
+
+void BluezOrg::set_object_loader(ObjectLoader loader) { _object_loader = std::move(loader); }
+
 std::shared_ptr<SimpleDBus::Proxy> BluezOrg::path_create(const std::string& path) {
-    return Proxy::create<BluezOrgBluez>(_conn, _bus_name, path);
-}
\ No newline at end of file
+    auto child = Proxy::create<BluezOrgBluez>(_conn, _bus_name, path);
+    child->set_adapter_connection_factory(_adapter_connection_factory);
+    child->set_object_loader(_object_loader);
+    return child;
+}
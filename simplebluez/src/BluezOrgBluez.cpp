@@ -7,8 +7,18 @@ BluezOrgBluez::BluezOrgBluez(std::shared_ptr<SimpleDBus::Connection> conn, const
                              const std::string& path)
     : Proxy(conn, bus_name, path) {}
 
+void BluezOrgBluez::set_adapter_connection_factory(AdapterConnectionFactory factory) {
+    _adapter_connection_factory = std::move(factory);
+}
+
+void BluezOrgBluez::set_object_loader(ObjectLoader loader) { _object_loader = std::move(loader); }
+
 std::shared_ptr<SimpleDBus::Proxy> BluezOrgBluez::path_create(const std::string& path) {
-    return Proxy::create<Adapter>(_conn, _bus_name, path);
+    // The adapter and everything below it are created on the connection of the adapter.
+    auto conn = _adapter_connection_factory ? _adapter_connection_factory(path) : _conn;
+    auto child = Proxy::create<Adapter>(conn, _bus_name, path);
+    child->set_object_loader(_object_loader);
+    return child;
 }
 
 std::shared_ptr<AgentManager1> BluezOrgBluez::agentmanager1() {
@@ -1,30 +1,194 @@
 #include <simplebluez/BluezRoot.h>
 #include <simplebluez/BluezOrg.h>
+#include <simpledbus/base/Path.h>
 #include <simpledbus/interfaces/ObjectManager.h>
 
+#include <algorithm>
+
 using namespace SimpleBluez;
 
+// Devices are the objects at /org/bluez/hciX/dev_Y. Everything above them is always built.
+static constexpr size_t DEVICE_DEPTH = 4;
+
+// Whether a device is paired or connected, read out of its managed interfaces without decoding them.
+static bool device_in_use(const SimpleDBus::Cursor& managed_interfaces) {
+    bool in_use = false;
+    managed_interfaces.for_each_entry([&](const SimpleDBus::Cursor& name, const SimpleDBus::Cursor& properties) {
+        if (name.get<std::string_view>() != "org.bluez.Device1") {
+            return true;
+        }
+        properties.for_each_entry([&](const SimpleDBus::Cursor& key, const SimpleDBus::Cursor& value) {
+            std::string_view property = key.get<std::string_view>();
+            if (property == "Paired" || property == "Connected") {
+                SimpleDBus::Holder flag = value.extract();
+                in_use = flag.type() == SimpleDBus::Holder::BOOLEAN && flag.get_boolean();
+            }
+            return !in_use;
+        });
+        return false;
+    });
+    return in_use;
+}
+
 BluezRoot::BluezRoot(std::shared_ptr<SimpleDBus::Connection> conn, const std::string& bus_name, const std::string& path)
     : Proxy(conn, bus_name, path) {}
 
 void BluezRoot::on_registration() {
     _interfaces.emplace(std::make_pair("org.freedesktop.DBus.ObjectManager", std::make_shared<SimpleDBus::Interfaces::ObjectManager>(_conn, shared_from_this())));
 
-    object_manager()->InterfacesAdded = [&](std::string path, SimpleDBus::Holder options) { path_add(path, options); };
+    // Deferred objects are built before they are updated.
+    object_manager()->InterfacesAdded = [&](std::string path, SimpleDBus::Holder options) {
+        load_deferred(path);
+        path_add(path, std::move(options));
+    };
     object_manager()->InterfacesRemoved = [&](std::string path, SimpleDBus::Holder options) {
+        if (unload_deferred(path, options)) {
+            return;
+        }
+        load_deferred(path);
         path_remove(path, options);
     };
 
     // Create the agent that will handle pairing.
-    _agent = Proxy::create<Agent>(_conn, "org.bluez", "/agent");
+    _agent = Proxy::create_exported<Agent>(_conn, "org.bluez", "/agent");
     path_append_child("/agent", std::static_pointer_cast<SimpleDBus::Proxy>(_agent));
 }
 
+void BluezRoot::set_lazy_loading(bool enabled) { _lazy_loading = enabled; }
+
 void BluezRoot::load_managed_objects() {
-    SimpleDBus::Holder managed_objects = object_manager()->GetManagedObjects();
-    for (auto& [path, managed_interfaces] : managed_objects.get_dict_object_path()) {
-        path_add(path, managed_interfaces);
+    if (!_lazy_loading) {
+        // The decoded object tree is handed over to the proxies, which keep its properties.
+        SimpleDBus::Holder managed_objects = object_manager()->GetManagedObjects();
+        for (auto& [path, managed_interfaces] : managed_objects.dict_take()) {
+            if (path.type() == SimpleDBus::Holder::OBJ_PATH) {
+                path_add(path.get_object_path(), std::move(managed_interfaces));
+            }
+        }
+        return;
+    }
+
+    // Only the objects above the devices are decoded, the others are kept as positions in the
+    // reply. Paired and connected devices are built right away, as they are listed rather than
+    // looked up.
+    SimpleDBus::Message reply = object_manager()->GetManagedObjectsReply();
+    std::vector<std::pair<std::string, SimpleDBus::Holder>> objects;
+    std::vector<std::string> devices_in_use;
+    {
+        std::scoped_lock lock(_deferred_mutex);
+        SimpleDBus::Cursor(reply).for_each_entry([&](const SimpleDBus::Cursor& key, const SimpleDBus::Cursor& value) {
+            if (key.type() != DBUS_TYPE_OBJECT_PATH) {
+                return true;
+            }
+
+            std::string_view path = key.get<std::string_view>();
+            size_t depth = SimpleDBus::PathUtils::count_elements(path);
+            if (depth < DEVICE_DEPTH) {
+                objects.emplace_back(path, value.extract());
+                return true;
+            }
+
+            if (depth == DEVICE_DEPTH && device_in_use(value)) {
+                devices_in_use.emplace_back(path);
+            }
+            _deferred_objects.emplace(path, value);
+            return true;
+        });
+
+        if (!_deferred_objects.empty()) {
+            _deferred_reply = reply;
+        }
+    }
+
+    // Proxies are built without holding the lock, as they register with the connection.
+    for (auto& [path, managed_interfaces] : objects) {
+        path_add(path, std::move(managed_interfaces));
+    }
+    for (const auto& path : devices_in_use) {
+        load_deferred(path);
+    }
+}
+
+bool BluezRoot::load_deferred(std::string_view path) {
+    // Only devices and their attributes are ever deferred.
+    if (SimpleDBus::PathUtils::count_elements(path) < DEVICE_DEPTH) {
+        return false;
+    }
+
+    std::string device(SimpleDBus::PathUtils::fetch_elements_view(path, DEVICE_DEPTH));
+    std::vector<std::pair<std::string, SimpleDBus::Holder>> objects;
+    {
+        std::scoped_lock lock(_deferred_mutex);
+
+        // The attributes of a device sort right after it, as no character allowed in an object
+        // path sorts before the separator.
+        for (auto it = _deferred_objects.lower_bound(device);
+             it != _deferred_objects.end() &&
+             (it->first == device || SimpleDBus::PathUtils::is_descendant(device, it->first));
+             it++) {
+            objects.emplace_back(it->first, it->second.extract());
+        }
+        if (objects.empty()) {
+            return false;
+        }
+        _loading_devices[device]++;
+    }
+
+    // The entries are left in place until the proxies exist, so that a concurrent caller builds
+    // them as well instead of finding neither. Waiting for this thread instead could deadlock, as
+    // building a proxy takes the dispatch lock of its connection, which signal handlers hold.
+    // Building an existing proxy again only reloads the same properties into it.
+    for (auto& [object_path, managed_interfaces] : objects) {
+        path_add(object_path, std::move(managed_interfaces));
+    }
+
+    {
+        std::scoped_lock lock(_deferred_mutex);
+        for (const auto& [object_path, managed_interfaces] : objects) {
+            _deferred_objects.erase(object_path);
+        }
+        if (--_loading_devices[device] == 0) {
+            _loading_devices.erase(device);
+        }
+        if (_deferred_objects.empty()) {
+            _deferred_reply = SimpleDBus::Message();
+        }
+    }
+    return true;
+}
+
+bool BluezRoot::unload_deferred(std::string_view path, const SimpleDBus::Holder& options) {
+    if (SimpleDBus::PathUtils::count_elements(path) < DEVICE_DEPTH) {
+        return false;
     }
+
+    std::scoped_lock lock(_deferred_mutex);
+    auto entry = _deferred_objects.find(path);
+    if (entry == _deferred_objects.end() ||
+        _loading_devices.count(SimpleDBus::PathUtils::fetch_elements_view(path, DEVICE_DEPTH)) > 0) {
+        return false;
+    }
+
+    // Objects keeping some of their interfaces still need to be built.
+    bool removed = true;
+    entry->second.for_each_entry([&](const SimpleDBus::Cursor& name, const SimpleDBus::Cursor&) {
+        std::string_view interface_name = name.get<std::string_view>();
+        removed = std::any_of(options.array_view().begin(), options.array_view().end(),
+                              [&](const SimpleDBus::Holder& option) {
+                                  return option.type() == SimpleDBus::Holder::STRING &&
+                                         option.get_string_view() == interface_name;
+                              });
+        return removed;
+    });
+    if (!removed) {
+        return false;
+    }
+
+    _deferred_objects.erase(entry);
+    if (_deferred_objects.empty()) {
+        _deferred_reply = SimpleDBus::Message();
+    }
+    return true;
 }
 
 std::vector<std::shared_ptr<Adapter>> BluezRoot::get_adapters() {
@@ -35,8 +199,23 @@ std::shared_ptr<Agent> BluezRoot::get_agent() { return std::dynamic_pointer_cast
 
 void BluezRoot::register_agent() { std::dynamic_pointer_cast<BluezOrg>(path_get("/org"))->register_agent(_agent); }
 
+void BluezRoot::set_adapter_connection_factory(AdapterConnectionFactory factory) {
+    _adapter_connection_factory = std::move(factory);
+}
+
 std::shared_ptr<SimpleDBus::Proxy> BluezRoot::path_create(const std::string& path) {
     auto child = std::make_shared<BluezOrg>(_conn, _bus_name, path);
+    child->set_adapter_connection_factory(_adapter_connection_factory);
+    if (_lazy_loading) {
+        // Adapters can outlive the root, which they hold no reference to.
+        std::weak_ptr<SimpleDBus::Proxy> root = shared_from_this();
+        child->set_object_loader([root](const std::string& object_path) {
+            auto locked = std::static_pointer_cast<BluezRoot>(root.lock());
+            if (locked) {
+                locked->load_deferred(object_path);
+            }
+        });
+    }
     return std::static_pointer_cast<SimpleDBus::Proxy>(child);
 }
 
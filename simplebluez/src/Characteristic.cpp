@@ -30,17 +30,17 @@ std::vector<std::string> Characteristic::flags() { return gattcharacteristic1()-
 
 uint16_t Characteristic::mtu() { return gattcharacteristic1()->MTU(); }
 
-ByteArray Characteristic::read() { return gattcharacteristic1()->ReadValue(); }
+ByteArray Characteristic::read(std::chrono::milliseconds timeout) { return gattcharacteristic1()->ReadValue(timeout); }
 
-void Characteristic::write_request(ByteArray value) {
-    gattcharacteristic1()->WriteValue(value, GattCharacteristic1::WriteType::REQUEST);
+void Characteristic::write_request(ByteArray value, std::chrono::milliseconds timeout) {
+    gattcharacteristic1()->WriteValue(value, GattCharacteristic1::WriteType::REQUEST, timeout);
 }
 
-void Characteristic::write_command(ByteArray value) {
-    gattcharacteristic1()->WriteValue(value, GattCharacteristic1::WriteType::COMMAND);
+void Characteristic::write_command(ByteArray value, std::chrono::milliseconds timeout) {
+    gattcharacteristic1()->WriteValue(value, GattCharacteristic1::WriteType::COMMAND, timeout);
 }
 
-void Characteristic::start_notify() { gattcharacteristic1()->StartNotify(); }
+void Characteristic::start_notify(std::chrono::milliseconds timeout) { gattcharacteristic1()->StartNotify(timeout); }
 
 void Characteristic::stop_notify() { gattcharacteristic1()->StopNotify(); }
 
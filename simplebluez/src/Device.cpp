@@ -12,9 +12,9 @@ Device::Device(std::shared_ptr<SimpleDBus::Connection> conn, const std::string&
 Device::~Device() {}
 
 std::shared_ptr<SimpleDBus::Proxy> Device::path_create(const std::string& path) {
-    const std::string next_child = SimpleDBus::PathUtils::next_child_strip(_path, path);
+    std::string_view next_child = SimpleDBus::PathUtils::next_child_strip_view(_path, path);
 
-    if (next_child.find("service") == 0) {
+    if (next_child.rfind("service", 0) == 0) {
         return Proxy::create<Service>(_conn, _bus_name, path);
     } else {
         return Proxy::create<Proxy>(_conn, _bus_name, path);
@@ -53,7 +53,7 @@ void Device::pair() { device1()->Pair(); }
 
 void Device::cancel_pairing() { device1()->CancelPairing(); }
 
-void Device::connect() { device1()->Connect(); }
+void Device::connect(std::chrono::milliseconds timeout) { device1()->Connect(timeout); }
 
 void Device::disconnect() { device1()->Disconnect(); }
 
@@ -12,9 +12,17 @@ const SimpleDBus::AutoRegisterInterface<Adapter1> Adapter1::registry{
 };
 
 Adapter1::Adapter1(std::shared_ptr<SimpleDBus::Connection> conn, std::shared_ptr<SimpleDBus::Proxy> proxy)
-    : SimpleDBus::Interface(conn, proxy, "org.bluez.Adapter1") {}
+    : SimpleDBus::Interface(conn, proxy, "org.bluez.Adapter1", property_table()) {}
+
+const SimpleDBus::PropertyTable& Adapter1::property_table() {
+    static const SimpleDBus::PropertyTable table(PROPERTY_DISCOVERING, PROPERTY_POWERED, PROPERTY_ADDRESS);
+    return table;
+}
 
 void Adapter1::StartDiscovery() {
+    // Device updates are only of interest while this adapter is discovering.
+    match_add(match_properties_changed(true, "org.bluez.Device1"));
+
     auto msg = create_method_call("StartDiscovery");
     _conn->send_with_reply_and_block(msg);
 }
@@ -23,6 +31,8 @@ void Adapter1::StopDiscovery() {
     auto msg = create_method_call("StopDiscovery");
     _conn->send_with_reply_and_block(msg);
     // NOTE: It might take a few seconds until the peripheral reports that is has actually stopped discovering.
+
+    match_remove(match_properties_changed(true, "org.bluez.Device1"));
 }
 
 SimpleDBus::Holder Adapter1::GetDiscoveryFilters() {
@@ -103,7 +113,7 @@ bool Adapter1::Discovering(bool refresh) {
     }
 
     std::scoped_lock lock(_property_update_mutex);
-    return _properties["Discovering"].get_boolean();
+    return property(PROPERTY_DISCOVERING);
 }
 
 bool Adapter1::Powered(bool refresh) {
@@ -112,12 +122,10 @@ bool Adapter1::Powered(bool refresh) {
     }
 
     std::scoped_lock lock(_property_update_mutex);
-    return _properties["Powered"].get_boolean();
+    return property(PROPERTY_POWERED);
 }
 
 std::string Adapter1::Address() {
     std::scoped_lock lock(_property_update_mutex);
-    return _properties["Address"].get_string();
+    return property(PROPERTY_ADDRESS);
 }
-
-void Adapter1::property_changed(std::string option_name) {}
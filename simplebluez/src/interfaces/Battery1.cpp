@@ -14,17 +14,22 @@ const SimpleDBus::AutoRegisterInterface<Battery1> Battery1::registry{
 };
 
 Battery1::Battery1(std::shared_ptr<SimpleDBus::Connection> conn, std::shared_ptr<SimpleDBus::Proxy> proxy)
-    : SimpleDBus::Interface(conn, proxy, "org.bluez.Battery1") {}
+    : SimpleDBus::Interface(conn, proxy, "org.bluez.Battery1", property_table()) {}
+
+const SimpleDBus::PropertyTable& Battery1::property_table() {
+    static const SimpleDBus::PropertyTable table(PROPERTY_PERCENTAGE);
+    return table;
+}
 
 Battery1::~Battery1() { OnPercentageChanged.unload(); }
 
 uint8_t Battery1::Percentage() {
     std::scoped_lock lock(_property_update_mutex);
-    return _properties["Percentage"].get_byte();
+    return property(PROPERTY_PERCENTAGE);
 }
 
-void Battery1::property_changed(std::string option_name) {
-    if (option_name == "Percentage") {
+void Battery1::on_property_changed(SimpleDBus::PropertyId id) {
+    if (id == PROPERTY_PERCENTAGE.id) {
         OnPercentageChanged();
     }
 }
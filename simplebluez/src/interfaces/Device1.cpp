@@ -12,16 +12,32 @@ const SimpleDBus::AutoRegisterInterface<Device1> Device1::registry{
 };
 
 Device1::Device1(std::shared_ptr<SimpleDBus::Connection> conn, std::shared_ptr<SimpleDBus::Proxy> proxy)
-    : SimpleDBus::Interface(conn, proxy, "org.bluez.Device1") {}
+    : SimpleDBus::Interface(conn, proxy, "org.bluez.Device1", property_table()) {}
+
+const SimpleDBus::PropertyTable& Device1::property_table() {
+    static const SimpleDBus::PropertyTable table(
+        PROPERTY_ADDRESS, PROPERTY_ADDRESS_TYPE, PROPERTY_ALIAS, PROPERTY_NAME, PROPERTY_APPEARANCE, PROPERTY_RSSI,
+        PROPERTY_TX_POWER, PROPERTY_UUIDS, PROPERTY_MANUFACTURER_DATA, PROPERTY_SERVICE_DATA, PROPERTY_PAIRED,
+        PROPERTY_CONNECTED, PROPERTY_SERVICES_RESOLVED);
+    return table;
+}
 
 Device1::~Device1() {
     OnDisconnected.unload();
     OnServicesResolved.unload();
 }
 
-void Device1::Connect() {
+void Device1::Connect(std::chrono::milliseconds timeout) {
+    // The update reporting the connection must not be missed.
+    match_add(match_properties_changed());
+
     auto msg = create_method_call("Connect");
-    _conn->send_with_reply_and_block(msg);
+    try {
+        _conn->send_with_reply_and_block(msg, timeout);
+    } catch (const std::exception&) {
+        match_update();
+        throw;
+    }
 }
 
 void Device1::Disconnect() {
@@ -41,45 +57,39 @@ void Device1::CancelPairing() {
 
 int16_t Device1::RSSI() {
     std::scoped_lock lock(_property_update_mutex);
-    return _properties["RSSI"].get_int16();
+    return property(PROPERTY_RSSI);
 }
 
 int16_t Device1::TxPower() { return _tx_power; }
 
 uint16_t Device1::Appearance() {
     std::scoped_lock lock(_property_update_mutex);
-    return _properties["Appearance"].get_uint16();
+    return property(PROPERTY_APPEARANCE);
 }
 
 std::string Device1::Address() {
     std::scoped_lock lock(_property_update_mutex);
-    return _properties["Address"].get_string();
+    return property(PROPERTY_ADDRESS);
 }
 
 std::string Device1::AddressType() {
     std::scoped_lock lock(_property_update_mutex);
-    return _properties["AddressType"].get_string();
+    return property(PROPERTY_ADDRESS_TYPE);
 }
 
 std::string Device1::Alias() {
     std::scoped_lock lock(_property_update_mutex);
-    return _properties["Alias"].get_string();
+    return property(PROPERTY_ALIAS);
 }
 
 std::string Device1::Name() {
     std::scoped_lock lock(_property_update_mutex);
-    return _properties["Name"].get_string();
+    return property(PROPERTY_NAME);
 }
 
 std::vector<std::string> Device1::UUIDs() {
     std::scoped_lock lock(_property_update_mutex);
-
-    std::vector<std::string> uuids;
-    for (SimpleDBus::Holder& uuid : _properties["UUIDs"].get_array()) {
-        uuids.push_back(uuid.get_string());
-    }
-
-    return uuids;
+    return property(PROPERTY_UUIDS);
 }
 
 std::map<uint16_t, ByteArray> Device1::ManufacturerData(bool refresh) {
@@ -108,7 +118,7 @@ bool Device1::Paired(bool refresh) {
     }
 
     std::scoped_lock lock(_property_update_mutex);
-    return _properties["Paired"].get_boolean();
+    return property(PROPERTY_PAIRED);
 }
 
 bool Device1::Connected(bool refresh) {
@@ -117,7 +127,7 @@ bool Device1::Connected(bool refresh) {
     }
 
     std::scoped_lock lock(_property_update_mutex);
-    return _properties["Connected"].get_boolean();
+    return property(PROPERTY_CONNECTED);
 }
 
 bool Device1::ServicesResolved(bool refresh) {
@@ -126,45 +136,67 @@ bool Device1::ServicesResolved(bool refresh) {
     }
 
     std::scoped_lock lock(_property_update_mutex);
-    return _properties["ServicesResolved"].get_boolean();
+    return property(PROPERTY_SERVICES_RESOLVED);
 }
 
-void Device1::property_changed(std::string option_name) {
-    if (option_name == "Connected") {
-        if (!Connected(false)) {
-            OnDisconnected();
-        }
-    } else if (option_name == "ServicesResolved") {
-        if (ServicesResolved(false)) {
-            OnServicesResolved();
-        }
-    } else if (option_name == "ManufacturerData") {
-        std::scoped_lock lock(_property_update_mutex);
-
-        _manufacturer_data.clear();
-        std::map<uint16_t, SimpleDBus::Holder> manuf_data = _properties["ManufacturerData"].get_dict_uint16();
-        // Loop through all received keys and store them.
-        for (auto& [key, value_array] : manuf_data) {
-            ByteArray raw_manuf_data;
-            for (auto& elem : value_array.get_array()) {
-                raw_manuf_data.push_back(elem.get_byte());
+void Device1::match_update() {
+    // Updates of the device are only of interest while it is connected, or paired, as BlueZ
+    // reconnects paired devices on its own.
+    if (Paired(false) || Connected(false)) {
+        match_add(match_properties_changed());
+    } else {
+        match_remove(match_properties_changed());
+    }
+}
+
+void Device1::on_property_changed(SimpleDBus::PropertyId id) {
+    switch (id) {
+        case PROPERTY_PAIRED.id:
+            match_update();
+            break;
+
+        case PROPERTY_CONNECTED.id:
+            // Also reached when the device is loaded already connected.
+            match_update();
+            if (!Connected(false)) {
+                // Calls still waiting on the device (or any of its attributes) will not be answered anymore.
+                _conn->cancel_pending_calls(_path);
+                OnDisconnected();
+            }
+            break;
+
+        case PROPERTY_SERVICES_RESOLVED.id:
+            if (ServicesResolved(false)) {
+                OnServicesResolved();
             }
-            _manufacturer_data[key] = raw_manuf_data;
+            break;
+
+        case PROPERTY_MANUFACTURER_DATA.id: {
+            std::scoped_lock lock(_property_update_mutex);
+
+            _manufacturer_data.clear();
+            // Loop through all received keys and store them.
+            for (const auto& [key, value_array] : property(PROPERTY_MANUFACTURER_DATA).dict_view<uint16_t>()) {
+                _manufacturer_data[key.get_uint16()] = ByteArray(value_array.get_byte_array());
+            }
+            break;
         }
-    } else if (option_name == "ServiceData") {
-        std::scoped_lock lock(_property_update_mutex);
-
-        _service_data.clear();
-        std::map<std::string, SimpleDBus::Holder> service_data = _properties["ServiceData"].get_dict_string();
-        // Loop through all received keys and store them.
-        for (auto& [key, value_array] : service_data) {
-            ByteArray raw_service_data;
-            for (auto& elem : value_array.get_array()) {
-                raw_service_data.push_back(elem.get_byte());
+
+        case PROPERTY_SERVICE_DATA.id: {
+            std::scoped_lock lock(_property_update_mutex);
+
+            _service_data.clear();
+            // Loop through all received keys and store them.
+            for (const auto& [key, value_array] : property(PROPERTY_SERVICE_DATA).dict_view<std::string>()) {
+                _service_data[key.get_string()] = ByteArray(value_array.get_byte_array());
             }
-            _service_data[key] = raw_service_data;
+            break;
+        }
+
+        case PROPERTY_TX_POWER.id: {
+            std::scoped_lock lock(_property_update_mutex);
+            _tx_power = property(PROPERTY_TX_POWER);
+            break;
         }
-    } else if (option_name == "TxPower") {
-        _tx_power = _properties["TxPower"].get_int16();
     }
 }
@@ -2,6 +2,19 @@
 
 using namespace SimpleBluez;
 
+namespace {
+
+// The options of a write only depend on its type, so they are built once and shared by all writes.
+const std::map<std::string, SimpleDBus::Holder>& write_options(GattCharacteristic1::WriteType type) {
+    static const std::map<std::string, SimpleDBus::Holder> request = {
+        {"type", SimpleDBus::Holder::create_string("request")}};
+    static const std::map<std::string, SimpleDBus::Holder> command = {
+        {"type", SimpleDBus::Holder::create_string("command")}};
+    return type == GattCharacteristic1::WriteType::COMMAND ? command : request;
+}
+
+}  // namespace
+
 const SimpleDBus::AutoRegisterInterface<GattCharacteristic1> GattCharacteristic1::registry{
     "org.bluez.GattCharacteristic1",
     // clang-format off
@@ -12,57 +25,61 @@ const SimpleDBus::AutoRegisterInterface<GattCharacteristic1> GattCharacteristic1
 };
 
 GattCharacteristic1::GattCharacteristic1(std::shared_ptr<SimpleDBus::Connection> conn, std::shared_ptr<SimpleDBus::Proxy> proxy)
-    : SimpleDBus::Interface(conn, proxy, "org.bluez.GattCharacteristic1") {}
+    : SimpleDBus::Interface(conn, proxy, "org.bluez.GattCharacteristic1", property_table()),
+      _write_value_call(create_call_template("WriteValue")) {}
+
+const SimpleDBus::PropertyTable& GattCharacteristic1::property_table() {
+    static const SimpleDBus::PropertyTable table(PROPERTY_UUID, PROPERTY_VALUE, PROPERTY_NOTIFYING, PROPERTY_FLAGS,
+                                                 PROPERTY_MTU);
+    return table;
+}
 
 GattCharacteristic1::~GattCharacteristic1() { OnValueChanged.unload(); }
 
-void GattCharacteristic1::StartNotify() {
+void GattCharacteristic1::StartNotify(std::chrono::milliseconds timeout) {
+    // Value updates are only of interest while notifications are enabled.
+    match_add(match_properties_changed(false, "org.bluez.GattCharacteristic1"));
+
     auto msg = create_method_call("StartNotify");
-    _conn->send_with_reply_and_block(msg);
+    try {
+        _conn->send_with_reply_and_block(msg, timeout);
+    } catch (const std::exception&) {
+        if (!Notifying(false)) {
+            match_remove(match_properties_changed(false, "org.bluez.GattCharacteristic1"));
+        }
+        throw;
+    }
 }
 
 void GattCharacteristic1::StopNotify() {
     auto msg = create_method_call("StopNotify");
     _conn->send_with_reply_and_block(msg);
-}
-
-void GattCharacteristic1::WriteValue(const ByteArray& value, WriteType type) {
-    SimpleDBus::Holder value_data = SimpleDBus::Holder::create_array();
-    for (size_t i = 0; i < value.size(); i++) {
-        value_data.array_append(SimpleDBus::Holder::create_byte(value[i]));
-    }
 
-    SimpleDBus::Holder options = SimpleDBus::Holder::create_dict();
-    if (type == WriteType::REQUEST) {
-        options.dict_append(SimpleDBus::Holder::Type::STRING, "type", SimpleDBus::Holder::create_string("request"));
-    } else if (type == WriteType::COMMAND) {
-        options.dict_append(SimpleDBus::Holder::Type::STRING, "type", SimpleDBus::Holder::create_string("command"));
-    }
+    match_remove(match_properties_changed(false, "org.bluez.GattCharacteristic1"));
+}
 
-    auto msg = create_method_call("WriteValue");
-    msg.append_argument(value_data, "ay");
-    msg.append_argument(options, "a{sv}");
-    _conn->send_with_reply_and_block(msg);
+void GattCharacteristic1::WriteValue(const ByteArray& value, WriteType type, std::chrono::milliseconds timeout) {
+    // Only the payload is marshalled for every write, the header comes from the template.
+    auto msg = _write_value_call.create(SimpleDBus::Marshal::ByteView(value.data(), value.size()), write_options(type));
+    _conn->send_with_reply_and_block(msg, timeout);
 }
 
-ByteArray GattCharacteristic1::ReadValue() {
+ByteArray GattCharacteristic1::ReadValue(std::chrono::milliseconds timeout) {
     auto msg = create_method_call("ReadValue");
 
     // NOTE: ReadValue requires an additional argument, which currently is not supported
-    SimpleDBus::Holder options = SimpleDBus::Holder::create_dict();
-    msg.append_argument(options, "a{sv}");
+    msg.append(std::map<std::string, SimpleDBus::Holder>());
 
-    SimpleDBus::Message reply_msg = _conn->send_with_reply_and_block(msg);
-    SimpleDBus::Holder value = reply_msg.extract();
-    update_value(value);
+    SimpleDBus::Message reply_msg = _conn->send_with_reply_and_block(msg, timeout);
+    auto [value] = reply_msg.read<SimpleDBus::Marshal::ByteView>();
+    update_value(ByteArray(value.data, value.size));
 
     return Value();
 }
 
 std::string GattCharacteristic1::UUID() {
-    // As the UUID property doesn't change, we can cache it
     std::scoped_lock lock(_property_update_mutex);
-    return _uuid;
+    return property(PROPERTY_UUID);
 }
 
 ByteArray GattCharacteristic1::Value() {
@@ -72,18 +89,12 @@ ByteArray GattCharacteristic1::Value() {
 
 std::vector<std::string> GattCharacteristic1::Flags() {
     std::scoped_lock lock(_property_update_mutex);
-
-    std::vector<std::string> flags;
-    for (SimpleDBus::Holder& flag : _properties["Flags"].get_array()) {
-        flags.push_back(flag.get_string());
-    }
-
-    return flags;
+    return property(PROPERTY_FLAGS);
 }
 
 uint16_t GattCharacteristic1::MTU() {
     std::scoped_lock lock(_property_update_mutex);
-    return _properties["MTU"].get_uint16();
+    return property(PROPERTY_MTU);
 }
 
 bool GattCharacteristic1::Notifying(bool refresh) {
@@ -92,27 +103,24 @@ bool GattCharacteristic1::Notifying(bool refresh) {
     }
 
     std::scoped_lock lock(_property_update_mutex);
-    return _properties["Notifying"].get_boolean();
+    return property(PROPERTY_NOTIFYING);
 }
 
-void GattCharacteristic1::property_changed(std::string option_name) {
-    if (option_name == "UUID") {
-        std::scoped_lock lock(_property_update_mutex);
-        _uuid = _properties["UUID"].get_string();
-    } else if (option_name == "Value") {
-        update_value(_properties["Value"]);
+void GattCharacteristic1::on_property_changed(SimpleDBus::PropertyId id) {
+    if (id == PROPERTY_VALUE.id) {
+        {
+            std::scoped_lock lock(_property_update_mutex);
+            update_value(property(PROPERTY_VALUE));
+        }
         OnValueChanged();
     }
 }
 
-void GattCharacteristic1::update_value(SimpleDBus::Holder& new_value) {
-    std::scoped_lock lock(_property_update_mutex);
-    auto value_array = new_value.get_array();
+void GattCharacteristic1::update_value(const SimpleDBus::Holder& new_value) {
+    update_value(ByteArray(new_value.get_byte_array()));
+}
 
-    char* value_data = new char[value_array.size()];
-    for (std::size_t i = 0; i < value_array.size(); i++) {
-        value_data[i] = value_array[i].get_byte();
-    }
-    _value = ByteArray(value_data, value_array.size());
-    delete[] value_data;
+void GattCharacteristic1::update_value(ByteArray new_value) {
+    std::scoped_lock lock(_property_update_mutex);
+    _value = std::move(new_value);
 }
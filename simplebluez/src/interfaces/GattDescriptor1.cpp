@@ -12,21 +12,20 @@ const SimpleDBus::AutoRegisterInterface<GattDescriptor1> GattDescriptor1::regist
 };
 
 GattDescriptor1::GattDescriptor1(std::shared_ptr<SimpleDBus::Connection> conn, std::shared_ptr<SimpleDBus::Proxy> proxy)
-    : SimpleDBus::Interface(conn, proxy, "org.bluez.GattDescriptor1") {}
+    : SimpleDBus::Interface(conn, proxy, "org.bluez.GattDescriptor1", property_table()) {}
+
+const SimpleDBus::PropertyTable& GattDescriptor1::property_table() {
+    static const SimpleDBus::PropertyTable table(PROPERTY_UUID, PROPERTY_VALUE);
+    return table;
+}
 
 GattDescriptor1::~GattDescriptor1() { OnValueChanged.unload(); }
 
 void GattDescriptor1::WriteValue(const ByteArray& value) {
-    SimpleDBus::Holder value_data = SimpleDBus::Holder::create_array();
-    for (size_t i = 0; i < value.size(); i++) {
-        value_data.array_append(SimpleDBus::Holder::create_byte(value[i]));
-    }
-
-    SimpleDBus::Holder options = SimpleDBus::Holder::create_dict();
+    std::map<std::string, SimpleDBus::Holder> options;
 
     auto msg = create_method_call("WriteValue");
-    msg.append_argument(value_data, "ay");
-    msg.append_argument(options, "a{sv}");
+    msg.append(SimpleDBus::Marshal::ByteView(value.data(), value.size()), options);
     _conn->send_with_reply_and_block(msg);
 }
 
@@ -34,20 +33,18 @@ ByteArray GattDescriptor1::ReadValue() {
     auto msg = create_method_call("ReadValue");
 
     // NOTE: ReadValue requires an additional argument, which currently is not supported
-    SimpleDBus::Holder options = SimpleDBus::Holder::create_dict();
-    msg.append_argument(options, "a{sv}");
+    msg.append(std::map<std::string, SimpleDBus::Holder>());
 
     SimpleDBus::Message reply_msg = _conn->send_with_reply_and_block(msg);
-    SimpleDBus::Holder value = reply_msg.extract();
-    update_value(value);
+    auto [value] = reply_msg.read<SimpleDBus::Marshal::ByteView>();
+    update_value(ByteArray(value.data, value.size));
 
     return Value();
 }
 
 std::string GattDescriptor1::UUID() {
-    // As the UUID property doesn't change, we can cache it
     std::scoped_lock lock(_property_update_mutex);
-    return _uuid;
+    return property(PROPERTY_UUID);
 }
 
 ByteArray GattDescriptor1::Value() {
@@ -55,24 +52,21 @@ ByteArray GattDescriptor1::Value() {
     return _value;
 }
 
-void GattDescriptor1::property_changed(std::string option_name) {
-    if (option_name == "UUID") {
-        std::scoped_lock lock(_property_update_mutex);
-        _uuid = _properties["UUID"].get_string();
-    } else if (option_name == "Value") {
-        update_value(_properties["Value"]);
+void GattDescriptor1::on_property_changed(SimpleDBus::PropertyId id) {
+    if (id == PROPERTY_VALUE.id) {
+        {
+            std::scoped_lock lock(_property_update_mutex);
+            update_value(property(PROPERTY_VALUE));
+        }
         OnValueChanged();
     }
 }
 
-void GattDescriptor1::update_value(SimpleDBus::Holder& new_value) {
-    std::scoped_lock lock(_property_update_mutex);
-    auto value_array = new_value.get_array();
+void GattDescriptor1::update_value(const SimpleDBus::Holder& new_value) {
+    update_value(ByteArray(new_value.get_byte_array()));
+}
 
-    char* value_data = new char[value_array.size()];
-    for (std::size_t i = 0; i < value_array.size(); i++) {
-        value_data[i] = value_array[i].get_byte();
-    }
-    _value = ByteArray(value_data, value_array.size());
-    delete[] value_data;
+void GattDescriptor1::update_value(ByteArray new_value) {
+    std::scoped_lock lock(_property_update_mutex);
+    _value = std::move(new_value);
 }
@@ -12,17 +12,14 @@ const SimpleDBus::AutoRegisterInterface<GattService1> GattService1::registry{
 };
 
 GattService1::GattService1(std::shared_ptr<SimpleDBus::Connection> conn, std::shared_ptr<SimpleDBus::Proxy> proxy)
-    : SimpleDBus::Interface(conn, proxy, "org.bluez.GattService1") {}
+    : SimpleDBus::Interface(conn, proxy, "org.bluez.GattService1", property_table()) {}
 
-std::string GattService1::UUID() {
-    // As the UUID property doesn't change, we can cache it
-    std::scoped_lock lock(_property_update_mutex);
-    return _uuid;
+const SimpleDBus::PropertyTable& GattService1::property_table() {
+    static const SimpleDBus::PropertyTable table(PROPERTY_UUID);
+    return table;
 }
 
-void GattService1::property_changed(std::string option_name) {
-    if (option_name == "UUID") {
-        std::scoped_lock lock(_property_update_mutex);
-        _uuid = _properties["UUID"].get_string();
-    }
+std::string GattService1::UUID() {
+    std::scoped_lock lock(_property_update_mutex);
+    return property(PROPERTY_UUID);
 }
@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+
+#include "helpers/Fixtures.h"
+
+using SimpleDBus::Holder;
+
+static void BM_HolderCreateDeviceProperties(benchmark::State& state) {
+    for (auto _ : state) {
+        Holder properties = Fixtures::device_properties(7);
+        benchmark::DoNotOptimize(properties);
+    }
+}
+BENCHMARK(BM_HolderCreateDeviceProperties);
+
+static void BM_HolderCreateByteArray(benchmark::State& state) {
+    std::vector<uint8_t> bytes(state.range(0), 0x42);
+    for (auto _ : state) {
+        Holder value = Holder::create_byte_array(bytes);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HolderCreateByteArray)->Arg(20)->Arg(244)->Arg(512);
+
+static void BM_HolderCopyDeviceProperties(benchmark::State& state) {
+    Holder properties = Fixtures::device_properties(7);
+    for (auto _ : state) {
+        Holder copy = properties;
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK(BM_HolderCopyDeviceProperties);
+
+static void BM_HolderCopyManagedObjects(benchmark::State& state) {
+    Holder objects = Fixtures::managed_objects(state.range(0));
+    for (auto _ : state) {
+        Holder copy = objects;
+        benchmark::DoNotOptimize(copy);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HolderCopyManagedObjects)->Arg(100)->Arg(1000);
+
+// Compares a cached value against a freshly built one, as property updates do.
+static void BM_HolderCompareEqual(benchmark::State& state) {
+    Holder cached = Fixtures::device_properties(7);
+    for (auto _ : state) {
+        state.PauseTiming();
+        Holder latest = Fixtures::device_properties(7);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(cached == latest);
+    }
+}
+BENCHMARK(BM_HolderCompareEqual);
+
+static void BM_HolderCompareDifferent(benchmark::State& state) {
+    Holder cached = Fixtures::device_properties(7);
+    for (auto _ : state) {
+        state.PauseTiming();
+        Holder latest = Fixtures::device_properties(8);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(cached == latest);
+    }
+}
+BENCHMARK(BM_HolderCompareDifferent);
+
+// Hashes once cached, as held by the cached properties, tell differing holders apart at once.
+static void BM_HolderCompareHashed(benchmark::State& state) {
+    Holder cached = Fixtures::device_properties(7);
+    Holder latest = Fixtures::device_properties(8);
+    cached.hash();
+    latest.hash();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cached == latest);
+    }
+}
+BENCHMARK(BM_HolderCompareHashed);
+
+static void BM_HolderHash(benchmark::State& state) {
+    Holder properties = Fixtures::device_properties(7);
+    for (auto _ : state) {
+        // The hash is cached, so it is taken from a copy modified beforehand which has to recompute it.
+        state.PauseTiming();
+        Holder copy = properties;
+        copy.dict_append(Holder::STRING, "Trusted", Holder::create_boolean(false));
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(copy.hash());
+    }
+}
+BENCHMARK(BM_HolderHash);
+
+static void BM_HolderDictFind(benchmark::State& state) {
+    Holder properties = Fixtures::device_properties(7);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(properties.dict_find("RSSI"));
+    }
+}
+BENCHMARK(BM_HolderDictFind);
@@ -0,0 +1,144 @@
+#include <benchmark/benchmark.h>
+
+#include <simpledbus/base/CallTemplate.h>
+#include <simpledbus/base/Cursor.h>
+
+#include "helpers/Fixtures.h"
+
+using SimpleDBus::Holder;
+using SimpleDBus::Message;
+
+// Arguments of the typical BlueZ signatures: characteristic values, properties and managed objects.
+static Holder byte_array(size_t size) { return Holder::create_byte_array(std::vector<uint8_t>(size, 0x42)); }
+
+// Baseline of the append benchmarks below, which each create the message they append to.
+static void BM_MessageCreateSignal(benchmark::State& state) {
+    for (auto _ : state) {
+        Message msg = Fixtures::signal();
+        benchmark::DoNotOptimize(msg);
+    }
+}
+BENCHMARK(BM_MessageCreateSignal);
+
+static void BM_MessageAppendByteArray(benchmark::State& state) {
+    Holder value = byte_array(state.range(0));
+    for (auto _ : state) {
+        Message msg = Fixtures::signal();
+        msg.append_argument(value, "ay");
+        benchmark::DoNotOptimize(msg);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MessageAppendByteArray)->Arg(20)->Arg(244)->Arg(512);
+
+static void BM_MessageExtractByteArray(benchmark::State& state) {
+    Message msg = Fixtures::signal();
+    msg.append_argument(byte_array(state.range(0)), "ay");
+    for (auto _ : state) {
+        // Copies share the message but not its extraction state.
+        Message copy = msg;
+        benchmark::DoNotOptimize(copy.extract());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MessageExtractByteArray)->Arg(20)->Arg(244)->Arg(512);
+
+static void BM_MessageAppendProperties(benchmark::State& state) {
+    Holder properties = Fixtures::device_properties(7);
+    for (auto _ : state) {
+        Message msg = Fixtures::signal();
+        msg.append_argument(properties, "a{sv}");
+        benchmark::DoNotOptimize(msg);
+    }
+}
+BENCHMARK(BM_MessageAppendProperties);
+
+static void BM_MessageExtractProperties(benchmark::State& state) {
+    Message msg = Fixtures::signal();
+    msg.append_argument(Fixtures::device_properties(7), "a{sv}");
+    for (auto _ : state) {
+        Message copy = msg;
+        benchmark::DoNotOptimize(copy.extract());
+    }
+}
+BENCHMARK(BM_MessageExtractProperties);
+
+static void BM_MessageAppendManagedObjects(benchmark::State& state) {
+    Holder objects = Fixtures::managed_objects(state.range(0));
+    for (auto _ : state) {
+        Message msg = Fixtures::signal();
+        msg.append_argument(objects, "a{oa{sa{sv}}}");
+        benchmark::DoNotOptimize(msg);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MessageAppendManagedObjects)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_MessageExtractManagedObjects(benchmark::State& state) {
+    Message msg = Fixtures::signal();
+    msg.append_argument(Fixtures::managed_objects(state.range(0)), "a{oa{sa{sv}}}");
+    for (auto _ : state) {
+        Message copy = msg;
+        benchmark::DoNotOptimize(copy.extract());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MessageExtractManagedObjects)->Arg(10)->Arg(100)->Arg(1000);
+
+// Skipping every object but one, as a Cursor lets ObjectManager do with unknown interfaces.
+static void BM_MessageCursorManagedObjects(benchmark::State& state) {
+    Message msg = Fixtures::signal();
+    msg.append_argument(Fixtures::managed_objects(state.range(0)), "a{oa{sa{sv}}}");
+    std::string wanted = Fixtures::device_path(state.range(0) / 2);
+    for (auto _ : state) {
+        SimpleDBus::Cursor cursor(msg);
+        Holder found;
+        cursor.for_each_entry([&](const SimpleDBus::Cursor& key, const SimpleDBus::Cursor& value) {
+            if (key.get<std::string_view>() == wanted) {
+                found = value.extract();
+            }
+            return true;
+        });
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MessageCursorManagedObjects)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_MessageCopy(benchmark::State& state) {
+    Message msg = Fixtures::signal();
+    msg.append_argument(byte_array(512), "ay");
+    for (auto _ : state) {
+        Message copy = msg;
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK(BM_MessageCopy);
+
+// A characteristic write, as GattCharacteristic1::WriteValue used to build it from scratch...
+static void BM_MessageWriteValue(benchmark::State& state) {
+    std::vector<uint8_t> value(state.range(0), 0x42);
+    std::string path = Fixtures::device_path(0) + "/service0010/char0011";
+    for (auto _ : state) {
+        std::map<std::string, Holder> options = {{"type", Holder::create_string("command")}};
+        Message msg = Message::create_method_call("org.bluez", path, "org.bluez.GattCharacteristic1", "WriteValue");
+        msg.append(SimpleDBus::Marshal::ByteView(value.data(), value.size()), options);
+        benchmark::DoNotOptimize(msg);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MessageWriteValue)->Arg(20)->Arg(244);
+
+// ...and out of a call template with options built once, as it does now.
+static void BM_MessageWriteValueTemplate(benchmark::State& state) {
+    std::vector<uint8_t> value(state.range(0), 0x42);
+    SimpleDBus::CallTemplate call("org.bluez", Fixtures::device_path(0) + "/service0010/char0011",
+                                  "org.bluez.GattCharacteristic1", "WriteValue");
+    const std::map<std::string, Holder> options = {{"type", Holder::create_string("command")}};
+    for (auto _ : state) {
+        Message msg = call.create(SimpleDBus::Marshal::ByteView(value.data(), value.size()), options);
+        benchmark::DoNotOptimize(msg);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MessageWriteValueTemplate)->Arg(20)->Arg(244);
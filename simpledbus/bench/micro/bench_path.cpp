@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+
+#include <simpledbus/advanced/Proxy.h>
+#include <simpledbus/base/Path.h>
+
+#include <memory>
+#include <string>
+
+#include "helpers/Fixtures.h"
+
+using SimpleDBus::PathUtils;
+
+// The path operations Proxy runs on every level of the tree when adding and removing objects,
+// on the path of a characteristic as seen from its device.
+static const std::string DEVICE = Fixtures::device_path(0);
+static const std::string CHARACTERISTIC = DEVICE + "/service0010/char0011";
+
+static void BM_PathIsDescendant(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PathUtils::is_descendant(DEVICE, CHARACTERISTIC));
+    }
+}
+BENCHMARK(BM_PathIsDescendant);
+
+static void BM_PathNextChild(benchmark::State& state) {
+    for (auto _ : state) {
+        std::string child = PathUtils::next_child(DEVICE, CHARACTERISTIC);
+        benchmark::DoNotOptimize(child);
+    }
+}
+BENCHMARK(BM_PathNextChild);
+
+static void BM_PathNextChildView(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PathUtils::next_child_view(DEVICE, CHARACTERISTIC));
+    }
+}
+BENCHMARK(BM_PathNextChildView);
+
+static void BM_PathNextChildStrip(benchmark::State& state) {
+    for (auto _ : state) {
+        std::string child = PathUtils::next_child_strip(DEVICE, CHARACTERISTIC);
+        benchmark::DoNotOptimize(child);
+    }
+}
+BENCHMARK(BM_PathNextChildStrip);
+
+static void BM_PathNextChildStripView(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PathUtils::next_child_strip_view(DEVICE, CHARACTERISTIC));
+    }
+}
+BENCHMARK(BM_PathNextChildStripView);
+
+static void BM_PathSplitElements(benchmark::State& state) {
+    for (auto _ : state) {
+        auto elements = PathUtils::split_elements(CHARACTERISTIC);
+        benchmark::DoNotOptimize(elements);
+    }
+}
+BENCHMARK(BM_PathSplitElements);
+
+// Validates the path and locates its elements, which are then read without searching it.
+static void BM_PathCreate(benchmark::State& state) {
+    for (auto _ : state) {
+        SimpleDBus::Path path(CHARACTERISTIC);
+        benchmark::DoNotOptimize(path.element(path.count_elements() - 1));
+    }
+}
+BENCHMARK(BM_PathCreate);
+
+// Device::services(), which picks the services out of the children of a device by name.
+static void BM_PathChildrenWithPrefix(benchmark::State& state) {
+    auto device = std::make_shared<SimpleDBus::Proxy>(nullptr, "org.bluez", DEVICE);
+    for (int64_t i = 0; i < state.range(0); i++) {
+        char name[16];
+        std::snprintf(name, sizeof(name), "/service%04x", static_cast<unsigned>(0x10 * (i + 1)));
+        device->path_add(DEVICE + name, SimpleDBus::Holder::create_dict());
+    }
+
+    for (auto _ : state) {
+        auto services = device->children_casted_with_prefix<SimpleDBus::Proxy>("service");
+        benchmark::DoNotOptimize(services);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PathChildrenWithPrefix)->Arg(8)->Arg(32);
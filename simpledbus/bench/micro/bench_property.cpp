@@ -0,0 +1,152 @@
+#include <benchmark/benchmark.h>
+
+#include <simpledbus/advanced/Interface.h>
+#include <simpledbus/advanced/Proxy.h>
+#include <simpledbus/base/Connection.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "helpers/Fixtures.h"
+
+using SimpleDBus::Holder;
+
+// Device interfaces reading their properties as SimpleBluez does, either out of the cache by
+// name or out of the slots of their property table. Both record the RSSI updates they see.
+class NamedDevice : public SimpleDBus::Interface {
+  public:
+    NamedDevice(std::shared_ptr<SimpleDBus::Connection> conn, std::shared_ptr<SimpleDBus::Proxy> proxy)
+        : SimpleDBus::Interface(conn, proxy, "org.bluez.Device1") {}
+
+    int16_t RSSI() {
+        std::scoped_lock lock(_property_update_mutex);
+        return property_view("RSSI").get_int16();
+    }
+
+    std::string Name() {
+        std::scoped_lock lock(_property_update_mutex);
+        return property_view("Name").get_string();
+    }
+
+    bool Connected() {
+        std::scoped_lock lock(_property_update_mutex);
+        return property_view("Connected").get_boolean();
+    }
+
+    size_t rssi_updates = 0;
+    size_t other_updates = 0;
+
+  protected:
+    // The same chain of comparisons as the one SimpleBluez dispatched its changes through.
+    void property_changed(std::string option_name) override {
+        if (option_name == "Connected") {
+            benchmark::DoNotOptimize(Connected());
+        } else if (option_name == "ServicesResolved" || option_name == "ManufacturerData" ||
+                   option_name == "ServiceData" || option_name == "TxPower") {
+            other_updates++;
+        } else if (option_name == "RSSI") {
+            rssi_updates++;
+        }
+    }
+};
+
+class DeclaredDevice : public SimpleDBus::Interface {
+  public:
+    DeclaredDevice(std::shared_ptr<SimpleDBus::Connection> conn, std::shared_ptr<SimpleDBus::Proxy> proxy)
+        : SimpleDBus::Interface(conn, proxy, "org.bluez.Device1", property_table()) {}
+
+    int16_t RSSI() {
+        std::scoped_lock lock(_property_update_mutex);
+        return property(PROPERTY_RSSI);
+    }
+
+    std::string Name() {
+        std::scoped_lock lock(_property_update_mutex);
+        return property(PROPERTY_NAME);
+    }
+
+    bool Connected() {
+        std::scoped_lock lock(_property_update_mutex);
+        return property(PROPERTY_CONNECTED);
+    }
+
+    size_t rssi_updates = 0;
+
+  protected:
+    static constexpr SimpleDBus::Property<std::string> PROPERTY_ADDRESS{0, "Address"};
+    static constexpr SimpleDBus::Property<std::string> PROPERTY_NAME{1, "Name"};
+    static constexpr SimpleDBus::Property<int16_t> PROPERTY_RSSI{2, "RSSI"};
+    static constexpr SimpleDBus::Property<int16_t> PROPERTY_TX_POWER{3, "TxPower"};
+    static constexpr SimpleDBus::Property<std::vector<std::string>> PROPERTY_UUIDS{4, "UUIDs"};
+    static constexpr SimpleDBus::Property<Holder> PROPERTY_MANUFACTURER_DATA{5, "ManufacturerData"};
+    static constexpr SimpleDBus::Property<bool> PROPERTY_CONNECTED{6, "Connected"};
+    static constexpr SimpleDBus::Property<bool> PROPERTY_SERVICES_RESOLVED{7, "ServicesResolved"};
+
+    static const SimpleDBus::PropertyTable& property_table() {
+        static const SimpleDBus::PropertyTable table(PROPERTY_ADDRESS, PROPERTY_NAME, PROPERTY_RSSI, PROPERTY_TX_POWER,
+                                                     PROPERTY_UUIDS, PROPERTY_MANUFACTURER_DATA, PROPERTY_CONNECTED,
+                                                     PROPERTY_SERVICES_RESOLVED);
+        return table;
+    }
+
+    void on_property_changed(SimpleDBus::PropertyId id) override {
+        switch (id) {
+            case PROPERTY_CONNECTED.id:
+                benchmark::DoNotOptimize(Connected());
+                break;
+            case PROPERTY_RSSI.id:
+                rssi_updates++;
+                break;
+        }
+    }
+};
+
+// Proxies are never exported, so the connection doesn't need to reach a bus.
+static std::shared_ptr<SimpleDBus::Proxy> device_proxy() {
+    static auto conn = std::make_shared<SimpleDBus::Connection>(DBUS_BUS_SESSION);
+    return std::make_shared<SimpleDBus::Proxy>(conn, "org.bluez", Fixtures::device_path(0));
+}
+
+template <typename Device>
+static std::shared_ptr<Device> loaded_device(std::shared_ptr<SimpleDBus::Proxy> proxy) {
+    auto device = std::make_shared<Device>(nullptr, proxy);
+    device->load(Fixtures::device_properties(0));
+    return device;
+}
+
+// Reading the RSSI, the name and the connection state of a device.
+template <typename Device>
+static void BM_PropertyRead(benchmark::State& state) {
+    auto proxy = device_proxy();
+    auto device = loaded_device<Device>(proxy);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(device->RSSI());
+        benchmark::DoNotOptimize(device->Name());
+        benchmark::DoNotOptimize(device->Connected());
+    }
+    state.SetItemsProcessed(state.iterations() * 3);
+}
+BENCHMARK_TEMPLATE(BM_PropertyRead, NamedDevice);
+BENCHMARK_TEMPLATE(BM_PropertyRead, DeclaredDevice);
+
+// A new RSSI and the unchanged manufacturer data of an advertisement, stored and dispatched.
+template <typename Device>
+static void BM_PropertyChanged(benchmark::State& state) {
+    auto proxy = device_proxy();
+    auto device = loaded_device<Device>(proxy);
+    Holder manufacturer_data = *Fixtures::device_properties(0).dict_find("ManufacturerData");
+
+    int16_t rssi = -60;
+    for (auto _ : state) {
+        rssi = rssi == -60 ? -61 : -60;
+        device->signal_property_changed({{"RSSI", Holder::create_int16(rssi)}, {"ManufacturerData", manufacturer_data}},
+                                        {});
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (device->rssi_updates < static_cast<size_t>(state.iterations())) {
+        state.SkipWithError("RSSI updates were not dispatched");
+    }
+}
+BENCHMARK_TEMPLATE(BM_PropertyChanged, NamedDevice);
+BENCHMARK_TEMPLATE(BM_PropertyChanged, DeclaredDevice);
@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+
+#include <simpledbus/advanced/Interface.h>
+#include <simpledbus/advanced/Proxy.h>
+#include <simpledbus/base/Connection.h>
+
+#include <map>
+#include <memory>
+
+#include "helpers/Fixtures.h"
+
+using SimpleDBus::Holder;
+using SimpleDBus::Message;
+using SimpleDBus::Proxy;
+
+// Proxies are never exported, so the connection doesn't need to reach a bus.
+static std::shared_ptr<SimpleDBus::Connection> connection() {
+    static auto conn = std::make_shared<SimpleDBus::Connection>(DBUS_BUS_SESSION);
+    return conn;
+}
+
+static std::shared_ptr<Proxy> populated_root(size_t devices) {
+    auto root = std::make_shared<Proxy>(connection(), "org.bluez", "/");
+    for (size_t i = 0; i < devices; i++) {
+        root->path_add(Fixtures::device_path(i), Holder::create_dict());
+    }
+    return root;
+}
+
+static void BM_ProxyPathAdd(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto root = std::make_shared<Proxy>(connection(), "org.bluez", "/");
+        state.ResumeTiming();
+
+        for (int64_t i = 0; i < state.range(0); i++) {
+            root->path_add(Fixtures::device_path(i), Holder::create_dict());
+        }
+
+        state.PauseTiming();
+        root.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ProxyPathAdd)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+static void BM_ProxyPathRemove(benchmark::State& state) {
+    Holder removed = Holder::create_array();
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto root = populated_root(state.range(0));
+        state.ResumeTiming();
+
+        for (int64_t i = 0; i < state.range(0); i++) {
+            root->path_remove(Fixtures::device_path(i), removed);
+        }
+
+        state.PauseTiming();
+        root.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ProxyPathRemove)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+// A service appearing and disappearing below one of many devices, as they are resolved on
+// connection. Its cost should not depend on the number of devices.
+static void BM_ProxyPathAddRemoveService(benchmark::State& state) {
+    auto root = populated_root(state.range(0));
+    Holder removed = Holder::create_array();
+
+    size_t index = 0;
+    for (auto _ : state) {
+        std::string path = Fixtures::device_path(index++ % state.range(0)) + "/service0010";
+        root->path_add(path, Holder::create_dict());
+        root->path_remove(path, removed);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ProxyPathAddRemoveService)->Arg(100)->Arg(1000)->Arg(10000);
+
+// A PropertiesChanged signal dispatched to the Properties interface of a device proxy, carrying
+// either a new RSSI every time or the same one, which is dropped once compared.
+static void BM_ProxyPropertiesChanged(benchmark::State& state) {
+    auto proxy = std::make_shared<Proxy>(connection(), "org.bluez", Fixtures::device_path(0));
+    Holder interfaces = Holder::create_dict();
+    interfaces.dict_append(Holder::STRING, "org.freedesktop.DBus.Properties", Fixtures::device_properties(0));
+    proxy->interfaces_load(std::move(interfaces));
+
+    std::vector<Message> signals;
+    for (int16_t rssi : {-60, -61}) {
+        Message msg = Message::create_signal(Fixtures::device_path(0), "org.freedesktop.DBus.Properties",
+                                             "PropertiesChanged");
+        std::map<std::string, Holder> changed = {{"RSSI", Holder::create_int16(rssi)}};
+        msg.append(std::string("org.freedesktop.DBus.Properties"), changed, std::vector<std::string>());
+        signals.push_back(msg);
+    }
+
+    bool alternate = state.range(0) != 0;
+    size_t index = 0;
+    for (auto _ : state) {
+        Message msg = signals[alternate ? index++ % signals.size() : 0];
+        proxy->message_handle(msg);
+    }
+    state.SetLabel(alternate ? "changed" : "unchanged");
+}
+BENCHMARK(BM_ProxyPropertiesChanged)->Arg(1)->Arg(0);
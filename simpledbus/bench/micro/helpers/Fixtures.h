@@ -0,0 +1,73 @@
+#pragma once
+
+#include <simpledbus/base/Holder.h>
+#include <simpledbus/base/Message.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Values shaped like the ones BlueZ exchanges, shared by the micro benchmarks.
+namespace Fixtures {
+
+inline std::string device_path(size_t index) { return "/org/bluez/hci0/dev_" + std::to_string(index); }
+
+// Properties of an org.bluez.Device1 object, as found in `a{sv}` dictionaries.
+inline SimpleDBus::Holder device_properties(size_t index) {
+    using SimpleDBus::Holder;
+
+    char address[18];
+    std::snprintf(address, sizeof(address), "00:11:22:%02X:%02X:%02X", static_cast<unsigned>((index >> 16) & 0xFF),
+                  static_cast<unsigned>((index >> 8) & 0xFF), static_cast<unsigned>(index & 0xFF));
+
+    Holder uuids = Holder::create_array();
+    uuids.array_append(Holder::create_string("0000180f-0000-1000-8000-00805f9b34fb"));
+    uuids.array_append(Holder::create_string("0000180a-0000-1000-8000-00805f9b34fb"));
+
+    Holder manufacturer_data = Holder::create_dict();
+    manufacturer_data.dict_append(Holder::UINT16, static_cast<uint16_t>(0x004C),
+                                  Holder::create_byte_array(std::vector<uint8_t>(16, 0x42)));
+
+    Holder properties = Holder::create_dict();
+    properties.dict_append(Holder::STRING, "Address", Holder::create_string(address));
+    properties.dict_append(Holder::STRING, "AddressType", Holder::create_string("random"));
+    properties.dict_append(Holder::STRING, "Name", Holder::create_string("Device " + std::to_string(index)));
+    properties.dict_append(Holder::STRING, "Alias", Holder::create_string("Device " + std::to_string(index)));
+    properties.dict_append(Holder::STRING, "Adapter", Holder::create_object_path("/org/bluez/hci0"));
+    properties.dict_append(Holder::STRING, "Paired", Holder::create_boolean(false));
+    properties.dict_append(Holder::STRING, "Connected", Holder::create_boolean(false));
+    properties.dict_append(Holder::STRING, "ServicesResolved", Holder::create_boolean(false));
+    properties.dict_append(Holder::STRING, "RSSI", Holder::create_int16(-60 - static_cast<int16_t>(index % 30)));
+    properties.dict_append(Holder::STRING, "TxPower", Holder::create_int16(4));
+    properties.dict_append(Holder::STRING, "UUIDs", uuids);
+    properties.dict_append(Holder::STRING, "ManufacturerData", manufacturer_data);
+    return properties;
+}
+
+// Interfaces of a device, as found in `a{sa{sv}}` dictionaries.
+inline SimpleDBus::Holder device_interfaces(size_t index) {
+    using SimpleDBus::Holder;
+
+    Holder interfaces = Holder::create_dict();
+    interfaces.dict_append(Holder::STRING, "org.freedesktop.DBus.Introspectable", Holder::create_dict());
+    interfaces.dict_append(Holder::STRING, "org.bluez.Device1", device_properties(index));
+    interfaces.dict_append(Holder::STRING, "org.freedesktop.DBus.Properties", Holder::create_dict());
+    return interfaces;
+}
+
+// Objects of an adapter with the given number of devices, as returned by GetManagedObjects.
+inline SimpleDBus::Holder managed_objects(size_t devices) {
+    using SimpleDBus::Holder;
+
+    Holder objects = Holder::create_dict();
+    for (size_t i = 0; i < devices; i++) {
+        objects.dict_append(Holder::OBJ_PATH, device_path(i), device_interfaces(i));
+    }
+    return objects;
+}
+
+inline SimpleDBus::Message signal(const std::string& path = "/org/bluez/hci0/dev_0") {
+    return SimpleDBus::Message::create_signal(path, "org.simpledbus.Bench", "Bench");
+}
+
+}  // namespace Fixtures
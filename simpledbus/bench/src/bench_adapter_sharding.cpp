@@ -0,0 +1,186 @@
+// Emulates a daemon serving 1, 2 and 4 adapters, whose devices emit timestamped
+// notifications while every adapter is being polled with `ReadValue` calls, and compares
+// handling all adapters over a single connection against one connection (and event loop)
+// per adapter. Notification callbacks block for a while, e.g. on I/O. Reports the
+// notifications handled per second and the latency of notifications and of calls.
+//
+// Requires a session bus, e.g. `dbus-run-session -- ./simpledbus_bench_adapter_sharding`.
+
+#include <simpledbus/base/Connection.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "helpers/Bench.h"
+
+using namespace std::chrono;
+using namespace Bench;
+
+static constexpr const char* BENCH_INTERFACE = "org.simpledbus.Bench";
+
+struct BenchConfig {
+    size_t devices;
+    microseconds work;
+    milliseconds period;
+    seconds duration;
+};
+
+struct BenchResult {
+    uint64_t handled;
+    double seconds;
+    std::vector<double> notify_us;
+    std::vector<double> call_us;
+};
+
+static BenchResult run_mode(size_t adapters, bool sharded, const BenchConfig& config) {
+    SimpleDBus::Connection daemon(DBUS_BUS_SESSION);
+    daemon.init();
+
+    // Either a single connection serving every adapter, or one connection per adapter.
+    std::vector<std::unique_ptr<SimpleDBus::Connection>> clients;
+    for (size_t a = 0; a < (sharded ? adapters : 1); a++) {
+        auto client = std::make_unique<SimpleDBus::Connection>(DBUS_BUS_SESSION);
+        client->init();
+        std::string rule = std::string("type='signal',sender='") + daemon.unique_name() + "',interface='" +
+                           BENCH_INTERFACE + "'";
+        client->add_match(sharded ? rule + ",path_namespace='" + adapter_path(a) + "'" : rule);
+        clients.push_back(std::move(client));
+    }
+    auto client_of = [&](size_t adapter) -> SimpleDBus::Connection& { return *clients[sharded ? adapter : 0]; };
+
+    std::atomic_bool measuring = false;
+    std::atomic<uint64_t> handled = 0;
+    std::mutex latencies_mutex;
+    std::vector<double> notify_us;
+    std::vector<double> call_us;
+
+    for (size_t a = 0; a < adapters; a++) {
+        for (size_t d = 0; d < config.devices; d++) {
+            daemon.register_object_path(device_path(d, a), [&daemon](SimpleDBus::Message& msg) {
+                auto reply = SimpleDBus::Message::create_method_return(msg);
+                reply.append_argument(SimpleDBus::Holder::create_uint64(42), "t");
+                daemon.send(reply);
+            });
+
+            client_of(a).register_signal_handler(device_path(d, a), [&](SimpleDBus::Message& msg) {
+                uint64_t received = now_ns();
+                uint64_t sent = msg.extract().get_uint64();
+                std::this_thread::sleep_for(config.work);
+                if (!measuring) {
+                    return;
+                }
+
+                handled++;
+                std::scoped_lock lock(latencies_mutex);
+                notify_us.push_back((received - sent) / 1000.0);
+            });
+        }
+    }
+
+    uint64_t total_handled = 0;
+    double elapsed = 0;
+    {
+        DispatchLoop daemon_loop(daemon);
+        std::vector<std::unique_ptr<DispatchLoop>> client_loops;
+        for (auto& client : clients) {
+            client_loops.push_back(std::make_unique<DispatchLoop>(*client));
+        }
+
+        std::atomic_bool emitting = true;
+        std::thread emitter([&]() {
+            while (emitting) {
+                for (size_t a = 0; a < adapters; a++) {
+                    for (size_t d = 0; d < config.devices; d++) {
+                        auto signal = SimpleDBus::Message::create_signal(device_path(d, a), BENCH_INTERFACE, "Notify");
+                        signal.append_argument(SimpleDBus::Holder::create_uint64(now_ns()), "t");
+                        daemon.send(signal);
+                    }
+                }
+                std::this_thread::sleep_for(config.period);
+            }
+        });
+
+        // Every adapter is polled by its own caller, as an application talking to each of them would.
+        std::vector<std::thread> callers;
+        for (size_t a = 0; a < adapters; a++) {
+            callers.emplace_back([&, a]() {
+                while (emitting) {
+                    auto call = SimpleDBus::Message::create_method_call(daemon.unique_name(), device_path(0, a),
+                                                                        BENCH_INTERFACE, "ReadValue");
+                    auto start = steady_clock::now();
+                    client_of(a).send_with_reply_and_block(call);
+                    double us = duration<double, std::micro>(steady_clock::now() - start).count();
+                    if (measuring) {
+                        std::scoped_lock lock(latencies_mutex);
+                        call_us.push_back(us);
+                    }
+                    std::this_thread::sleep_for(config.period);
+                }
+            });
+        }
+
+        // Warm up before measuring.
+        std::this_thread::sleep_for(milliseconds(300));
+        measuring = true;
+        auto start = steady_clock::now();
+        std::this_thread::sleep_for(config.duration);
+        measuring = false;
+        elapsed = duration<double>(steady_clock::now() - start).count();
+        total_handled = handled;
+
+        emitting = false;
+        emitter.join();
+        for (auto& caller : callers) {
+            caller.join();
+        }
+    }
+
+    for (size_t a = 0; a < adapters; a++) {
+        for (size_t d = 0; d < config.devices; d++) {
+            client_of(a).unregister_signal_handler(device_path(d, a));
+            daemon.unregister_object_path(device_path(d, a));
+        }
+    }
+    for (auto& client : clients) {
+        client->uninit();
+    }
+    daemon.uninit();
+
+    std::scoped_lock lock(latencies_mutex);
+    return {total_handled, elapsed, notify_us, call_us};
+}
+
+static void report(size_t adapters, const char* mode, const BenchResult& result) {
+    std::printf("%-9zu %-12s %12.1f %14.1f %14.1f %12.1f %12.1f\n", adapters, mode, result.handled / result.seconds,
+                percentile(result.notify_us, 50), percentile(result.notify_us, 99), percentile(result.call_us, 50),
+                percentile(result.call_us, 99));
+    std::fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+    BenchConfig config;
+    config.devices = argc > 1 ? std::atoi(argv[1]) : 4;
+    config.work = microseconds(argc > 2 ? std::atoi(argv[2]) : 500);
+    config.period = milliseconds(argc > 3 ? std::atoi(argv[3]) : 5);
+    config.duration = seconds(3);
+
+    std::printf("Devices per adapter: %zu, callback: %lldus, period: %lldms\n", config.devices,
+                static_cast<long long>(config.work.count()), static_cast<long long>(config.period.count()));
+    std::printf("%-9s %-12s %12s %14s %14s %12s %12s\n", "adapters", "connections", "handled/s", "notify p50 us",
+                "notify p99 us", "call p50 us", "call p99 us");
+    std::fflush(stdout);
+
+    for (size_t adapters : {1, 2, 4}) {
+        report(adapters, "shared", run_mode(adapters, false, config));
+        report(adapters, "per-adapter", run_mode(adapters, true, config));
+    }
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+// Compares building and extracting `ay` payloads of 20, 244 and 512 bytes, i.e. a legacy
+// notification, a full LE data length notification and a long write, as one Holder per byte
+// against a contiguous byte array Holder. Reports the time per append and per extraction.
+//
+// Does not require a bus.
+
+#include <simpledbus/base/Message.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace std::chrono;
+
+static constexpr const char* BENCH_INTERFACE = "org.simpledbus.Bench";
+
+struct BenchResult {
+    double append_ns;
+    double extract_ns;
+};
+
+static std::vector<uint8_t> payload(size_t size) {
+    std::vector<uint8_t> bytes(size);
+    for (size_t i = 0; i < size; i++) {
+        bytes[i] = static_cast<uint8_t>(i * 7);
+    }
+    return bytes;
+}
+
+static SimpleDBus::Holder per_byte_holder(const std::vector<uint8_t>& bytes) {
+    SimpleDBus::Holder holder = SimpleDBus::Holder::create_array();
+    for (uint8_t byte : bytes) {
+        holder.array_append(SimpleDBus::Holder::create_byte(byte));
+    }
+    return holder;
+}
+
+// How `ay` arguments used to be extracted, one Holder per byte.
+static SimpleDBus::Holder per_byte_extract(SimpleDBus::Message& msg) {
+    DBusMessageIter iter;
+    DBusMessageIter sub_iter;
+    dbus_message_iter_init(msg, &iter);
+    dbus_message_iter_recurse(&iter, &sub_iter);
+
+    const unsigned char* bytes;
+    int len;
+    dbus_message_iter_get_fixed_array(&sub_iter, &bytes, &len);
+    SimpleDBus::Holder holder = SimpleDBus::Holder::create_array();
+    for (int i = 0; i < len; i++) {
+        holder.array_append(SimpleDBus::Holder::create_byte(bytes[i]));
+    }
+    return holder;
+}
+
+static BenchResult run_mode(bool contiguous, size_t size, size_t iterations) {
+    std::vector<uint8_t> bytes = payload(size);
+    size_t checksum = 0;
+
+    auto start = steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        auto msg = SimpleDBus::Message::create_signal("/org/bluez/hci0/dev_0/char0", BENCH_INTERFACE, "Notify");
+        SimpleDBus::Holder value = contiguous ? SimpleDBus::Holder::create_byte_array(bytes) : per_byte_holder(bytes);
+        msg.append_argument(value, "ay");
+        checksum += msg.is_valid();
+    }
+    double append_ns = duration<double, std::nano>(steady_clock::now() - start).count() / iterations;
+
+    auto msg = SimpleDBus::Message::create_signal("/org/bluez/hci0/dev_0/char0", BENCH_INTERFACE, "Notify");
+    msg.append_argument(SimpleDBus::Holder::create_byte_array(bytes), "ay");
+
+    start = steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        if (contiguous) {
+            msg.extract_reset();
+            checksum += msg.extract().type();
+        } else {
+            checksum += per_byte_extract(msg).type();
+        }
+    }
+    double extract_ns = duration<double, std::nano>(steady_clock::now() - start).count() / iterations;
+
+    if (checksum == 0) {
+        std::printf("unexpected checksum\n");
+    }
+    return {append_ns, extract_ns};
+}
+
+static void report(size_t size, const char* mode, const BenchResult& result) {
+    std::printf("%-8zu %-12s %12.1f %12.1f\n", size, mode, result.append_ns, result.extract_ns);
+    std::fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+    size_t iterations = argc > 1 ? std::atoi(argv[1]) : 20000;
+
+    std::printf("Iterations: %zu\n", iterations);
+    std::printf("%-8s %-12s %12s %12s\n", "bytes", "holder", "append ns", "extract ns");
+    std::fflush(stdout);
+
+    for (size_t size : {20, 244, 512}) {
+        report(size, "per-byte", run_mode(false, size, iterations));
+        report(size, "contiguous", run_mode(true, size, iterations));
+    }
+
+    return 0;
+}
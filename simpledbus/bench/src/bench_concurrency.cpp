@@ -0,0 +1,275 @@
+// Multi-threaded stress test: N client threads issue blocking `ReadValue` calls against N
+// emulated devices whose replies are delayed, while every device emits timestamped
+// notifications. Reports the aggregate call throughput and the notification latency
+// observed by the client dispatch loop while reads are in flight.
+//
+// The "serialized" mode emulates the previous locking model, in which a single
+// connection-wide lock was held both for the full round trip of a blocking call and
+// while dispatching, so that it can be compared against the current behavior. The "async"
+// mode waits on `send_with_reply_async` instead, whose replies are completed by the
+// dispatch loop rather than by whichever blocked thread owns the socket at the time.
+//
+// Requires a session bus, e.g. `dbus-run-session -- ./simpledbus_bench_concurrency`.
+
+#include <simpledbus/base/Connection.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "helpers/Bench.h"
+
+using namespace std::chrono;
+using namespace Bench;
+
+static constexpr const char* BENCH_INTERFACE = "org.simpledbus.Bench";
+
+enum class LockMode { SERIALIZED, CONCURRENT, ASYNC };
+
+struct BenchConfig {
+    size_t devices;
+    milliseconds reply_delay;
+    milliseconds notify_period;
+    seconds duration;
+};
+
+struct BenchResult {
+    uint64_t operations;
+    double seconds;
+    std::vector<double> latencies_us;
+};
+
+// Emulates N devices: replies to `ReadValue` after a fixed delay and periodically emits a
+// `Notify` signal per device carrying the emission timestamp.
+class DeviceServer {
+  public:
+    explicit DeviceServer(const BenchConfig& config) : _config(config), _conn(DBUS_BUS_SESSION) {
+        _conn.init();
+        for (size_t i = 0; i < _config.devices; i++) {
+            _conn.register_object_path(device_path(i), [this](SimpleDBus::Message& msg) { _handle(msg); });
+        }
+
+        _loop_thread = std::thread([this]() {
+            while (_active) {
+                _conn.read_write_dispatch();
+                _conn.process_events(100);
+            }
+        });
+        _reply_thread = std::thread([this]() { _reply_loop(); });
+        _notify_thread = std::thread([this]() { _notify_loop(); });
+    }
+
+    ~DeviceServer() {
+        {
+            std::scoped_lock lock(_reply_mutex);
+            _active = false;
+        }
+        _reply_cv.notify_all();
+        _conn.wakeup();
+        _loop_thread.join();
+        _reply_thread.join();
+        _notify_thread.join();
+
+        for (size_t i = 0; i < _config.devices; i++) {
+            _conn.unregister_object_path(device_path(i));
+        }
+        _conn.uninit();
+    }
+
+    std::string unique_name() { return _conn.unique_name(); }
+
+  private:
+    struct PendingReply {
+        steady_clock::time_point due;
+        SimpleDBus::Message reply;
+        bool operator>(const PendingReply& other) const { return due > other.due; }
+    };
+
+    void _handle(SimpleDBus::Message& msg) {
+        if (!msg.is_method_call(BENCH_INTERFACE, "ReadValue")) {
+            return;
+        }
+
+        SimpleDBus::Message reply = SimpleDBus::Message::create_method_return(msg);
+        reply.append_argument(SimpleDBus::Holder::create_uint64(now_ns()), "t");
+
+        std::scoped_lock lock(_reply_mutex);
+        _replies.push({steady_clock::now() + _config.reply_delay, reply});
+        _reply_cv.notify_all();
+    }
+
+    void _reply_loop() {
+        std::unique_lock lock(_reply_mutex);
+        while (_active) {
+            if (_replies.empty()) {
+                _reply_cv.wait(lock);
+                continue;
+            }
+
+            if (_reply_cv.wait_until(lock, _replies.top().due) == std::cv_status::no_timeout) {
+                continue;
+            }
+
+            while (!_replies.empty() && _replies.top().due <= steady_clock::now()) {
+                SimpleDBus::Message reply = _replies.top().reply;
+                _replies.pop();
+                _conn.send(reply);
+            }
+        }
+    }
+
+    void _notify_loop() {
+        while (_active) {
+            for (size_t i = 0; i < _config.devices; i++) {
+                auto signal = SimpleDBus::Message::create_signal(device_path(i), BENCH_INTERFACE, "Notify");
+                signal.append_argument(SimpleDBus::Holder::create_uint64(now_ns()), "t");
+                _conn.send(signal);
+            }
+            std::this_thread::sleep_for(_config.notify_period);
+        }
+    }
+
+    BenchConfig _config;
+    SimpleDBus::Connection _conn;
+    std::atomic_bool _active = true;
+
+    std::thread _loop_thread;
+    std::thread _reply_thread;
+    std::thread _notify_thread;
+
+    std::mutex _reply_mutex;
+    std::condition_variable _reply_cv;
+    std::priority_queue<PendingReply, std::vector<PendingReply>, std::greater<PendingReply>> _replies;
+};
+
+static BenchResult run_mode(LockMode mode, const BenchConfig& config) {
+    DeviceServer server(config);
+    std::string server_name = server.unique_name();
+
+    SimpleDBus::Connection client(DBUS_BUS_SESSION);
+    client.init();
+
+    // Emulates the connection-wide lock of the previous locking model.
+    std::recursive_mutex global_lock;
+
+    std::atomic_bool measuring = false;
+    std::mutex latencies_mutex;
+    std::vector<double> latencies_us;
+
+    client.add_match(std::string("type='signal',interface='") + BENCH_INTERFACE + "',sender='" + server_name + "'");
+    for (size_t i = 0; i < config.devices; i++) {
+        client.register_signal_handler(device_path(i), [&](SimpleDBus::Message& msg) {
+            uint64_t received = now_ns();
+            if (!measuring || !msg.is_signal(BENCH_INTERFACE, "Notify")) {
+                return;
+            }
+
+            uint64_t sent = msg.extract().get_uint64();
+            std::scoped_lock lock(latencies_mutex);
+            latencies_us.push_back((received - sent) / 1000.0);
+        });
+    }
+
+    std::atomic_bool active = true;
+    std::thread loop([&]() {
+        while (active) {
+            if (mode == LockMode::SERIALIZED) {
+                std::scoped_lock lock(global_lock);
+                client.read_write_dispatch();
+            } else {
+                client.read_write_dispatch();
+            }
+            client.process_events(1000);
+        }
+    });
+
+    std::atomic_bool reading = true;
+    std::atomic<uint64_t> operations = 0;
+    std::vector<std::thread> readers;
+    for (size_t i = 0; i < config.devices; i++) {
+        readers.emplace_back([&, i]() {
+            while (reading) {
+                auto call = SimpleDBus::Message::create_method_call(server_name, device_path(i), BENCH_INTERFACE,
+                                                                    "ReadValue");
+                if (mode == LockMode::SERIALIZED) {
+                    std::scoped_lock lock(global_lock);
+                    client.send_with_reply_and_block(call);
+                } else if (mode == LockMode::ASYNC) {
+                    client.send_with_reply_async(call).get();
+                } else {
+                    client.send_with_reply_and_block(call);
+                }
+
+                if (measuring) {
+                    operations++;
+                }
+            }
+        });
+    }
+
+    // Warm up before measuring.
+    std::this_thread::sleep_for(milliseconds(200));
+    measuring = true;
+    auto start = steady_clock::now();
+    std::this_thread::sleep_for(config.duration);
+    measuring = false;
+    double elapsed = duration<double>(steady_clock::now() - start).count();
+    uint64_t total_operations = operations;
+
+    // Readers waiting on an asynchronous reply need the dispatch loop to keep running.
+    reading = false;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    active = false;
+    client.wakeup();
+    loop.join();
+
+    for (size_t i = 0; i < config.devices; i++) {
+        client.unregister_signal_handler(device_path(i));
+    }
+    client.uninit();
+
+    std::scoped_lock lock(latencies_mutex);
+    return {total_operations, elapsed, latencies_us};
+}
+
+static void report(const char* name, const BenchResult& result) {
+    double mean = 0;
+    for (double latency : result.latencies_us) mean += latency;
+    mean = result.latencies_us.empty() ? 0 : mean / result.latencies_us.size();
+
+    std::printf("%-11s %10.1f %10zu %12.1f %12.1f %12.1f %12.1f\n", name, result.operations / result.seconds,
+                result.latencies_us.size(), mean, percentile(result.latencies_us, 50),
+                percentile(result.latencies_us, 99), percentile(result.latencies_us, 100));
+    std::fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+    BenchConfig config;
+    config.devices = argc > 1 ? std::atoi(argv[1]) : 8;
+    config.reply_delay = milliseconds(argc > 2 ? std::atoi(argv[2]) : 20);
+    config.notify_period = milliseconds(argc > 3 ? std::atoi(argv[3]) : 10);
+    config.duration = seconds(argc > 4 ? std::atoi(argv[4]) : 3);
+
+    std::printf("Devices: %zu, reply delay: %lldms, notify period: %lldms, duration: %llds\n", config.devices,
+                static_cast<long long>(config.reply_delay.count()),
+                static_cast<long long>(config.notify_period.count()),
+                static_cast<long long>(config.duration.count()));
+    std::printf("%-11s %10s %10s %12s %12s %12s %12s\n", "mode", "reads/s", "notifies", "mean us", "p50 us",
+                "p99 us", "max us");
+    std::fflush(stdout);
+
+    report("serialized", run_mode(LockMode::SERIALIZED, config));
+    report("concurrent", run_mode(LockMode::CONCURRENT, config));
+    report("async", run_mode(LockMode::ASYNC, config));
+
+    return 0;
+}
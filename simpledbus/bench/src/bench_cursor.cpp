@@ -0,0 +1,124 @@
+// Reads the signals SimpleBluez receives the most of, decoding them whole through `extract`
+// against pulling out only what is used through a `Cursor`: an `InterfacesAdded` signal of a
+// device where only one of its interfaces is instantiated, and a `PropertiesChanged` signal of
+// an interface that is not loaded, which a cursor drops after reading its name. Reports the
+// time and the heap allocations per signal.
+//
+// Does not require a bus.
+
+#include <simpledbus/base/Cursor.h>
+#include <simpledbus/base/Message.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "helpers/Bench.h"
+
+using namespace Bench;
+
+static constexpr const char* DEVICE_PATH = "/org/bluez/hci0/dev_00_11_22_33_44_55";
+
+static SimpleDBus::Message interfaces_added() {
+    std::map<std::string, SimpleDBus::Holder> device = {
+        {"Address", SimpleDBus::Holder::create_string("00:11:22:33:44:55")},
+        {"AddressType", SimpleDBus::Holder::create_string("public")},
+        {"Name", SimpleDBus::Holder::create_string("Peripheral")},
+        {"Alias", SimpleDBus::Holder::create_string("Peripheral")},
+        {"Paired", SimpleDBus::Holder::create_boolean(false)},
+        {"Connected", SimpleDBus::Holder::create_boolean(false)},
+        {"RSSI", SimpleDBus::Holder::create_int16(-60)},
+        {"TxPower", SimpleDBus::Holder::create_int16(4)},
+        {"ServicesResolved", SimpleDBus::Holder::create_boolean(false)},
+        {"ManufacturerData", SimpleDBus::Holder::create_dict()},
+    };
+    SimpleDBus::Holder uuids = SimpleDBus::Holder::create_array();
+    for (int i = 0; i < 8; i++) {
+        uuids.array_append(SimpleDBus::Holder::create_string("0000180" + std::to_string(i) +
+                                                             "-0000-1000-8000-00805f9b34fb"));
+    }
+    device.emplace("UUIDs", uuids);
+
+    std::map<std::string, std::map<std::string, SimpleDBus::Holder>> interfaces = {
+        {"org.bluez.Device1", device},
+        {"org.bluez.Battery1", {{"Percentage", SimpleDBus::Holder::create_byte(90)}}},
+        {"org.bluez.MediaControl1", {{"Connected", SimpleDBus::Holder::create_boolean(false)}}},
+        {"org.freedesktop.DBus.Introspectable", {}},
+        {"org.freedesktop.DBus.Properties", {}},
+    };
+
+    auto msg = SimpleDBus::Message::create_signal("/", "org.freedesktop.DBus.ObjectManager", "InterfacesAdded");
+    msg.append(SimpleDBus::ObjectPath(DEVICE_PATH), interfaces);
+    return msg;
+}
+
+static SimpleDBus::Message properties_changed() {
+    std::map<std::string, SimpleDBus::Holder> changed = {
+        {"Connected", SimpleDBus::Holder::create_boolean(true)},
+        {"RSSI", SimpleDBus::Holder::create_int16(-60)},
+        {"ManufacturerData", SimpleDBus::Holder::create_dict()},
+    };
+    auto msg = SimpleDBus::Message::create_signal(DEVICE_PATH, "org.freedesktop.DBus.Properties", "PropertiesChanged");
+    msg.append(std::string("org.bluez.MediaControl1"), changed, std::vector<std::string>());
+    return msg;
+}
+
+static void report(const char* message, const char* path, const Measurement& result) {
+    std::printf("%-18s %-8s %12.1f %14.1f\n", message, path, result.ns, result.allocations);
+    std::fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+    size_t iterations = argc > 1 ? std::atoi(argv[1]) : 50000;
+    size_t checksum = 0;
+
+    std::printf("Iterations: %zu\n", iterations);
+    std::printf("%-18s %-8s %12s %14s\n", "signal", "path", "ns", "allocations");
+    std::fflush(stdout);
+
+    SimpleDBus::Message added = interfaces_added();
+    report("InterfacesAdded", "extract", measure(iterations, [&]() {
+               SimpleDBus::Message msg = added;
+               std::string path = msg.extract().get_string();
+               msg.extract_next();
+               SimpleDBus::Holder interfaces = msg.extract();
+               checksum += interfaces.dict_find("org.bluez.Device1") != nullptr;
+           }));
+    report("InterfacesAdded", "cursor", measure(iterations, [&]() {
+               SimpleDBus::Cursor cursor(added);
+               std::string path(cursor.get<std::string_view>());
+               SimpleDBus::Holder::Dict interfaces;
+               cursor.next();
+               cursor.for_each_entry([&](const SimpleDBus::Cursor& key, const SimpleDBus::Cursor& value) {
+                   std::string iface_name(key.get<std::string_view>());
+                   if (iface_name == "org.bluez.Device1") {
+                       interfaces.emplace_back(SimpleDBus::Holder::create_string(iface_name), value.extract());
+                   }
+                   return true;
+               });
+               checksum += interfaces.size();
+           }));
+
+    SimpleDBus::Message changed = properties_changed();
+    report("PropertiesChanged", "extract", measure(iterations, [&]() {
+               SimpleDBus::Message msg = changed;
+               std::string interface = msg.extract().get_string();
+               msg.extract_next();
+               SimpleDBus::Holder properties = msg.extract();
+               msg.extract_next();
+               SimpleDBus::Holder invalidated = msg.extract();
+               checksum += interface.size();
+           }));
+    report("PropertiesChanged", "cursor", measure(iterations, [&]() {
+               SimpleDBus::Cursor cursor(changed);
+               std::string interface(cursor.get<std::string_view>());
+               checksum += interface.size();
+           }));
+
+    if (checksum == 0) {
+        std::printf("unexpected checksum\n");
+    }
+    return 0;
+}
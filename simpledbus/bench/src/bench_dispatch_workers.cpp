@@ -0,0 +1,179 @@
+// Emulates devices emitting timestamped notifications whose callbacks either burn CPU or
+// block (e.g. on I/O), one of them being much slower than the rest, and compares handling
+// them on the dispatching thread against handing them over to dispatch workers. Reports the
+// notifications handled per second, the latency of the fast devices and the number of
+// notifications handled out of order for any device.
+//
+// Requires a session bus, e.g. `dbus-run-session -- ./simpledbus_bench_dispatch_workers`.
+
+#include <simpledbus/base/Connection.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "helpers/Bench.h"
+
+using namespace std::chrono;
+using namespace Bench;
+
+static constexpr const char* BENCH_INTERFACE = "org.simpledbus.Bench";
+
+struct BenchConfig {
+    size_t devices;
+    microseconds work;
+    microseconds slow_work;
+    milliseconds period;
+    seconds duration;
+    bool blocking;
+};
+
+struct BenchResult {
+    uint64_t handled;
+    uint64_t out_of_order;
+    double seconds;
+    std::vector<double> latencies_us;
+};
+
+static std::string characteristic_path(size_t index) { return device_path(index) + "/char0"; }
+
+static void work_for(microseconds work, bool blocking) {
+    if (blocking) {
+        std::this_thread::sleep_for(work);
+        return;
+    }
+
+    auto until = steady_clock::now() + work;
+    while (steady_clock::now() < until) {
+    }
+}
+
+static BenchResult run_mode(size_t workers, const BenchConfig& config) {
+    SimpleDBus::Connection receiver(DBUS_BUS_SESSION);
+    SimpleDBus::Connection emitter(DBUS_BUS_SESSION);
+    receiver.set_dispatch_workers(workers, 4);
+    receiver.init();
+    emitter.init();
+    receiver.add_match(std::string("type='signal',interface='") + BENCH_INTERFACE + "'");
+
+    std::atomic_bool measuring = false;
+    std::atomic<uint64_t> handled = 0;
+    std::atomic<uint64_t> out_of_order = 0;
+    std::mutex latencies_mutex;
+    std::vector<double> latencies_us;
+
+    // Notifications of a device and of its characteristic share a single sequence.
+    std::vector<uint64_t> last_sequence(config.devices, 0);
+    for (size_t i = 0; i < config.devices; i++) {
+        auto handler = [&, i](SimpleDBus::Message& msg) {
+            uint64_t received = now_ns();
+            SimpleDBus::Holder args = msg.extract();
+            uint64_t sent = args.get_uint64();
+            msg.extract_next();
+            uint64_t sequence = msg.extract().get_uint64();
+
+            if (sequence <= last_sequence[i]) {
+                out_of_order++;
+            }
+            last_sequence[i] = sequence;
+
+            work_for(i == 0 ? config.slow_work : config.work, config.blocking);
+            if (!measuring) {
+                return;
+            }
+
+            handled++;
+            if (i != 0) {
+                std::scoped_lock lock(latencies_mutex);
+                latencies_us.push_back((received - sent) / 1000.0);
+            }
+        };
+        receiver.register_signal_handler(device_path(i), handler);
+        receiver.register_signal_handler(characteristic_path(i), handler);
+    }
+
+    std::atomic_bool active = true;
+    std::thread loop([&]() {
+        while (active) {
+            receiver.read_write_dispatch();
+            receiver.process_events(100);
+        }
+    });
+
+    std::atomic_bool emitting = true;
+    std::thread emitter_thread([&]() {
+        uint64_t sequence = 0;
+        while (emitting) {
+            sequence++;
+            for (size_t i = 0; i < config.devices; i++) {
+                auto path = sequence % 2 ? characteristic_path(i) : device_path(i);
+                auto signal = SimpleDBus::Message::create_signal(path, BENCH_INTERFACE, "Notify");
+                signal.append_argument(SimpleDBus::Holder::create_uint64(now_ns()), "t");
+                signal.append_argument(SimpleDBus::Holder::create_uint64(sequence), "t");
+                emitter.send(signal);
+            }
+            std::this_thread::sleep_for(config.period);
+        }
+    });
+
+    // Warm up before measuring.
+    std::this_thread::sleep_for(milliseconds(200));
+    measuring = true;
+    auto start = steady_clock::now();
+    std::this_thread::sleep_for(config.duration);
+    measuring = false;
+    double elapsed = duration<double>(steady_clock::now() - start).count();
+    uint64_t total_handled = handled;
+
+    emitting = false;
+    emitter_thread.join();
+    active = false;
+    receiver.wakeup();
+    loop.join();
+
+    for (size_t i = 0; i < config.devices; i++) {
+        receiver.unregister_signal_handler(device_path(i));
+        receiver.unregister_signal_handler(characteristic_path(i));
+    }
+    receiver.uninit();
+    emitter.uninit();
+
+    std::scoped_lock lock(latencies_mutex);
+    return {total_handled, out_of_order, elapsed, latencies_us};
+}
+
+static void report(size_t workers, const BenchResult& result) {
+    std::printf("%-8zu %12.1f %12llu %12.1f %12.1f %12.1f\n", workers, result.handled / result.seconds,
+                static_cast<unsigned long long>(result.out_of_order), percentile(result.latencies_us, 50),
+                percentile(result.latencies_us, 99), percentile(result.latencies_us, 100));
+    std::fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+    BenchConfig config;
+    config.devices = argc > 1 ? std::atoi(argv[1]) : 8;
+    config.work = microseconds(argc > 2 ? std::atoi(argv[2]) : 200);
+    config.slow_work = microseconds(argc > 3 ? std::atoi(argv[3]) : 2000);
+    config.period = milliseconds(argc > 4 ? std::atoi(argv[4]) : 5);
+    config.duration = seconds(3);
+    config.blocking = argc > 5 && std::string(argv[5]) == "sleep";
+
+    std::vector<size_t> worker_counts = {0, 2, 4};
+    std::printf("Devices: %zu, callback %s: %lldus (slowest device %lldus), period: %lldms\n", config.devices,
+                config.blocking ? "sleep" : "spin", static_cast<long long>(config.work.count()),
+                static_cast<long long>(config.slow_work.count()), static_cast<long long>(config.period.count()));
+    std::printf("%-8s %12s %12s %12s %12s %12s\n", "workers", "handled/s", "reordered", "fast p50 us", "fast p99 us",
+                "fast max us");
+    std::fflush(stdout);
+
+    for (size_t workers : worker_counts) {
+        report(workers, run_mode(workers, config));
+    }
+
+    return 0;
+}
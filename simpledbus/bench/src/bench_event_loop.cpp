@@ -0,0 +1,133 @@
+// Compares the legacy busy-poll loop (non-blocking dispatch + 100us sleep) against the
+// event-driven loop (`Connection::process_events`), reporting the CPU time consumed by
+// the loop thread while the bus is idle and the wake-up latency of incoming signals.
+//
+// Requires a session bus, e.g. `dbus-run-session -- ./simpledbus_bench_event_loop`.
+
+#include <simpledbus/base/Connection.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "helpers/Bench.h"
+
+using namespace std::chrono;
+using namespace Bench;
+
+static constexpr const char* BENCH_PATH = "/org/simpledbus/bench";
+static constexpr const char* BENCH_INTERFACE = "org.simpledbus.Bench";
+
+enum class LoopMode { POLL, EVENT };
+
+struct LoopResult {
+    double idle_cpu_percent;
+    uint64_t idle_iterations;
+    std::vector<double> latencies_us;
+};
+
+static LoopResult run_mode(LoopMode mode, seconds idle_duration, size_t signal_count) {
+    SimpleDBus::Connection receiver(DBUS_BUS_SESSION);
+    SimpleDBus::Connection emitter(DBUS_BUS_SESSION);
+    receiver.init();
+    emitter.init();
+
+    std::mutex latencies_mutex;
+    std::vector<double> latencies_us;
+    receiver.add_match(std::string("type='signal',interface='") + BENCH_INTERFACE + "'");
+    receiver.register_signal_handler(BENCH_PATH, [&](SimpleDBus::Message& msg) {
+        uint64_t received = now_ns();
+        uint64_t sent = msg.extract().get_uint64();
+        std::scoped_lock lock(latencies_mutex);
+        latencies_us.push_back((received - sent) / 1000.0);
+    });
+
+    std::atomic_bool active = true;
+    std::atomic_bool measuring = false;
+    std::atomic<uint64_t> iterations = 0;
+    std::atomic<double> cpu_start = 0;
+    std::atomic<double> cpu_end = 0;
+
+    std::thread loop([&]() {
+        bool measured = false;
+        while (active) {
+            if (measuring && !measured) {
+                cpu_start = thread_cpu_seconds();
+                iterations = 0;
+                measured = true;
+            } else if (!measuring && measured) {
+                cpu_end = thread_cpu_seconds();
+                measured = false;
+            }
+
+            receiver.read_write_dispatch();
+            if (mode == LoopMode::POLL) {
+                std::this_thread::sleep_for(microseconds(100));
+            } else {
+                receiver.process_events(1000);
+            }
+            iterations++;
+        }
+    });
+
+    // Idle phase: no traffic on the bus for this connection.
+    std::this_thread::sleep_for(milliseconds(200));
+    measuring = true;
+    receiver.wakeup();
+    auto wall_start = steady_clock::now();
+    std::this_thread::sleep_for(idle_duration);
+    measuring = false;
+    receiver.wakeup();
+    uint64_t idle_iterations = iterations;
+    double wall_seconds = duration<double>(steady_clock::now() - wall_start).count();
+    std::this_thread::sleep_for(milliseconds(50));
+
+    // Latency phase: signals emitted at a low rate so that each one finds the loop idle.
+    for (size_t i = 0; i < signal_count; i++) {
+        auto signal = SimpleDBus::Message::create_signal(BENCH_PATH, BENCH_INTERFACE, "Ping");
+        signal.append_argument(SimpleDBus::Holder::create_uint64(now_ns()), "t");
+        emitter.send(signal);
+        std::this_thread::sleep_for(milliseconds(2));
+    }
+    std::this_thread::sleep_for(milliseconds(200));
+
+    active = false;
+    receiver.wakeup();
+    loop.join();
+
+    receiver.unregister_signal_handler(BENCH_PATH);
+    receiver.uninit();
+    emitter.uninit();
+
+    std::scoped_lock lock(latencies_mutex);
+    return {100.0 * (cpu_end - cpu_start) / wall_seconds, idle_iterations, latencies_us};
+}
+
+static void report(const char* name, const LoopResult& result, size_t signal_count) {
+    double mean = 0;
+    for (double latency : result.latencies_us) mean += latency;
+    mean = result.latencies_us.empty() ? 0 : mean / result.latencies_us.size();
+
+    std::printf("%-8s %10.3f %12llu %9zu/%-4zu %10.1f %10.1f %10.1f %10.1f\n", name, result.idle_cpu_percent,
+                static_cast<unsigned long long>(result.idle_iterations), result.latencies_us.size(), signal_count,
+                mean, percentile(result.latencies_us, 50), percentile(result.latencies_us, 99),
+                percentile(result.latencies_us, 100));
+}
+
+int main(int argc, char** argv) {
+    seconds idle_duration(argc > 1 ? std::atoi(argv[1]) : 5);
+    size_t signal_count = argc > 2 ? std::atoi(argv[2]) : 500;
+
+    std::printf("Idle period: %llds, signals: %zu\n", static_cast<long long>(idle_duration.count()), signal_count);
+    std::printf("%-8s %10s %12s %14s %10s %10s %10s %10s\n", "mode", "idle cpu%", "idle wakeups", "received",
+                "mean us", "p50 us", "p99 us", "max us");
+
+    report("poll", run_mode(LoopMode::POLL, idle_duration, signal_count), signal_count);
+    report("event", run_mode(LoopMode::EVENT, idle_duration, signal_count), signal_count);
+
+    return 0;
+}
@@ -0,0 +1,148 @@
+// Extracts a `GetManagedObjects` reply shaped like the one of a busy adapter, with many
+// devices exposing BlueZ-like properties, and reports the size of a Holder along with the
+// heap retained by the extracted object tree and the time spent extracting it. Also reports
+// the time spent looking up a property of every device by converting the dictionaries to
+// maps, compared to looking it up in place, and the time spent reading the UUIDs of every
+// device out of a copy of the array, compared to reading them through a view.
+//
+// Does not require a bus.
+
+#include <simpledbus/base/Message.h>
+
+#include <malloc.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+
+static SimpleDBus::Holder device_properties(size_t index, size_t extra_properties) {
+    using SimpleDBus::Holder;
+
+    char address[18];
+    std::snprintf(address, sizeof(address), "00:11:22:%02X:%02X:%02X", static_cast<unsigned>((index >> 16) & 0xFF),
+                  static_cast<unsigned>((index >> 8) & 0xFF), static_cast<unsigned>(index & 0xFF));
+
+    Holder uuids = Holder::create_array();
+    uuids.array_append(Holder::create_string("0000180f-0000-1000-8000-00805f9b34fb"));
+    uuids.array_append(Holder::create_string("0000180a-0000-1000-8000-00805f9b34fb"));
+
+    Holder manufacturer_data = Holder::create_dict();
+    manufacturer_data.dict_append(Holder::UINT16, static_cast<uint16_t>(0x004C),
+                                  Holder::create_byte_array(std::vector<uint8_t>(16, 0x42)));
+
+    Holder properties = Holder::create_dict();
+    properties.dict_append(Holder::STRING, "Address", Holder::create_string(address));
+    properties.dict_append(Holder::STRING, "AddressType", Holder::create_string("random"));
+    properties.dict_append(Holder::STRING, "Name", Holder::create_string("Device " + std::to_string(index)));
+    properties.dict_append(Holder::STRING, "Alias", Holder::create_string("Device " + std::to_string(index)));
+    properties.dict_append(Holder::STRING, "Adapter", Holder::create_object_path("/org/bluez/hci0"));
+    properties.dict_append(Holder::STRING, "Paired", Holder::create_boolean(false));
+    properties.dict_append(Holder::STRING, "Bonded", Holder::create_boolean(false));
+    properties.dict_append(Holder::STRING, "Trusted", Holder::create_boolean(false));
+    properties.dict_append(Holder::STRING, "Blocked", Holder::create_boolean(false));
+    properties.dict_append(Holder::STRING, "Connected", Holder::create_boolean(false));
+    properties.dict_append(Holder::STRING, "ServicesResolved", Holder::create_boolean(false));
+    properties.dict_append(Holder::STRING, "LegacyPairing", Holder::create_boolean(false));
+    properties.dict_append(Holder::STRING, "RSSI", Holder::create_int16(-60 - static_cast<int16_t>(index % 30)));
+    properties.dict_append(Holder::STRING, "TxPower", Holder::create_int16(4));
+    properties.dict_append(Holder::STRING, "UUIDs", uuids);
+    properties.dict_append(Holder::STRING, "ManufacturerData", manufacturer_data);
+    for (size_t i = 0; i < extra_properties; i++) {
+        properties.dict_append(Holder::STRING, "Extra" + std::to_string(i), Holder::create_uint32(i));
+    }
+
+    Holder introspectable = Holder::create_dict();
+    Holder interfaces = Holder::create_dict();
+    interfaces.dict_append(Holder::STRING, "org.freedesktop.DBus.Introspectable", introspectable);
+    interfaces.dict_append(Holder::STRING, "org.bluez.Device1", properties);
+    interfaces.dict_append(Holder::STRING, "org.freedesktop.DBus.Properties", Holder::create_dict());
+    return interfaces;
+}
+
+static SimpleDBus::Message managed_objects(size_t devices, size_t extra_properties) {
+    using SimpleDBus::Holder;
+
+    Holder objects = Holder::create_dict();
+    for (size_t i = 0; i < devices; i++) {
+        objects.dict_append(Holder::OBJ_PATH, "/org/bluez/hci0/dev_" + std::to_string(i),
+                            device_properties(i, extra_properties));
+    }
+
+    auto msg = SimpleDBus::Message::create_signal("/", "org.simpledbus.Bench", "ManagedObjects");
+    msg.append_argument(objects, "a{oa{sa{sv}}}");
+    return msg;
+}
+
+int main(int argc, char** argv) {
+    size_t devices = argc > 1 ? std::atoi(argv[1]) : 5000;
+    size_t extra_properties = argc > 2 ? std::atoi(argv[2]) : 16;
+
+    SimpleDBus::Message msg = managed_objects(devices, extra_properties);
+
+    auto start = steady_clock::now();
+    SimpleDBus::Holder objects = msg.extract();
+    double extract_ms = duration<double, std::milli>(steady_clock::now() - start).count();
+
+    // The message keeps its own copy of what it extracted, so the heap is measured on a copy.
+    size_t heap_before = mallinfo2().uordblks;
+    SimpleDBus::Holder retained = objects;
+    size_t heap_after = mallinfo2().uordblks;
+
+    int64_t rssi_sum = 0;
+    start = steady_clock::now();
+    for (auto& [path, interfaces] : retained.get_dict_object_path()) {
+        rssi_sum += interfaces.get_dict_string()["org.bluez.Device1"].get_dict_string()["RSSI"].get_int16();
+    }
+    double map_lookup_ms = duration<double, std::milli>(steady_clock::now() - start).count();
+
+    start = steady_clock::now();
+    for (auto& [path, interfaces] : retained.dict_entries()) {
+        const SimpleDBus::Holder* properties = interfaces.dict_find("org.bluez.Device1");
+        const SimpleDBus::Holder* rssi = properties != nullptr ? properties->dict_find("RSSI") : nullptr;
+        rssi_sum -= rssi != nullptr ? rssi->get_int16() : 0;
+    }
+    double find_lookup_ms = duration<double, std::milli>(steady_clock::now() - start).count();
+
+    std::vector<const SimpleDBus::Holder*> device_properties;
+    for (auto& [path, interfaces] : retained.dict_entries()) {
+        device_properties.push_back(interfaces.dict_find("org.bluez.Device1"));
+    }
+
+    size_t uuid_chars = 0;
+    start = steady_clock::now();
+    for (const SimpleDBus::Holder* properties : device_properties) {
+        for (const SimpleDBus::Holder& uuid : properties->dict_find("UUIDs")->get_array()) {
+            uuid_chars += uuid.get_string().size();
+        }
+    }
+    double array_copy_ms = duration<double, std::milli>(steady_clock::now() - start).count();
+
+    start = steady_clock::now();
+    for (const SimpleDBus::Holder* properties : device_properties) {
+        for (const SimpleDBus::Holder& uuid : properties->dict_find("UUIDs")->array_view()) {
+            uuid_chars -= uuid.get_string_view().size();
+        }
+    }
+    double array_view_ms = duration<double, std::milli>(steady_clock::now() - start).count();
+
+    double heap_kb = (static_cast<double>(heap_after) - heap_before) / 1024.0;
+    std::printf("Devices: %zu, properties per device: %zu\n", devices, 16 + extra_properties);
+    std::printf("%-20s %zu\n", "sizeof(Holder) B", sizeof(SimpleDBus::Holder));
+    std::printf("%-20s %.1f\n", "retained KB", heap_kb);
+    std::printf("%-20s %.1f\n", "per device B", heap_kb * 1024.0 / devices);
+    std::printf("%-20s %.1f\n", "extract ms", extract_ms);
+    std::printf("%-20s %.1f\n", "map lookup ms", map_lookup_ms);
+    std::printf("%-20s %.1f\n", "find lookup ms", find_lookup_ms);
+    std::printf("%-20s %.1f\n", "array copy ms", array_copy_ms);
+    std::printf("%-20s %.1f\n", "array view ms", array_view_ms);
+    std::printf("%-20s %zu\n", "objects", retained.dict_entries().size());
+    if (rssi_sum != 0 || uuid_chars != 0) {
+        std::printf("lookups disagree\n");
+    }
+    std::fflush(stdout);
+
+    return 0;
+}
@@ -0,0 +1,177 @@
+// Starts up from a `GetManagedObjects` reply shaped like the one of an adapter with a large
+// device cache, either building every object as `BluezRoot::load_managed_objects` does by
+// default, or lazily as it does with `Bluez::set_lazy_loading`: only the adapter and the
+// connected devices are built, the others are kept as positions in the reply until they are
+// looked up. Reports the time and the heap allocations spent at startup, the proxies built,
+// and the time spent building a deferred device on its first lookup.
+//
+// Does not require a bus.
+
+#include <simpledbus/advanced/Proxy.h>
+#include <simpledbus/base/Connection.h>
+#include <simpledbus/base/Cursor.h>
+#include <simpledbus/base/Message.h>
+#include <simpledbus/base/Path.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "helpers/Bench.h"
+#include "helpers/BluezObjects.h"
+
+using namespace std::chrono;
+using namespace Bench;
+
+static constexpr size_t DEVICE_DEPTH = 4;
+
+// Every device has resolved its services, as BlueZ caches them, but only the first are connected.
+static SimpleDBus::Message managed_objects(size_t devices, size_t connected, size_t characteristics) {
+    using SimpleDBus::Holder;
+
+    Holder objects = Holder::create_dict();
+    objects.dict_append(Holder::OBJ_PATH, "/org/bluez/hci0", adapter_properties());
+    for (size_t i = 0; i < devices; i++) {
+        std::string device = device_path(i);
+        objects.dict_append(Holder::OBJ_PATH, device, device_properties(i, i < connected));
+        append_services(objects, device, characteristics);
+    }
+
+    auto msg = SimpleDBus::Message::create_signal("/", "org.simpledbus.Bench", "ManagedObjects");
+    msg.append_argument(objects, "a{oa{sa{sv}}}");
+    return msg;
+}
+
+// The same reading of the device state as `BluezRoot` does, limited to the connection state.
+static bool device_connected(const SimpleDBus::Cursor& managed_interfaces) {
+    bool connected = false;
+    managed_interfaces.for_each_entry([&](const SimpleDBus::Cursor& name, const SimpleDBus::Cursor& properties) {
+        if (name.get<std::string_view>() != DEVICE) {
+            return true;
+        }
+        properties.for_each_entry([&](const SimpleDBus::Cursor& key, const SimpleDBus::Cursor& value) {
+            if (key.get<std::string_view>() == "Connected") {
+                connected = value.extract().get_boolean();
+                return false;
+            }
+            return true;
+        });
+        return false;
+    });
+    return connected;
+}
+
+static void load_eager(const SimpleDBus::Message& reply, SimpleDBus::Proxy& root) {
+    SimpleDBus::Holder objects = SimpleDBus::Cursor(reply).extract();
+    for (auto& [path, managed_interfaces] : objects.dict_take()) {
+        root.path_add(path.get_object_path(), std::move(managed_interfaces));
+    }
+}
+
+using DeferredObjects = std::map<std::string, SimpleDBus::Cursor, std::less<>>;
+
+static void load_device(SimpleDBus::Proxy& root, DeferredObjects& deferred, std::string_view device) {
+    auto it = deferred.lower_bound(device);
+    while (it != deferred.end() && (it->first == device || SimpleDBus::PathUtils::is_descendant(device, it->first))) {
+        root.path_add(it->first, it->second.extract());
+        it = deferred.erase(it);
+    }
+}
+
+static void load_lazy(const SimpleDBus::Message& reply, SimpleDBus::Proxy& root, DeferredObjects& deferred) {
+    std::vector<std::string> devices_connected;
+    SimpleDBus::Cursor(reply).for_each_entry([&](const SimpleDBus::Cursor& key, const SimpleDBus::Cursor& value) {
+        std::string_view path = key.get<std::string_view>();
+        size_t depth = SimpleDBus::PathUtils::count_elements(path);
+        if (depth < DEVICE_DEPTH) {
+            root.path_add(std::string(path), value.extract());
+            return true;
+        }
+
+        if (depth == DEVICE_DEPTH && device_connected(value)) {
+            devices_connected.emplace_back(path);
+        }
+        deferred.emplace(path, value);
+        return true;
+    });
+
+    for (const auto& device : devices_connected) {
+        load_device(root, deferred, device);
+    }
+}
+
+static size_t count_proxies(SimpleDBus::Proxy& proxy) {
+    size_t count = 1;
+    for (auto& [path, child] : proxy.children()) {
+        count += count_proxies(*child);
+    }
+    return count;
+}
+
+struct BenchResult {
+    double ms = 0;
+    double allocations = 0;
+    size_t proxies = 0;
+};
+
+static void report(const char* mode, const BenchResult& result) {
+    std::printf("%-10s %12.2f %14.0f %10zu\n", mode, result.ms, result.allocations, result.proxies);
+    std::fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+    size_t devices = argc > 1 ? std::atoi(argv[1]) : 5000;
+    size_t connected = argc > 2 ? std::atoi(argv[2]) : 20;
+    size_t characteristics = argc > 3 ? std::atoi(argv[3]) : 10;
+    size_t rounds = argc > 4 ? std::atoi(argv[4]) : 5;
+
+    SimpleDBus::Message reply = managed_objects(devices, connected, characteristics);
+    auto conn = std::make_shared<SimpleDBus::Connection>(DBUS_BUS_SESSION);
+
+    BenchResult eager;
+    BenchResult lazy;
+    double lookup_us = 0;
+    for (size_t round = 0; round < rounds; round++) {
+        {
+            auto root = std::make_shared<SimpleDBus::Proxy>(conn, "org.bluez", "/");
+            uint64_t allocations_before = allocations();
+            auto start = steady_clock::now();
+            load_eager(reply, *root);
+            eager.ms += duration<double, std::milli>(steady_clock::now() - start).count() / rounds;
+            eager.allocations += static_cast<double>(allocations() - allocations_before) / rounds;
+            eager.proxies = count_proxies(*root);
+        }
+
+        {
+            auto root = std::make_shared<SimpleDBus::Proxy>(conn, "org.bluez", "/");
+            DeferredObjects deferred;
+            uint64_t allocations_before = allocations();
+            auto start = steady_clock::now();
+            load_lazy(reply, *root, deferred);
+            lazy.ms += duration<double, std::milli>(steady_clock::now() - start).count() / rounds;
+            lazy.allocations += static_cast<double>(allocations() - allocations_before) / rounds;
+            lazy.proxies = count_proxies(*root);
+
+            // A device that wasn't built at startup, looked up for the first time.
+            std::string device = device_path(devices - 1);
+            start = steady_clock::now();
+            load_device(*root, deferred, device);
+            lookup_us += duration<double, std::micro>(steady_clock::now() - start).count() / rounds;
+            if (!root->path_lookup(device)) {
+                std::printf("deferred device was not built\n");
+            }
+        }
+    }
+
+    std::printf("Devices: %zu, connected: %zu, characteristics: %zu, rounds: %zu\n", devices, connected,
+                characteristics, rounds);
+    std::printf("%-10s %12s %14s %10s\n", "mode", "startup ms", "allocations", "proxies");
+    report("eager", eager);
+    report("lazy", lazy);
+    std::printf("%-24s %12.1f\n", "first lookup us", lookup_us);
+    return 0;
+}
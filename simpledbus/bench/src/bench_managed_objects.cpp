@@ -0,0 +1,94 @@
+// Loads a `GetManagedObjects` reply shaped like the one of an adapter with a large device
+// cache into a tree of proxies, as `BluezRoot::load_managed_objects` does at startup. Reports
+// the time and the heap allocations spent decoding the reply, and spent handing the decoded
+// tree over to the proxies and their interfaces.
+//
+// Does not require a bus.
+
+#include <simpledbus/advanced/Proxy.h>
+#include <simpledbus/base/Connection.h>
+#include <simpledbus/base/Cursor.h>
+#include <simpledbus/base/Message.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include "helpers/Bench.h"
+#include "helpers/BluezObjects.h"
+
+using namespace std::chrono;
+using namespace Bench;
+
+static SimpleDBus::Message managed_objects(size_t devices, size_t connected, size_t characteristics) {
+    using SimpleDBus::Holder;
+
+    Holder objects = Holder::create_dict();
+    for (size_t i = 0; i < devices; i++) {
+        std::string device = device_path(i);
+        objects.dict_append(Holder::OBJ_PATH, device, device_properties(i));
+        if (i < connected) {
+            append_services(objects, device, characteristics);
+        }
+    }
+
+    auto msg = SimpleDBus::Message::create_signal("/", "org.simpledbus.Bench", "ManagedObjects");
+    msg.append_argument(objects, "a{oa{sa{sv}}}");
+    return msg;
+}
+
+struct BenchResult {
+    double ms = 0;
+    double allocations = 0;
+};
+
+static void report(const char* phase, const BenchResult& result) {
+    std::printf("%-10s %12.2f %14.0f\n", phase, result.ms, result.allocations);
+    std::fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+    size_t devices = argc > 1 ? std::atoi(argv[1]) : 2000;
+    size_t connected = argc > 2 ? std::atoi(argv[2]) : 20;
+    size_t characteristics = argc > 3 ? std::atoi(argv[3]) : 10;
+    size_t rounds = argc > 4 ? std::atoi(argv[4]) : 10;
+
+    SimpleDBus::Message reply = managed_objects(devices, connected, characteristics);
+    auto conn = std::make_shared<SimpleDBus::Connection>(DBUS_BUS_SESSION);
+
+    BenchResult decode;
+    BenchResult load;
+    size_t loaded = 0;
+    for (size_t round = 0; round < rounds; round++) {
+        auto root = std::make_shared<SimpleDBus::Proxy>(conn, "org.bluez", "/");
+
+        uint64_t allocations_before = allocations();
+        auto start = steady_clock::now();
+        SimpleDBus::Holder objects = SimpleDBus::Cursor(reply).extract();
+        decode.ms += duration<double, std::milli>(steady_clock::now() - start).count() / rounds;
+        decode.allocations += static_cast<double>(allocations() - allocations_before) / rounds;
+
+        allocations_before = allocations();
+        start = steady_clock::now();
+        for (auto& [path, managed_interfaces] : objects.dict_take()) {
+            root->path_add(path.get_object_path(), std::move(managed_interfaces));
+        }
+        load.ms += duration<double, std::milli>(steady_clock::now() - start).count() / rounds;
+        load.allocations += static_cast<double>(allocations() - allocations_before) / rounds;
+
+        loaded += root->path_exists("/org");
+    }
+
+    std::printf("Devices: %zu, connected: %zu, characteristics: %zu, rounds: %zu\n", devices, connected,
+                characteristics, rounds);
+    std::printf("%-10s %12s %14s\n", "phase", "ms", "allocations");
+    report("decode", decode);
+    report("load", load);
+
+    if (loaded != rounds) {
+        std::printf("unexpected tree\n");
+    }
+    return 0;
+}
@@ -0,0 +1,182 @@
+// Counts the signals delivered to a client, and the CPU time it spends receiving and
+// unmarshalling them, while an emulated BlueZ daemon publishes `PropertiesChanged` updates
+// for many nearby devices and notifications for devices connected by other processes.
+//
+// The "catch-all" mode subscribes to every signal of the daemon. The "fine" mode only
+// subscribes to the object tree, the adapter, one connected device and one of its
+// characteristics. The "fine+scan" mode additionally subscribes to the device updates of
+// the adapter, as done while discovering.
+//
+// Requires a session bus, e.g. `dbus-run-session -- ./simpledbus_bench_match_rules`.
+
+#include <simpledbus/base/Connection.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "helpers/Bench.h"
+
+using namespace std::chrono;
+using namespace Bench;
+
+static constexpr const char* ADAPTER_PATH = "/org/bluez/hci0";
+
+enum class RuleMode { CATCH_ALL, FINE, FINE_SCAN };
+
+struct BenchConfig {
+    size_t devices;
+    size_t connected;
+    size_t characteristics;
+    size_t rounds;
+    milliseconds period;
+};
+
+struct BenchResult {
+    uint64_t emitted;
+    uint64_t delivered;
+    double cpu_ms;
+};
+
+static std::string characteristic_path(size_t device, size_t index) {
+    return device_path(device) + "/service0001/char" + std::to_string(index);
+}
+
+static std::string properties_rule(const std::string& sender, const std::string& path_key, const std::string& path,
+                                   const std::string& interface) {
+    std::string rule = "type='signal',sender='" + sender +
+                       "',interface='org.freedesktop.DBus.Properties',member='PropertiesChanged'," + path_key + "='" +
+                       path + "'";
+    if (!interface.empty()) {
+        rule += ",arg0='" + interface + "'";
+    }
+    return rule;
+}
+
+static std::vector<std::string> rules_for(RuleMode mode, const std::string& sender) {
+    if (mode == RuleMode::CATCH_ALL) {
+        return {"type='signal',sender='" + sender + "'"};
+    }
+
+    std::vector<std::string> rules = {
+        "type='signal',sender='" + sender + "',path='/',interface='org.freedesktop.DBus.ObjectManager'",
+        properties_rule(sender, "path_namespace", "/org/bluez", "org.bluez.Adapter1"),
+        properties_rule(sender, "path", device_path(0), ""),
+        properties_rule(sender, "path", characteristic_path(0, 0), "org.bluez.GattCharacteristic1"),
+    };
+    if (mode == RuleMode::FINE_SCAN) {
+        rules.push_back(properties_rule(sender, "path_namespace", ADAPTER_PATH, "org.bluez.Device1"));
+    }
+    return rules;
+}
+
+static SimpleDBus::Message properties_changed(const std::string& path, const std::string& interface,
+                                              const std::string& property, SimpleDBus::Holder value) {
+    SimpleDBus::Holder changed = SimpleDBus::Holder::create_dict();
+    changed.dict_append(SimpleDBus::Holder::Type::STRING, property, value);
+
+    auto signal = SimpleDBus::Message::create_signal(path, "org.freedesktop.DBus.Properties", "PropertiesChanged");
+    signal.append_argument(SimpleDBus::Holder::create_string(interface), "s");
+    signal.append_argument(changed, "a{sv}");
+    signal.append_argument(SimpleDBus::Holder::create_array(), "as");
+    return signal;
+}
+
+static BenchResult run_mode(RuleMode mode, const BenchConfig& config) {
+    SimpleDBus::Connection daemon(DBUS_BUS_SESSION);
+    SimpleDBus::Connection client(DBUS_BUS_SESSION);
+    daemon.init();
+    client.init();
+
+    std::vector<std::string> rules = rules_for(mode, daemon.unique_name());
+    for (auto& rule : rules) {
+        client.add_match(rule);
+    }
+
+    std::atomic_bool active = true;
+    std::atomic<uint64_t> delivered = 0;
+    std::atomic<double> cpu_seconds = 0;
+
+    std::thread loop([&]() {
+        double cpu_start = thread_cpu_seconds();
+        while (active) {
+            client.read_write();
+            for (auto msg = client.pop_message(); msg.is_valid(); msg = client.pop_message()) {
+                msg.extract();
+                delivered++;
+            }
+            client.process_events(100);
+        }
+        cpu_seconds = thread_cpu_seconds() - cpu_start;
+    });
+
+    uint64_t emitted = 0;
+    for (size_t round = 0; round < config.rounds; round++) {
+        for (size_t i = 0; i < config.devices; i++) {
+            auto signal = properties_changed(device_path(i), "org.bluez.Device1", "RSSI",
+                                             SimpleDBus::Holder::create_int16(-40 - static_cast<int16_t>(round % 50)));
+            daemon.send(signal);
+            emitted++;
+        }
+
+        for (size_t i = 0; i < config.connected; i++) {
+            for (size_t j = 0; j < config.characteristics; j++) {
+                SimpleDBus::Holder value = SimpleDBus::Holder::create_array();
+                for (size_t k = 0; k < 20; k++) {
+                    value.array_append(SimpleDBus::Holder::create_byte(static_cast<uint8_t>(round + k)));
+                }
+                auto signal = properties_changed(characteristic_path(i, j), "org.bluez.GattCharacteristic1", "Value",
+                                                 value);
+                daemon.send(signal);
+                emitted++;
+            }
+        }
+
+        std::this_thread::sleep_for(config.period);
+    }
+
+    // Give the client time to drain whatever is still in flight.
+    std::this_thread::sleep_for(milliseconds(300));
+    active = false;
+    client.wakeup();
+    loop.join();
+
+    for (auto& rule : rules) {
+        client.remove_match(rule);
+    }
+    client.uninit();
+    daemon.uninit();
+
+    return {emitted, delivered, cpu_seconds * 1000.0};
+}
+
+static void report(const char* name, const BenchResult& result) {
+    std::printf("%-10s %10llu %10llu %9.1f%% %10.1f\n", name, static_cast<unsigned long long>(result.emitted),
+                static_cast<unsigned long long>(result.delivered), 100.0 * result.delivered / result.emitted,
+                result.cpu_ms);
+    std::fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+    BenchConfig config;
+    config.devices = argc > 1 ? std::atoi(argv[1]) : 300;
+    config.connected = argc > 2 ? std::atoi(argv[2]) : 8;
+    config.characteristics = argc > 3 ? std::atoi(argv[3]) : 4;
+    config.rounds = argc > 4 ? std::atoi(argv[4]) : 50;
+    config.period = milliseconds(20);
+
+    std::printf("Devices: %zu, connected by anyone: %zu x %zu characteristics, rounds: %zu\n", config.devices,
+                config.connected, config.characteristics, config.rounds);
+    std::printf("%-10s %10s %10s %10s %10s\n", "mode", "emitted", "delivered", "ratio", "cpu ms");
+    std::fflush(stdout);
+
+    report("catch-all", run_mode(RuleMode::CATCH_ALL, config));
+    report("fine", run_mode(RuleMode::FINE, config));
+    report("fine+scan", run_mode(RuleMode::FINE_SCAN, config));
+
+    return 0;
+}
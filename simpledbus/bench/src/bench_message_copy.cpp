@@ -0,0 +1,80 @@
+// Copies a `WriteValue` call carrying a 512-byte payload, as a deep copy of the underlying
+// message (which is how `Message` used to be copied) against a `Message` copy sharing it, and
+// builds the same call with and without retaining the appended holders. Reports the time per
+// copy or build and the heap held by 1000 of them.
+//
+// Does not require a bus.
+
+#include <simpledbus/base/Message.h>
+
+#include <malloc.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace std::chrono;
+
+static constexpr size_t KEPT = 1000;
+
+struct BenchResult {
+    double ns;
+    double heap_kb;
+};
+
+static SimpleDBus::Message write_value(const std::vector<uint8_t>& bytes) {
+    auto msg = SimpleDBus::Message::create_method_call("org.bluez", "/org/bluez/hci0/dev_0/service0010/char0011",
+                                                       "org.bluez.GattCharacteristic1", "WriteValue");
+    msg.append_argument(SimpleDBus::Holder::create_byte_array(bytes), "ay");
+    msg.append_argument(SimpleDBus::Holder::create_dict(), "a{sv}");
+    return msg;
+}
+
+template <typename T, typename F>
+static BenchResult run(size_t iterations, F&& make) {
+    std::vector<T> kept;
+    kept.reserve(KEPT);
+
+    size_t heap_before = mallinfo2().uordblks;
+    for (size_t i = 0; i < KEPT; i++) {
+        kept.push_back(make());
+    }
+    size_t heap_after = mallinfo2().uordblks;
+
+    auto start = steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        T value = make();
+    }
+    double ns = duration<double, std::nano>(steady_clock::now() - start).count() / iterations;
+    return {ns, (static_cast<double>(heap_after) - heap_before) / 1024.0};
+}
+
+static void report(const char* operation, const BenchResult& result) {
+    std::printf("%-24s %12.1f %12.1f\n", operation, result.ns, result.heap_kb);
+    std::fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+    size_t iterations = argc > 1 ? std::atoi(argv[1]) : 50000;
+    std::vector<uint8_t> bytes(512, 0x42);
+    SimpleDBus::Message original = write_value(bytes);
+
+    std::printf("Iterations: %zu, payload: %zu bytes\n", iterations, bytes.size());
+    std::printf("%-24s %12s %12s\n", "operation", "ns", "heap KB/1000");
+    std::fflush(stdout);
+
+    report("deep copy", run<SimpleDBus::Message>(iterations, [&]() {
+               return SimpleDBus::Message::from_acquired(dbus_message_copy(original));
+           }));
+    report("shared copy", run<SimpleDBus::Message>(iterations, [&]() { return original; }));
+
+    // Building a call used to also retain a copy of every appended holder.
+    report("build", run<SimpleDBus::Message>(iterations, [&]() { return write_value(bytes); }));
+    report("build and retain", run<std::pair<SimpleDBus::Message, std::vector<SimpleDBus::Holder>>>(iterations, [&]() {
+               std::vector<SimpleDBus::Holder> retained = {SimpleDBus::Holder::create_byte_array(bytes),
+                                                           SimpleDBus::Holder::create_dict()};
+               return std::make_pair(write_value(bytes), std::move(retained));
+           }));
+
+    return 0;
+}
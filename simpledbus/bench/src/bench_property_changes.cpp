@@ -0,0 +1,107 @@
+// Feeds a device proxy the `PropertiesChanged` signals BlueZ emits while scanning: every
+// advertisement reports the RSSI and the manufacturer data, which seldom change. The device
+// interface parses the manufacturer data whenever it is reported, as SimpleBluez does. Reports
+// the time spent per signal, and how many property changes and signals reach the callbacks.
+//
+// Does not require a bus.
+
+#include <simpledbus/advanced/Interface.h>
+#include <simpledbus/advanced/InterfaceRegistry.h>
+#include <simpledbus/advanced/Proxy.h>
+#include <simpledbus/base/Connection.h>
+#include <simpledbus/base/Message.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+
+static size_t properties_changed = 0;
+
+class BenchDevice : public SimpleDBus::Interface {
+  public:
+    BenchDevice(std::shared_ptr<SimpleDBus::Connection> conn, std::shared_ptr<SimpleDBus::Proxy> proxy)
+        : SimpleDBus::Interface(conn, proxy, "org.bluez.Device1") {}
+
+    std::map<uint16_t, std::vector<uint8_t>> manufacturer_data;
+
+  protected:
+    void property_changed(std::string option_name) override {
+        properties_changed++;
+        if (option_name == "ManufacturerData") {
+            std::scoped_lock lock(_property_update_mutex);
+            manufacturer_data.clear();
+            for (const auto& [key, value] : property_view("ManufacturerData").dict_view<uint16_t>()) {
+                manufacturer_data[key.get_uint16()] = value.get_byte_array();
+            }
+        }
+    }
+
+    static const SimpleDBus::AutoRegisterInterface<BenchDevice> registry;
+};
+
+const SimpleDBus::AutoRegisterInterface<BenchDevice> BenchDevice::registry{
+    "org.bluez.Device1",
+    [](std::shared_ptr<SimpleDBus::Connection> conn,
+       std::shared_ptr<SimpleDBus::Proxy> proxy) -> std::shared_ptr<SimpleDBus::Interface> {
+        return std::make_shared<BenchDevice>(conn, proxy);
+    }};
+
+static SimpleDBus::Message advertisement(int16_t rssi, uint8_t payload) {
+    using SimpleDBus::Holder;
+
+    Holder manufacturer_data = Holder::create_dict();
+    manufacturer_data.dict_append(Holder::UINT16, static_cast<uint16_t>(0x004C),
+                                  Holder::create_byte_array(std::vector<uint8_t>(24, payload)));
+    std::map<std::string, Holder> changed = {{"RSSI", Holder::create_int16(rssi)},
+                                             {"ManufacturerData", manufacturer_data}};
+
+    auto msg = SimpleDBus::Message::create_signal("/org/bluez/hci0/dev_00_11_22_33_44_55",
+                                                  "org.freedesktop.DBus.Properties", "PropertiesChanged");
+    msg.append(std::string("org.bluez.Device1"), changed, std::vector<std::string>());
+    return msg;
+}
+
+int main(int argc, char** argv) {
+    size_t signals = argc > 1 ? std::atoi(argv[1]) : 100000;
+    size_t rssi_period = argc > 2 ? std::atoi(argv[2]) : 4;
+    size_t payload_period = argc > 3 ? std::atoi(argv[3]) : 50;
+
+    // Signals are prepared beforehand, so that only their handling is measured.
+    std::vector<SimpleDBus::Message> stream;
+    stream.reserve(signals);
+    for (size_t i = 0; i < signals; i++) {
+        stream.push_back(advertisement(-60 - static_cast<int16_t>((i / rssi_period) % 2),
+                                       static_cast<uint8_t>((i / payload_period) % 2)));
+    }
+
+    auto conn = std::make_shared<SimpleDBus::Connection>(DBUS_BUS_SESSION);
+    auto proxy = std::make_shared<SimpleDBus::Proxy>(conn, "org.bluez", "/org/bluez/hci0/dev_00_11_22_33_44_55");
+    SimpleDBus::Holder interfaces = SimpleDBus::Holder::create_dict();
+    interfaces.dict_append(SimpleDBus::Holder::STRING, "org.bluez.Device1", SimpleDBus::Holder::create_dict());
+    interfaces.dict_append(SimpleDBus::Holder::STRING, "org.freedesktop.DBus.Properties",
+                           SimpleDBus::Holder::create_dict());
+    proxy->interfaces_load(std::move(interfaces));
+
+    size_t signals_received = 0;
+    proxy->on_signal_received.load([&]() { signals_received++; });
+    properties_changed = 0;
+
+    auto start = steady_clock::now();
+    for (auto& msg : stream) {
+        proxy->message_handle(msg);
+    }
+    double ns = duration<double, std::nano>(steady_clock::now() - start).count() / signals;
+
+    std::printf("Signals: %zu, RSSI changes every %zu, payload changes every %zu\n", signals, rssi_period,
+                payload_period);
+    std::printf("%-24s %12.1f\n", "ns per signal", ns);
+    std::printf("%-24s %12zu\n", "property changes", properties_changed);
+    std::printf("%-24s %12zu\n", "signals received", signals_received);
+    return 0;
+}
@@ -0,0 +1,214 @@
+// Records a client session against an emulated daemon that answers `ReadValue` calls and
+// publishes `PropertiesChanged` updates for many devices, then replays the recording into
+// fresh clients running the same script without a bus. Reports the duration of the live
+// session and of every replay, along with the messages delivered and handled, which should
+// be identical across replays.
+//
+// With a recording as argument, replays it instead into a client handling every signal
+// path found in the recording, without making any call.
+//
+// Requires a session bus to record, e.g. `dbus-run-session -- ./simpledbus_bench_replay`.
+
+#include <simpledbus/advanced/Replayer.h>
+#include <simpledbus/base/Connection.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "helpers/Bench.h"
+
+using namespace std::chrono;
+using namespace Bench;
+
+static constexpr const char* BENCH_INTERFACE = "org.simpledbus.Bench";
+static constexpr const char* RECORDING = "simpledbus_bench_replay.rec";
+
+struct BenchConfig {
+    size_t devices;
+    size_t rounds;
+    size_t iterations;
+};
+
+struct SessionResult {
+    double ms;
+    uint64_t handled;
+    size_t delivered;
+    size_t skipped;
+};
+
+static SimpleDBus::Message properties_changed(const std::string& path, int16_t rssi) {
+    SimpleDBus::Holder changed = SimpleDBus::Holder::create_dict();
+    changed.dict_append(SimpleDBus::Holder::Type::STRING, "RSSI", SimpleDBus::Holder::create_int16(rssi));
+
+    auto signal = SimpleDBus::Message::create_signal(path, "org.freedesktop.DBus.Properties", "PropertiesChanged");
+    signal.append_argument(SimpleDBus::Holder::create_string("org.bluez.Device1"), "s");
+    signal.append_argument(changed, "a{sv}");
+    signal.append_argument(SimpleDBus::Holder::create_array(), "as");
+    return signal;
+}
+
+// The client script, run identically while recording and while replaying.
+static uint64_t run_client(SimpleDBus::Connection& client, const std::string& server_name, const BenchConfig& config,
+                           std::atomic<uint64_t>& handled) {
+    for (size_t round = 0; round < config.rounds; round++) {
+        for (size_t i = 0; i < config.devices; i += 16) {
+            auto call = SimpleDBus::Message::create_method_call(server_name, device_path(i), BENCH_INTERFACE,
+                                                                "ReadValue");
+            auto reply = client.send_with_reply_and_block(call);
+            reply.extract();
+            handled++;
+        }
+    }
+    return handled;
+}
+
+static void register_handlers(SimpleDBus::Connection& client, const std::vector<std::string>& paths,
+                              std::atomic<uint64_t>& handled) {
+    for (auto& path : paths) {
+        client.register_signal_handler(path, [&handled](SimpleDBus::Message& msg) {
+            msg.extract();
+            handled++;
+        });
+    }
+}
+
+static SessionResult record(const BenchConfig& config) {
+    SimpleDBus::Connection daemon(DBUS_BUS_SESSION);
+    SimpleDBus::Connection client(DBUS_BUS_SESSION);
+    daemon.init();
+    client.init();
+
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < config.devices; i++) {
+        paths.push_back(device_path(i));
+        daemon.register_object_path(device_path(i), [&daemon](SimpleDBus::Message& msg) {
+            auto reply = SimpleDBus::Message::create_method_return(msg);
+            reply.append_argument(SimpleDBus::Holder::create_uint64(42), "t");
+            daemon.send(reply);
+        });
+    }
+
+    std::atomic<uint64_t> handled = 0;
+    client.add_match("type='signal',sender='" + daemon.unique_name() + "'");
+    register_handlers(client, paths, handled);
+    client.start_recording(RECORDING);
+
+    auto start = steady_clock::now();
+    uint64_t total = 0;
+    {
+        DispatchLoop daemon_loop(daemon, 10);
+        DispatchLoop client_loop(client, 10);
+
+        std::thread emitter([&]() {
+            for (size_t round = 0; round < config.rounds; round++) {
+                for (size_t i = 0; i < config.devices; i++) {
+                    auto signal = properties_changed(device_path(i), -40 - static_cast<int16_t>(round % 50));
+                    daemon.send(signal);
+                }
+                std::this_thread::sleep_for(milliseconds(5));
+            }
+        });
+
+        run_client(client, daemon.unique_name(), config, handled);
+        emitter.join();
+
+        // Give the client time to receive whatever is still in flight.
+        std::this_thread::sleep_for(milliseconds(300));
+        total = handled;
+    }
+    double ms = duration<double, std::milli>(steady_clock::now() - start).count();
+
+    client.stop_recording();
+    for (auto& path : paths) {
+        client.unregister_signal_handler(path);
+        daemon.unregister_object_path(path);
+    }
+    client.uninit();
+    daemon.uninit();
+    return {ms, total, 0, 0};
+}
+
+static SessionResult replay(const std::string& filename, const std::vector<std::string>& paths,
+                            const BenchConfig* script) {
+    SimpleDBus::Replayer replayer(filename);
+    if (script == nullptr) {
+        replayer.call_timeout = milliseconds(0);
+    }
+
+    SimpleDBus::Connection client(replayer.address());
+    std::atomic<uint64_t> handled = 0;
+
+    auto start = steady_clock::now();
+    replayer.start();
+    client.init();
+    register_handlers(client, paths, handled);
+    {
+        DispatchLoop client_loop(client, 10);
+        if (script != nullptr) {
+            run_client(client, "org.simpledbus.Bench", *script, handled);
+        }
+        replayer.wait();
+
+        // Wait for the dispatch loop to handle everything that was delivered.
+        uint64_t last = 0;
+        do {
+            last = handled;
+            std::this_thread::sleep_for(milliseconds(20));
+        } while (handled != last);
+    }
+    double ms = duration<double, std::milli>(steady_clock::now() - start).count();
+
+    for (auto& path : paths) {
+        client.unregister_signal_handler(path);
+    }
+    client.uninit();
+    return {ms, handled, replayer.delivered(), replayer.skipped()};
+}
+
+static std::vector<std::string> signal_paths(const std::string& filename) {
+    std::set<std::string> paths;
+    SimpleDBus::RecordingReader reader(filename);
+    SimpleDBus::RecordedMessage record;
+    while (reader.next(record)) {
+        if (record.message.get_type() == SimpleDBus::Message::Type::SIGNAL) {
+            paths.insert(record.message.get_path());
+        }
+    }
+    return std::vector<std::string>(paths.begin(), paths.end());
+}
+
+static void report(const char* name, const SessionResult& result) {
+    std::printf("%-10s %10.1f %10llu %10zu %10zu\n", name, result.ms, static_cast<unsigned long long>(result.handled),
+                result.delivered, result.skipped);
+    std::fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+    BenchConfig config;
+    config.devices = 300;
+    config.rounds = 50;
+    config.iterations = 5;
+
+    std::string filename = argc > 1 ? argv[1] : RECORDING;
+    bool scripted = argc <= 1;
+
+    std::printf("%-10s %10s %10s %10s %10s\n", "session", "ms", "handled", "delivered", "skipped");
+    std::fflush(stdout);
+
+    if (scripted) {
+        report("live", record(config));
+    }
+
+    std::vector<std::string> paths = signal_paths(filename);
+    for (size_t i = 0; i < config.iterations; i++) {
+        report("replay", replay(filename, paths, scripted ? &config : nullptr));
+    }
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+// Compares routing incoming signals to many objects by exporting every object on the
+// connection (`register_object_path`) against routing them through the single signal filter
+// of the connection (`register_signal_handler`). Reports the heap retained by the routes and
+// the CPU time spent dispatching a backlog of signals addressed to them.
+//
+// Requires a session bus, e.g. `dbus-run-session -- ./simpledbus_bench_signal_routing`.
+
+#include <simpledbus/base/Connection.h>
+
+#include <malloc.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "helpers/Bench.h"
+
+using namespace std::chrono;
+using namespace Bench;
+
+static constexpr const char* BENCH_INTERFACE = "org.simpledbus.Bench";
+
+enum class RouteMode { OBJECT_PATH, SIGNAL_FILTER };
+
+struct BenchConfig {
+    size_t devices;
+    size_t characteristics;
+    size_t signals;
+};
+
+struct BenchResult {
+    double route_kb;
+    double dispatch_ms;
+    uint64_t delivered;
+};
+
+static std::vector<std::string> object_paths(const BenchConfig& config) {
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < config.devices; i++) {
+        std::string device = device_path(i);
+        paths.push_back(device);
+        for (size_t j = 0; j < config.characteristics; j++) {
+            paths.push_back(device + "/service0001/char" + std::to_string(j));
+        }
+    }
+    return paths;
+}
+
+static BenchResult run_mode(RouteMode mode, const BenchConfig& config) {
+    SimpleDBus::Connection receiver(DBUS_BUS_SESSION);
+    SimpleDBus::Connection emitter(DBUS_BUS_SESSION);
+    receiver.init();
+    emitter.init();
+    receiver.add_match(std::string("type='signal',interface='") + BENCH_INTERFACE + "'");
+
+    std::vector<std::string> paths = object_paths(config);
+    std::atomic<uint64_t> delivered = 0;
+    auto handler = [&](SimpleDBus::Message&) { delivered++; };
+
+    size_t heap_before = mallinfo2().uordblks;
+    for (auto& path : paths) {
+        if (mode == RouteMode::OBJECT_PATH) {
+            receiver.register_object_path(path, handler);
+        } else {
+            receiver.register_signal_handler(path, handler);
+        }
+    }
+    size_t heap_after = mallinfo2().uordblks;
+
+    // Queue the whole backlog on the bus before dispatching, so that only routing is measured.
+    for (size_t i = 0; i < config.signals; i++) {
+        auto signal = SimpleDBus::Message::create_signal(paths[i % paths.size()], BENCH_INTERFACE, "Notify");
+        signal.append_argument(SimpleDBus::Holder::create_uint64(i), "t");
+        emitter.send(signal);
+    }
+    std::this_thread::sleep_for(milliseconds(500));
+
+    double cpu_start = thread_cpu_seconds();
+    auto deadline = steady_clock::now() + seconds(10);
+    while (delivered < config.signals && steady_clock::now() < deadline) {
+        receiver.read_write_dispatch();
+        receiver.process_events(10);
+    }
+    double cpu_seconds = thread_cpu_seconds() - cpu_start;
+
+    for (auto& path : paths) {
+        if (mode == RouteMode::OBJECT_PATH) {
+            receiver.unregister_object_path(path);
+        } else {
+            receiver.unregister_signal_handler(path);
+        }
+    }
+    receiver.uninit();
+    emitter.uninit();
+
+    return {(static_cast<double>(heap_after) - heap_before) / 1024.0, cpu_seconds * 1000.0, delivered};
+}
+
+static void report(const char* name, const BenchResult& result, const BenchConfig& config) {
+    std::printf("%-14s %10.1f %10llu %12.1f %12.2f\n", name, result.route_kb,
+                static_cast<unsigned long long>(result.delivered), result.dispatch_ms,
+                result.dispatch_ms * 1000.0 / config.signals);
+    std::fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+    BenchConfig config;
+    config.devices = argc > 1 ? std::atoi(argv[1]) : 200;
+    config.characteristics = argc > 2 ? std::atoi(argv[2]) : 8;
+    config.signals = argc > 3 ? std::atoi(argv[3]) : 20000;
+
+    std::printf("Devices: %zu x %zu characteristics, signals: %zu\n", config.devices, config.characteristics,
+                config.signals);
+    std::printf("%-14s %10s %10s %12s %12s\n", "mode", "routes KB", "delivered", "dispatch ms", "us/signal");
+    std::fflush(stdout);
+
+    report("object-path", run_mode(RouteMode::OBJECT_PATH, config), config);
+    report("signal-filter", run_mode(RouteMode::SIGNAL_FILTER, config), config);
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+// Compares the dynamically typed path, through Holders and runtime signatures, against the
+// typed `Message::append` and `Message::read` on the hottest SimpleBluez messages: building a
+// 244-byte `WriteValue` call, reading a 244-byte `ReadValue` reply and reading a
+// `PropertiesChanged` notification of a characteristic value. Reports the time and the heap
+// allocations per message.
+//
+// Does not require a bus.
+
+#include <simpledbus/base/Message.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "helpers/Bench.h"
+
+using namespace Bench;
+
+static constexpr const char* CHARACTERISTIC_PATH = "/org/bluez/hci0/dev_00_11_22_33_44_55/service0010/char0011";
+
+static SimpleDBus::Message value_reply(const std::vector<uint8_t>& bytes) {
+    auto msg = SimpleDBus::Message::create_signal(CHARACTERISTIC_PATH, "org.bluez.GattCharacteristic1", "Reply");
+    msg.append(bytes);
+    return msg;
+}
+
+static SimpleDBus::Message value_changed(const std::vector<uint8_t>& bytes) {
+    auto msg = SimpleDBus::Message::create_signal(CHARACTERISTIC_PATH, "org.freedesktop.DBus.Properties",
+                                                  "PropertiesChanged");
+    std::map<std::string, SimpleDBus::Holder> changed = {{"Value", SimpleDBus::Holder::create_byte_array(bytes)}};
+    msg.append(std::string("org.bluez.GattCharacteristic1"), changed, std::vector<std::string>());
+    return msg;
+}
+
+static void report(const char* message, const char* path, const Measurement& result) {
+    std::printf("%-18s %-8s %12.1f %14.1f\n", message, path, result.ns, result.allocations);
+    std::fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+    size_t iterations = argc > 1 ? std::atoi(argv[1]) : 50000;
+    std::vector<uint8_t> bytes(244, 0x42);
+    size_t checksum = 0;
+
+    std::printf("Iterations: %zu, payload: %zu bytes\n", iterations, bytes.size());
+    std::printf("%-18s %-8s %12s %14s\n", "message", "path", "ns", "allocations");
+    std::fflush(stdout);
+
+    report("WriteValue", "holder", measure(iterations, [&]() {
+               auto msg = SimpleDBus::Message::create_signal(CHARACTERISTIC_PATH, "org.bluez.GattCharacteristic1",
+                                                             "WriteValue");
+               SimpleDBus::Holder options = SimpleDBus::Holder::create_dict();
+               options.dict_append(SimpleDBus::Holder::STRING, "type", SimpleDBus::Holder::create_string("request"));
+               msg.append_argument(SimpleDBus::Holder::create_byte_array(bytes.data(), bytes.size()), "ay");
+               msg.append_argument(options, "a{sv}");
+               checksum += msg.is_valid();
+           }));
+    report("WriteValue", "typed", measure(iterations, [&]() {
+               auto msg = SimpleDBus::Message::create_signal(CHARACTERISTIC_PATH, "org.bluez.GattCharacteristic1",
+                                                             "WriteValue");
+               std::map<std::string, SimpleDBus::Holder> options;
+               options.emplace("type", SimpleDBus::Holder::create_string("request"));
+               msg.append(SimpleDBus::Marshal::ByteView(bytes.data(), bytes.size()), options);
+               checksum += msg.is_valid();
+           }));
+
+    SimpleDBus::Message reply = value_reply(bytes);
+    report("ReadValue", "holder", measure(iterations, [&]() {
+               SimpleDBus::Message msg = reply;
+               std::vector<uint8_t> value = msg.extract().get_byte_array();
+               checksum += value.size();
+           }));
+    report("ReadValue", "typed", measure(iterations, [&]() {
+               SimpleDBus::Message msg = reply;
+               auto [value] = msg.read<SimpleDBus::Marshal::ByteView>();
+               checksum += std::vector<uint8_t>(value.data, value.data + value.size).size();
+           }));
+
+    SimpleDBus::Message changed = value_changed(bytes);
+    report("PropertiesChanged", "holder", measure(iterations, [&]() {
+               SimpleDBus::Message msg = changed;
+               std::string interface = msg.extract().get_string();
+               msg.extract_next();
+               SimpleDBus::Holder properties = msg.extract();
+               msg.extract_next();
+               SimpleDBus::Holder invalidated = msg.extract();
+               checksum += properties.dict_find("Value")->byte_array().size();
+           }));
+    report("PropertiesChanged", "typed", measure(iterations, [&]() {
+               SimpleDBus::Message msg = changed;
+               auto [interface, properties, invalidated] =
+                   msg.read<std::string, std::vector<std::pair<std::string, SimpleDBus::Holder>>,
+                            std::vector<std::string>>();
+               checksum += properties[0].second.byte_array().size();
+           }));
+
+    if (checksum == 0) {
+        std::printf("unexpected checksum\n");
+    }
+    return 0;
+}
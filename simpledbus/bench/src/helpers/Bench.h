@@ -0,0 +1,88 @@
+#pragma once
+
+#include <simpledbus/base/Connection.h>
+
+#include <sys/resource.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Measurement scaffolding shared by the standalone benchmarks.
+namespace Bench {
+
+inline uint64_t now_ns() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+// CPU time spent by the calling thread, in user and kernel mode.
+inline double thread_cpu_seconds() {
+    rusage usage;
+    getrusage(RUSAGE_THREAD, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+}
+
+inline double percentile(std::vector<double> values, double pct) {
+    if (values.empty()) return 0;
+    std::sort(values.begin(), values.end());
+    size_t index = std::min(values.size() - 1, static_cast<size_t>(pct / 100.0 * values.size()));
+    return values[index];
+}
+
+inline std::string adapter_path(size_t adapter = 0) { return "/org/bluez/hci" + std::to_string(adapter); }
+
+inline std::string device_path(size_t device, size_t adapter = 0) {
+    return adapter_path(adapter) + "/dev_" + std::to_string(device);
+}
+
+// Heap allocations made by the process so far. Only counted by the benchmarks built along with
+// `Allocations.cpp`, which replaces the global allocation functions.
+uint64_t allocations();
+
+// Mean time and heap allocations of a call.
+struct Measurement {
+    double ns;
+    double allocations;
+};
+
+template <typename F>
+Measurement measure(size_t iterations, F&& f) {
+    using namespace std::chrono;
+    uint64_t allocations_before = allocations();
+    auto start = steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        f();
+    }
+    double ns = duration<double, std::nano>(steady_clock::now() - start).count() / iterations;
+    return {ns, static_cast<double>(allocations() - allocations_before) / iterations};
+}
+
+// Runs the dispatch loop of `conn` until destroyed.
+class DispatchLoop {
+  public:
+    explicit DispatchLoop(SimpleDBus::Connection& conn, int timeout_ms = 100) : _conn(conn) {
+        _thread = std::thread([this, timeout_ms]() {
+            while (_active) {
+                _conn.read_write_dispatch();
+                _conn.process_events(timeout_ms);
+            }
+        });
+    }
+
+    ~DispatchLoop() {
+        _active = false;
+        _conn.wakeup();
+        _thread.join();
+    }
+
+  private:
+    SimpleDBus::Connection& _conn;
+    std::atomic_bool _active = true;
+    std::thread _thread;
+};
+
+}  // namespace Bench
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <simpledbus/advanced/Interface.h>
+#include <simpledbus/advanced/InterfaceRegistry.h>
+#include <simpledbus/advanced/Proxy.h>
+#include <simpledbus/base/Connection.h>
+#include <simpledbus/base/Holder.h>
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Objects shaped like the ones BlueZ lists in its `GetManagedObjects` reply, shared by the
+// benchmarks loading them into proxies.
+namespace Bench {
+
+// Stands in for the SimpleBluez interfaces, which only differ in how they read their properties.
+template <const char* Name>
+class BenchInterface : public SimpleDBus::Interface {
+  public:
+    BenchInterface(std::shared_ptr<SimpleDBus::Connection> conn, std::shared_ptr<SimpleDBus::Proxy> proxy)
+        : SimpleDBus::Interface(conn, proxy, Name) {}
+
+    static const SimpleDBus::AutoRegisterInterface<BenchInterface> registry;
+};
+
+template <const char* Name>
+const SimpleDBus::AutoRegisterInterface<BenchInterface<Name>> BenchInterface<Name>::registry{
+    Name,
+    [](std::shared_ptr<SimpleDBus::Connection> conn,
+       std::shared_ptr<SimpleDBus::Proxy> proxy) -> std::shared_ptr<SimpleDBus::Interface> {
+        return std::make_shared<BenchInterface<Name>>(conn, proxy);
+    }};
+
+inline constexpr char ADAPTER[] = "org.bluez.Adapter1";
+inline constexpr char DEVICE[] = "org.bluez.Device1";
+inline constexpr char SERVICE[] = "org.bluez.GattService1";
+inline constexpr char CHARACTERISTIC[] = "org.bluez.GattCharacteristic1";
+template class BenchInterface<ADAPTER>;
+template class BenchInterface<DEVICE>;
+template class BenchInterface<SERVICE>;
+template class BenchInterface<CHARACTERISTIC>;
+
+inline SimpleDBus::Holder interfaces(const char* name, SimpleDBus::Holder properties) {
+    using SimpleDBus::Holder;
+
+    Holder result = Holder::create_dict();
+    result.dict_append(Holder::STRING, "org.freedesktop.DBus.Introspectable", Holder::create_dict());
+    result.dict_append(Holder::STRING, name, std::move(properties));
+    result.dict_append(Holder::STRING, "org.freedesktop.DBus.Properties", Holder::create_dict());
+    return result;
+}
+
+inline SimpleDBus::Holder adapter_properties() {
+    using SimpleDBus::Holder;
+
+    Holder properties = Holder::create_dict();
+    properties.dict_append(Holder::STRING, "Address", Holder::create_string("00:11:22:33:44:55"));
+    properties.dict_append(Holder::STRING, "Powered", Holder::create_boolean(true));
+    properties.dict_append(Holder::STRING, "Discovering", Holder::create_boolean(false));
+    return interfaces(ADAPTER, std::move(properties));
+}
+
+inline SimpleDBus::Holder device_properties(size_t index, bool connected = false) {
+    using SimpleDBus::Holder;
+
+    char address[18];
+    std::snprintf(address, sizeof(address), "00:11:22:%02X:%02X:%02X", static_cast<unsigned>((index >> 16) & 0xFF),
+                  static_cast<unsigned>((index >> 8) & 0xFF), static_cast<unsigned>(index & 0xFF));
+
+    Holder uuids = Holder::create_array();
+    uuids.array_append(Holder::create_string("0000180f-0000-1000-8000-00805f9b34fb"));
+    uuids.array_append(Holder::create_string("0000180a-0000-1000-8000-00805f9b34fb"));
+
+    Holder manufacturer_data = Holder::create_dict();
+    manufacturer_data.dict_append(Holder::UINT16, static_cast<uint16_t>(0x004C),
+                                  Holder::create_byte_array(std::vector<uint8_t>(16, 0x42)));
+
+    Holder properties = Holder::create_dict();
+    properties.dict_append(Holder::STRING, "Address", Holder::create_string(address));
+    properties.dict_append(Holder::STRING, "AddressType", Holder::create_string("random"));
+    properties.dict_append(Holder::STRING, "Name", Holder::create_string("Device " + std::to_string(index)));
+    properties.dict_append(Holder::STRING, "Alias", Holder::create_string("Device " + std::to_string(index)));
+    properties.dict_append(Holder::STRING, "Adapter", Holder::create_object_path("/org/bluez/hci0"));
+    properties.dict_append(Holder::STRING, "Paired", Holder::create_boolean(false));
+    properties.dict_append(Holder::STRING, "Bonded", Holder::create_boolean(false));
+    properties.dict_append(Holder::STRING, "Trusted", Holder::create_boolean(false));
+    properties.dict_append(Holder::STRING, "Blocked", Holder::create_boolean(false));
+    properties.dict_append(Holder::STRING, "Connected", Holder::create_boolean(connected));
+    properties.dict_append(Holder::STRING, "ServicesResolved", Holder::create_boolean(connected));
+    properties.dict_append(Holder::STRING, "LegacyPairing", Holder::create_boolean(false));
+    properties.dict_append(Holder::STRING, "RSSI", Holder::create_int16(-60 - static_cast<int16_t>(index % 30)));
+    properties.dict_append(Holder::STRING, "TxPower", Holder::create_int16(4));
+    properties.dict_append(Holder::STRING, "UUIDs", uuids);
+    properties.dict_append(Holder::STRING, "ManufacturerData", manufacturer_data);
+    return interfaces(DEVICE, std::move(properties));
+}
+
+inline SimpleDBus::Holder attribute_properties(const std::string& parent, const char* uuid) {
+    using SimpleDBus::Holder;
+
+    Holder flags = Holder::create_array();
+    flags.array_append(Holder::create_string("read"));
+    flags.array_append(Holder::create_string("notify"));
+
+    Holder properties = Holder::create_dict();
+    properties.dict_append(Holder::STRING, "UUID", Holder::create_string(uuid));
+    properties.dict_append(Holder::STRING, "Primary", Holder::create_boolean(true));
+    properties.dict_append(Holder::STRING, "Handle", Holder::create_uint16(0x0010));
+    properties.dict_append(Holder::STRING, "Flags", flags);
+    properties.dict_append(Holder::STRING, "Value", Holder::create_byte_array(std::vector<uint8_t>(20, 0x42)));
+    properties.dict_append(Holder::STRING, parent.find("/char") == std::string::npos ? "Device" : "Service",
+                           Holder::create_object_path(parent));
+    return properties;
+}
+
+// The objects of a service with `characteristics` characteristics, below `device`.
+inline void append_services(SimpleDBus::Holder& objects, const std::string& device, size_t characteristics) {
+    using SimpleDBus::Holder;
+
+    std::string service_path = device + "/service0010";
+    objects.dict_append(Holder::OBJ_PATH, service_path,
+                        interfaces(SERVICE, attribute_properties(device, "0000180f-0000-1000-8000-00805f9b34fb")));
+    for (size_t c = 0; c < characteristics; c++) {
+        objects.dict_append(
+            Holder::OBJ_PATH, service_path + "/char00" + std::to_string(11 + c),
+            interfaces(CHARACTERISTIC, attribute_properties(service_path, "00002a19-0000-1000-8000-00805f9b34fb")));
+    }
+}
+
+}  // namespace Bench
@@ -1,12 +1,18 @@
 #pragma once
 
+#include <simpledbus/advanced/Property.h>
+#include <simpledbus/base/CallTemplate.h>
 #include <simpledbus/base/Connection.h>
 
 #include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace SimpleDBus {
 
@@ -14,9 +20,10 @@ class Proxy;
 
 class Interface {
   public:
-    Interface(std::shared_ptr<Connection> conn, std::shared_ptr<Proxy> proxy, const std::string& interface_name);
+    Interface(std::shared_ptr<Connection> conn, std::shared_ptr<Proxy> proxy, const std::string& interface_name,
+              const PropertyTable& property_table = PropertyTable::none());
 
-    virtual ~Interface() = default;
+    virtual ~Interface();
 
     // ----- LIFE CYCLE -----
     void load(Holder options);
@@ -26,23 +33,33 @@ class Interface {
     // ----- METHODS -----
     Message create_method_call(const std::string& method_name);
 
+    // Template for a method that is called repeatedly, see `CallTemplate`.
+    CallTemplate create_call_template(const std::string& method_name) const;
+
     // ----- PROPERTIES -----
     virtual void property_changed(std::string option_name);
 
+    // Cached properties as an `a{sv}` dictionary, declared ones converted back to holders.
+    Holder property_collect();
+    // Replace the cached value of a property, returning false if it isn't cached.
+    bool property_assign(const std::string& property_name, Holder value);
 
     // ! TODO: We need to figure out a good architecture to let any generic interface access the Properties object of its Proxy.
     void property_refresh(const std::string& property_name);
 
     // ----- SIGNALS -----
     void signal_property_changed(Holder changed_properties, Holder invalidated_properties);
+    void signal_property_changed(std::vector<std::pair<std::string, Holder>> changed_properties,
+                                 const std::vector<std::string>& invalidated_properties);
 
     // ----- MESSAGES -----
     virtual void message_handle(Message& msg);
 
     // ! The following properties are set as public to allow access to the Properties interface.
+    // Properties declared in the property table are stored in `_property_slots` instead.
     std::recursive_mutex _property_update_mutex;
     std::map<std::string, bool> _property_valid_map;
-    std::map<std::string, Holder> _properties;
+    std::map<std::string, Holder, std::less<>> _properties;
 
   protected:
     std::atomic_bool _loaded{true};
@@ -54,6 +71,51 @@ class Interface {
     std::weak_ptr<Proxy> _proxy;
 
     std::shared_ptr<Proxy> proxy() const;
+
+    // Cached value of a declared property, borrowed rather than copied. Must be called with
+    // `_property_update_mutex` held.
+    template <typename T>
+    const T& property(const Property<T>& key) const {
+        return std::get<T>(_property_slots[key.id].value);
+    }
+
+    // Cached value of a property that isn't declared, borrowed rather than copied and without
+    // inserting it when it is missing. Must be called with `_property_update_mutex` held.
+    const Holder& property_view(std::string_view name) const;
+
+    // Called once a declared property has been updated, with the mutex released. Interfaces
+    // dispatch on the id, by default it is reported through `property_changed` by name.
+    virtual void on_property_changed(PropertyId id);
+
+    // Whether updates of a property are events in themselves, such as notified values, which are
+    // reported through `property_changed` even when they carry the value already cached. Only
+    // consulted for properties that aren't declared, see `Property::event` otherwise.
+    virtual bool property_is_event(const std::string& property_name) const;
+
+    // ----- MATCH RULES -----
+    // Rules are held at most once per interface and released when the interface is destroyed.
+    void match_add(const std::string& rule);
+    void match_remove(const std::string& rule);
+    // Rule for the PropertiesChanged signals of this path (or of the whole namespace under it),
+    // optionally restricted to a single interface.
+    std::string match_properties_changed(bool path_namespace = false, const std::string& interface = "") const;
+
+  private:
+    struct PropertySlot {
+        PropertyValue value;
+        bool valid = false;
+    };
+
+    const PropertyTable& _property_table;
+    std::vector<PropertySlot> _property_slots;
+
+    // Store a value received for a declared property, returning whether it should be reported.
+    // Must be called with `_property_update_mutex` held.
+    bool property_store(PropertyId id, Holder&& value);
+    void property_notify(PropertyId id, const std::string& property_name);
+
+    std::mutex _match_mutex;
+    std::set<std::string> _match_rules;
 };
 
 }  // namespace SimpleDBus
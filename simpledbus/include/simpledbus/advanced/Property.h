@@ -0,0 +1,192 @@
+#pragma once
+
+#include <simpledbus/base/Holder.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace SimpleDBus {
+
+// Position of a property in the property table of its interface.
+using PropertyId = size_t;
+
+// Storage of a declared property, holding the C++ type it is read as.
+using PropertyValue = std::variant<bool, uint8_t, int16_t, uint16_t, int32_t, uint32_t, int64_t, uint64_t, double,
+                                   std::string, std::vector<std::string>, Holder>;
+
+/**
+ * @brief Conversion between the holders properties are received as and the C++ type they
+ *        are stored as.
+ *
+ * Specializations provide the Holder `type` values are expected to have, `from` and `to`.
+ * Properties stored as a Holder are kept as received, for those parsed by their interface.
+ */
+template <typename T>
+struct PropertyType;
+
+template <typename T, Holder::Type HolderType, T (Holder::*Getter)() const, Holder (*Create)(T)>
+struct BasicPropertyType {
+    static constexpr Holder::Type type = HolderType;
+    static T from(Holder&& value) { return (value.*Getter)(); }
+    static Holder to(const T& value, Holder::Type) { return Create(value); }
+};
+
+// clang-format off
+template <> struct PropertyType<bool> : BasicPropertyType<bool, Holder::BOOLEAN, &Holder::get_boolean, &Holder::create_boolean> {};
+template <> struct PropertyType<uint8_t> : BasicPropertyType<uint8_t, Holder::BYTE, &Holder::get_byte, &Holder::create_byte> {};
+template <> struct PropertyType<int16_t> : BasicPropertyType<int16_t, Holder::INT16, &Holder::get_int16, &Holder::create_int16> {};
+template <> struct PropertyType<uint16_t> : BasicPropertyType<uint16_t, Holder::UINT16, &Holder::get_uint16, &Holder::create_uint16> {};
+template <> struct PropertyType<int32_t> : BasicPropertyType<int32_t, Holder::INT32, &Holder::get_int32, &Holder::create_int32> {};
+template <> struct PropertyType<uint32_t> : BasicPropertyType<uint32_t, Holder::UINT32, &Holder::get_uint32, &Holder::create_uint32> {};
+template <> struct PropertyType<int64_t> : BasicPropertyType<int64_t, Holder::INT64, &Holder::get_int64, &Holder::create_int64> {};
+template <> struct PropertyType<uint64_t> : BasicPropertyType<uint64_t, Holder::UINT64, &Holder::get_uint64, &Holder::create_uint64> {};
+template <> struct PropertyType<double> : BasicPropertyType<double, Holder::DOUBLE, &Holder::get_double, &Holder::create_double> {};
+// clang-format on
+
+// Strings, object paths and signatures are all stored as std::string.
+template <>
+struct PropertyType<std::string> {
+    static constexpr Holder::Type type = Holder::STRING;
+    static std::string from(Holder&& value) { return value.get_string(); }
+    static Holder to(const std::string& value, Holder::Type type) {
+        if (type == Holder::OBJ_PATH) {
+            return Holder::create_object_path(ObjectPath(value));
+        } else if (type == Holder::SIGNATURE) {
+            return Holder::create_signature(Signature(value));
+        }
+        return Holder::create_string(value);
+    }
+};
+
+template <>
+struct PropertyType<std::vector<std::string>> {
+    static constexpr Holder::Type type = Holder::ARRAY;
+    static std::vector<std::string> from(Holder&& value) {
+        const std::vector<Holder>& array = value.array_view();
+        std::vector<std::string> output;
+        output.reserve(array.size());
+        for (const Holder& element : array) {
+            output.emplace_back(element.get_string_view());
+        }
+        return output;
+    }
+    static Holder to(const std::vector<std::string>& value, Holder::Type) {
+        std::vector<Holder> elements;
+        elements.reserve(value.size());
+        for (const std::string& element : value) {
+            elements.push_back(Holder::create_string(element));
+        }
+        Holder output = Holder::create_array(std::move(elements));
+        output.signature_override("as");
+        return output;
+    }
+};
+
+// Any type of value is accepted.
+template <>
+struct PropertyType<Holder> {
+    static constexpr Holder::Type type = Holder::NONE;
+    static Holder from(Holder&& value) { return std::move(value); }
+    static Holder to(const Holder& value, Holder::Type) { return value; }
+};
+
+/**
+ * @brief Declaration of a property: its position in the property table of its interface,
+ *        its name, the type it is stored as and the type of Holder it is received as.
+ *
+ * Properties marked as `event` are reported whenever they are updated, even when they carry
+ * the value already cached, such as notified values.
+ */
+template <typename T>
+struct Property {
+    using value_type = T;
+
+    PropertyId id;
+    const char* name;
+    bool event = false;
+    Holder::Type type = PropertyType<T>::type;
+};
+
+/**
+ * @brief Properties declared by an interface, indexed by their `PropertyId`.
+ *
+ * Tables are built once per interface class, usually as a function-local static, from the
+ * declarations of its properties given in the order of their ids.
+ */
+class PropertyTable {
+  public:
+    static constexpr PropertyId npos = static_cast<PropertyId>(-1);
+
+    struct Entry {
+        std::string_view name;
+        Holder::Type type;
+        bool event;
+        PropertyValue initial;
+
+        // Replace the value of a slot, returning whether it differs from the previous one.
+        bool (*assign)(PropertyValue& slot, Holder&& value);
+        Holder (*collect)(const PropertyValue& slot, Holder::Type type);
+    };
+
+    PropertyTable() = default;
+
+    template <typename... Ts>
+    explicit PropertyTable(const Property<Ts>&... properties) {
+        (_append(properties), ...);
+        _index_build();
+    }
+
+    // Table of interfaces without declared properties.
+    static const PropertyTable& none();
+
+    size_t size() const { return _entries.size(); }
+    const Entry& operator[](PropertyId id) const { return _entries[id]; }
+
+    // Id of the property with the given name, npos if it isn't declared.
+    PropertyId find(std::string_view name) const;
+
+    // Whether a value has the type of Holder the property is declared with.
+    bool accepts(PropertyId id, const Holder& value) const;
+
+  private:
+    template <typename T>
+    void _append(const Property<T>& property) {
+        if (property.id != _entries.size()) {
+            throw std::invalid_argument("Property " + std::string(property.name) + " is not declared in the order of its id");
+        }
+
+        Entry entry{property.name, property.type, property.event, T{}, nullptr, nullptr};
+        entry.assign = [](PropertyValue& slot, Holder&& value) {
+            T latest = PropertyType<T>::from(std::move(value));
+            T& cached = std::get<T>(slot);
+            if constexpr (std::is_same_v<T, Holder>) {
+                if (cached.same_value(latest)) {
+                    return false;
+                }
+            } else if (cached == latest) {
+                return false;
+            }
+            cached = std::move(latest);
+            return true;
+        };
+        entry.collect = [](const PropertyValue& slot, Holder::Type type) {
+            return PropertyType<T>::to(std::get<T>(slot), type);
+        };
+        _entries.push_back(std::move(entry));
+    }
+
+    void _index_build();
+
+    std::vector<Entry> _entries;
+    // Names sorted for lookup, along with their ids.
+    std::vector<std::pair<std::string_view, PropertyId>> _index;
+};
+
+}  // namespace SimpleDBus
@@ -6,9 +6,12 @@
 #include <kvn/kvn_safe_callback.hpp>
 #include <simpledbus/base/Path.h>
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 namespace SimpleDBus {
 
@@ -27,10 +30,16 @@ class Proxy : public std::enable_shared_from_this<Proxy> {
     bool path_exists(const std::string& path);
     std::shared_ptr<Proxy> path_get(const std::string& path);
 
+    /**
+     * @brief Proxy of a path anywhere below this one, found through the path index of the
+     *        tree, or nullptr if there is none.
+     */
+    std::shared_ptr<Proxy> path_lookup(const std::string& path);
+
     bool interface_exists(const std::string& name);
     std::shared_ptr<Interface> interface_get(const std::string& name);
 
-    const std::map<std::string, std::shared_ptr<Proxy>>& children();
+    const std::map<std::string, std::shared_ptr<Proxy>, std::less<>>& children();
     const std::map<std::string, std::shared_ptr<Interface>>& interfaces();
 
     virtual std::shared_ptr<Proxy> path_create(const std::string& path);
@@ -86,8 +95,8 @@ class Proxy : public std::enable_shared_from_this<Proxy> {
         std::vector<std::shared_ptr<T>> result;
         std::scoped_lock lock(_child_access_mutex);
         for (auto& [path, child] : _children) {
-            const std::string next_child = SimpleDBus::PathUtils::next_child_strip(_path, path);
-            if (next_child.find(prefix) == 0) {
+            std::string_view next_child = SimpleDBus::PathUtils::next_child_strip_view(_path, path);
+            if (next_child.rfind(prefix, 0) == 0) {
                 result.push_back(std::dynamic_pointer_cast<T>(child));
             }
         }
@@ -98,7 +107,21 @@ class Proxy : public std::enable_shared_from_this<Proxy> {
     static std::shared_ptr<T> create(std::shared_ptr<Connection> conn, const std::string& bus_name, const std::string& path) {
         auto child = std::make_shared<T>(conn, bus_name, path);
         child->on_registration();
-        child->register_object_path();
+        child->register_object_path(false);
+        return std::dynamic_pointer_cast<T>(child);
+    }
+
+    /**
+     * @brief Create a proxy that is exported on the connection, receiving every message
+     *        addressed to its path rather than only signals, as needed by objects that
+     *        answer method calls such as agents.
+     */
+    template <typename T>
+    static std::shared_ptr<T> create_exported(std::shared_ptr<Connection> conn, const std::string& bus_name,
+                                              const std::string& path) {
+        auto child = std::make_shared<T>(conn, bus_name, path);
+        child->on_registration();
+        child->register_object_path(true);
         return std::dynamic_pointer_cast<T>(child);
     }
 
@@ -113,16 +136,40 @@ class Proxy : public std::enable_shared_from_this<Proxy> {
     std::shared_ptr<Connection> _conn;
 
     std::map<std::string, std::shared_ptr<Interface>> _interfaces;
-    std::map<std::string, std::shared_ptr<Proxy>> _children;
+    std::map<std::string, std::shared_ptr<Proxy>, std::less<>> _children;
 
     std::recursive_mutex _interface_access_mutex;
     std::recursive_mutex _child_access_mutex;
 
   private:
+    friend class Interface;
+
+    // Bumped whenever a property of one of the interfaces changes value or validity.
+    std::atomic<uint64_t> _property_revision{0};
+
     // ----- PATH HANDLING -----
     bool _registered;
-    void register_object_path();
+    bool _exported;
+    void register_object_path(bool exported);
     void unregister_object_path();
+
+    // ----- PATH INDEX -----
+    // Proxies of a tree by path, shared by all the proxies of the tree. Adding and removing
+    // paths reaches the proxy to act on directly, the tree is only descended below the closest
+    // existing proxy. Entries don't keep proxies alive, the tree does.
+    struct PathIndex {
+        std::mutex mutex;
+        std::unordered_map<std::string, std::weak_ptr<Proxy>> proxies;
+    };
+    std::shared_ptr<PathIndex> _path_index;
+
+    std::shared_ptr<PathIndex> path_index();
+    std::shared_ptr<Proxy> path_index_closest(const std::string& path);
+    void path_index_insert(const std::shared_ptr<Proxy>& child);
+    void path_index_erase(const std::shared_ptr<Proxy>& child);
+
+    void path_insert(const std::string& path, Holder managed_interfaces);
+    void path_erase(std::string_view path, const Holder& removed_interfaces);
 };
 
 }  // namespace SimpleDBus
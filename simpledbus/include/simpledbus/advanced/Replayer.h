@@ -0,0 +1,90 @@
+#pragma once
+
+#include <simpledbus/base/Recording.h>
+
+#include <dbus/dbus.h>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace SimpleDBus {
+
+/**
+ * @brief Serves a recording to a single peer connection, without a bus.
+ *
+ * A `Connection` created on `address()` is fed the messages it received while the recording
+ * was made, so that the same `Proxy` and `Interface` tree can be driven offline. Method calls
+ * recorded as sent by the connection are waited for and answered with the recorded replies,
+ * while calls to the bus driver (e.g. match rules) are acknowledged right away.
+ */
+class Replayer {
+  public:
+    explicit Replayer(const std::string& filename);
+    ~Replayer();
+
+    Replayer(const Replayer&) = delete;
+    Replayer& operator=(const Replayer&) = delete;
+
+    /**
+     * @brief Address to create the replayed `Connection` with.
+     */
+    std::string address() const;
+
+    /**
+     * @brief Start replaying in the background, once a connection has been made to `address()`.
+     *
+     * @param speed Pace of the received messages relative to the recording, or 0 to replay
+     *              them as fast as possible.
+     */
+    void start(double speed = 0);
+
+    /**
+     * @brief Wait for the whole recording to be replayed.
+     */
+    void wait();
+
+    // Received messages delivered to the connection.
+    size_t delivered() const { return _delivered; }
+
+    // Recorded calls which the connection did not make in time.
+    size_t skipped() const { return _skipped; }
+
+    // Maximum time to wait for the connection to make a recorded method call.
+    std::chrono::milliseconds call_timeout{5000};
+
+  private:
+    struct CallMapping {
+        uint32_t recorded;
+        uint32_t live;
+    };
+
+    std::string _filename;
+    double _speed = 0;
+
+    DBusServer* _server = nullptr;
+    DBusConnection* _peer = nullptr;
+    std::vector<DBusWatch*> _server_watches;
+
+    std::thread _thread;
+    std::atomic_bool _active = false;
+    std::atomic<size_t> _delivered = 0;
+    std::atomic<size_t> _skipped = 0;
+
+    std::deque<Message> _live_calls;
+    std::vector<CallMapping> _calls;
+
+    void _run();
+    bool _accept(std::chrono::milliseconds timeout);
+    void _pump(int timeout_ms);
+    bool _await_call(const Message& recorded);
+    void _replay_received(Message& recorded);
+
+    static dbus_bool_t static_add_watch(DBusWatch* watch, void* data);
+    static void static_remove_watch(DBusWatch* watch, void* data);
+    static void static_new_connection(DBusServer* server, DBusConnection* conn, void* data);
+};
+
+}  // namespace SimpleDBus
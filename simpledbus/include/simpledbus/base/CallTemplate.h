@@ -0,0 +1,46 @@
+#pragma once
+
+#include <dbus/dbus.h>
+#include <string>
+#include "Message.h"
+
+namespace SimpleDBus {
+
+/**
+ * @brief Method call that is built once and then instantiated for every call, for methods
+ *        called repeatedly on the same object.
+ *
+ * The destination, path, interface and member are validated and encoded once. Every instance
+ * starts out as a duplicate of the prepared header, so that creating a call only costs
+ * marshalling its arguments.
+ */
+class CallTemplate {
+  public:
+    CallTemplate(const std::string& bus_name, const std::string& path, const std::string& interface,
+                 const std::string& method);
+
+    bool is_valid() const;
+
+    /**
+     * @brief Create a new call, owning its own message, with the given arguments appended
+     *        (see `Message::append`).
+     */
+    template <typename... Ts>
+    Message create(const Ts&... arguments) const;
+
+  private:
+    Message _duplicate() const;
+
+    Message _prototype;
+};
+
+template <typename... Ts>
+Message CallTemplate::create(const Ts&... arguments) const {
+    Message msg = _duplicate();
+    if constexpr (sizeof...(Ts) > 0) {
+        msg.append(arguments...);
+    }
+    return msg;
+}
+
+}  // namespace SimpleDBus
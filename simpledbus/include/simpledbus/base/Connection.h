@@ -1,10 +1,23 @@
 #pragma once
 
 #include <dbus/dbus.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <mutex>
 #include <unordered_map>
 #include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <vector>
 #include "Message.h"
+#include "Recording.h"
+#include "Stats.h"
 
 namespace SimpleDBus {
 
@@ -12,13 +25,28 @@ class Message;
 
 class Connection {
   public:
+    static constexpr std::chrono::milliseconds TIMEOUT_DEFAULT{DBUS_TIMEOUT_USE_DEFAULT};
+    static constexpr std::chrono::milliseconds TIMEOUT_INFINITE{DBUS_TIMEOUT_INFINITE};
+    static constexpr const char* ERROR_CANCELLED = "org.simpledbus.Error.Cancelled";
+
     Connection(::DBusBusType dbus_bus_type);
+
+    /**
+     * @brief Connect to a peer at `address` instead of a bus, such as a `Replayer`.
+     */
+    explicit Connection(const std::string& address);
     ~Connection();
 
     void init();
     void uninit();
     bool is_initialized();
 
+    /**
+     * @brief Add a match rule to the bus.
+     *
+     * @note Rules are reference counted, so identical rules added by independent users are only
+     *       removed from the bus once every one of them has called `remove_match()`.
+     */
     void add_match(std::string rule);
     void remove_match(std::string rule);
 
@@ -26,12 +54,159 @@ class Connection {
     void read_write_dispatch();
     Message pop_message();
 
+    // ----- EVENT LOOP -----
+    /**
+     * @brief Block until the bus has pending I/O, an internal DBus timeout expires,
+     *        `wakeup()` is called or `timeout_ms` elapses, then perform the pending I/O.
+     *
+     * @param timeout_ms Maximum time to block, in milliseconds. A negative value blocks indefinitely.
+     *
+     * @note Incoming messages are only queued, use `read_write_dispatch()` to dispatch them.
+     */
+    void process_events(int timeout_ms);
+    void wakeup();
+
     void send(Message& msg);
+
+    /**
+     * @brief Send a method call and block until its reply is received.
+     *
+     * @note No connection lock is held while waiting, so signals keep being dispatched and
+     *       other threads can issue calls concurrently. Blocked callers still take turns
+     *       reading from the socket, so `send_with_reply_async()` scales better when many
+     *       calls are in flight at once.
+     */
     Message send_with_reply_and_block(Message& msg);
 
+    /**
+     * @brief Send a method call and block until its reply is received, the timeout expires or
+     *        the call is cancelled through `cancel_pending_calls()`.
+     *
+     * @param timeout Maximum time to wait for the reply, `TIMEOUT_DEFAULT` for the libdbus
+     *                default of 25 seconds, or `TIMEOUT_INFINITE`.
+     *
+     * @throw Exception::SendFailed with `DBUS_ERROR_NO_REPLY` if the timeout expires, or with
+     *        `ERROR_CANCELLED` if the call is cancelled.
+     *
+     * @note The reply is delivered by the thread dispatching the connection. If there is none,
+     *       or it is the calling thread, libdbus waits for the reply by itself instead and the
+     *       call can no longer be cancelled, although it remains bounded by the timeout.
+     */
+    Message send_with_reply_and_block(Message& msg, std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Send a method call without waiting for its reply.
+     *
+     * @param callback Invoked with the reply (or error) message from the thread that dispatches
+     *                 the connection, usually the one calling `read_write_dispatch()`.
+     * @param timeout Time after which the callback receives a `DBUS_ERROR_NO_REPLY` error.
+     */
+    void send_with_reply_async(Message& msg, std::function<void(Message& reply)> callback,
+                               std::chrono::milliseconds timeout = TIMEOUT_DEFAULT);
+
+    /**
+     * @brief Send a method call without waiting for its reply.
+     *
+     * @return Future resolving to the reply, or holding an `Exception::SendFailed` if an error was returned.
+     *
+     * @note The future is fulfilled when the connection is dispatched, so it must not be waited
+     *       upon from the thread responsible for dispatching.
+     */
+    std::future<Message> send_with_reply_async(Message& msg, std::chrono::milliseconds timeout = TIMEOUT_DEFAULT);
+
+    /**
+     * @brief Cancel all in-flight calls addressed to `path` or any of its descendants.
+     *
+     * Callbacks of the cancelled calls are invoked immediately with an `ERROR_CANCELLED` error
+     * reply, and blocked callers are released with an exception.
+     */
+    void cancel_pending_calls(const std::string& path);
+
+    /**
+     * @brief Export an object on `path`, receiving every message addressed to it.
+     *
+     * @note Only needed for objects that answer method calls, such as agents. Consumers of
+     *       signals should use `register_signal_handler` instead.
+     */
     bool register_object_path(const std::string& path, std::function<void(Message&)> handler);
     bool unregister_object_path(const std::string& path);
 
+    /**
+     * @brief Route the signals emitted by objects on `path` to `handler`.
+     *
+     * All routes are served by a single connection filter, without exporting anything on the
+     * connection. Signals without a route fall through to the exported objects, if any.
+     */
+    bool register_signal_handler(const std::string& path, std::function<void(Message&)> handler);
+
+    /**
+     * @brief Remove the route of `path`.
+     *
+     * @note Waits for the handler to return if it is running on a dispatch worker.
+     */
+    bool unregister_signal_handler(const std::string& path);
+
+    /**
+     * @brief Called with the path of signals that have no route, such as those of objects
+     *        whose proxies are only created on demand. If it registers a handler for the path
+     *        and returns true, the signal is routed to it.
+     *
+     * @note Runs on the dispatching thread with the dispatch lock held.
+     */
+    void set_signal_fallback(std::function<bool(std::string_view path)> fallback);
+
+    /**
+     * @brief Keep signals that have no route, nor a fallback taking them, for up to `duration`.
+     *        If a handler is registered for their path meanwhile, they are handed to it in the
+     *        order they arrived, ahead of the signals that follow them. Disabled if zero, the
+     *        default.
+     *
+     * Meant for routes registered as objects are announced on another connection, whose
+     * messages are not ordered with those of this one.
+     */
+    void set_signal_hold(std::chrono::milliseconds duration);
+
+    /**
+     * @brief Hand routed signals over to a pool of `workers` threads instead of handling them
+     *        on the dispatching thread. Takes effect on the next call to `init`.
+     *
+     * Signals are assigned to a worker by the first `subtree_depth` segments of their path, or
+     * by the whole path if zero, so signals of the same object or subtree are still handled in
+     * order while different ones are handled in parallel. ObjectManager signals are assigned by
+     * the object they announce or remove instead, so that they are handled before the signals
+     * of that object. Signals without a route are looked up again by their worker, as the
+     * route might be registered by a signal queued before them. Replies and messages addressed
+     * to exported objects are always handled on the dispatching thread.
+     */
+    void set_dispatch_workers(size_t workers, size_t subtree_depth = 0);
+
+    // ----- STATISTICS -----
+
+    /**
+     * @brief Start or stop collecting traffic, latency and queue statistics.
+     *
+     * @note Collecting has a cost, as every message is marshalled to measure its size.
+     */
+    void set_stats_enabled(bool enabled);
+    bool stats_enabled() const { return _stats_enabled; }
+
+    /**
+     * @brief Snapshot of the statistics collected so far.
+     */
+    ConnectionStats stats();
+    void reset_stats();
+
+    // ----- RECORDING -----
+
+    /**
+     * @brief Record every message sent and received from now on into `filename`.
+     *
+     * @note Replies are recorded when their call completes, which keeps them after the call
+     *       in the recording. See `RecordingWriter` for the file format.
+     */
+    void start_recording(const std::string& filename);
+    void stop_recording();
+
     // ----- PROPERTIES -----
     std::string unique_name();
 
@@ -39,12 +214,128 @@ class Connection {
     bool _initialized = false;
 
     ::DBusBusType _dbus_bus_type;
+    std::string _address;
     ::DBusConnection* _conn;
 
+    // NOTE: No lock is held while waiting for a reply, libdbus is thread-safe on its own.
+    // `_mutex` protects the connection life cycle, while `_dispatch_mutex` serializes
+    // dispatching with the registration of message handlers.
     std::recursive_mutex _mutex;
+    std::recursive_mutex _dispatch_mutex;
+    std::atomic<std::thread::id> _dispatch_thread;
+
+    struct PendingCallData {
+        Connection* conn;
+        Message call;
+        std::string path;
+        std::function<void(Message&)> callback;
+        std::chrono::steady_clock::time_point sent;
+        std::atomic_bool notified{false};
+    };
+
+    // In-flight asynchronous calls, each holding a reference to its pending call.
+    std::mutex _pending_mutex;
+    std::unordered_map<DBusPendingCall*, PendingCallData*> _pending_calls;
+
+    Message _send_with_reply_and_block(Message& msg, int timeout_ms);
+    // Returns a reference to the pending call, to be released by the caller.
+    DBusPendingCall* _send_with_reply_async(Message& msg, std::function<void(Message& reply)> callback,
+                                            std::chrono::milliseconds timeout);
+    // Cancel a call without completing it, if it is still in flight.
+    void _cancel_pending_call(DBusPendingCall* pending);
+    static void _pending_complete(PendingCallData* pending_data, Message& reply);
 
     static DBusHandlerResult static_message_handler(DBusConnection* connection, DBusMessage* message, void* user_data);
+    static void static_pending_notify(DBusPendingCall* pending, void* user_data);
+    static void static_pending_free(void* user_data);
     std::unordered_map<std::string, std::function<void(Message&)>> _message_handlers;
+
+    struct SignalRoute {
+        std::string path;
+        std::function<void(Message&)> handler;
+        size_t shard;
+
+        // Held by dispatch workers while running the handler.
+        std::recursive_mutex mutex;
+        bool active = true;
+    };
+
+    // NOTE: Keyed by a view of the path owned by the route, so that routing an incoming signal
+    // can use the path of the underlying message without copying it.
+    static DBusHandlerResult static_signal_filter(DBusConnection* connection, DBusMessage* message, void* user_data);
+    std::unordered_map<std::string_view, std::shared_ptr<SignalRoute>> _signal_routes;
+    std::function<bool(std::string_view path)> _signal_fallback;
+
+    // NOTE: Only accessed while holding `_dispatch_mutex`.
+    std::chrono::milliseconds _signal_hold_duration{0};
+    std::deque<std::pair<std::chrono::steady_clock::time_point, Message>> _held_signals;
+    std::deque<Message> _released_signals;
+
+    bool _signal_hold(Message& msg);
+    void _signal_release(const std::shared_ptr<SignalRoute>& route);
+    void _dispatch_released();
+
+    // ----- DISPATCH WORKERS -----
+    struct DispatchWorker {
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<std::tuple<std::shared_ptr<SignalRoute>, Message, std::chrono::steady_clock::time_point>> queue;
+        bool active = true;
+    };
+
+    size_t _dispatch_worker_count = 0;
+    size_t _dispatch_subtree_depth = 0;
+
+    // NOTE: Only modified while holding `_dispatch_mutex`.
+    std::vector<std::unique_ptr<DispatchWorker>> _dispatch_workers;
+
+    size_t _route_shard(std::string_view path) const;
+    void _dispatch_workers_start();
+    void _dispatch_workers_stop();
+    static void _dispatch_worker_loop(Connection* conn, DispatchWorker* worker);
+
+    // ----- STATISTICS -----
+    std::atomic_bool _stats_enabled = false;
+    std::mutex _stats_mutex;
+    ConnectionStats _stats;
+
+    // ----- RECORDING -----
+    std::atomic_bool _recording = false;
+    std::shared_ptr<RecordingWriter> _recorder;
+
+    // Start of the current dispatch pass, only accessed while holding `_dispatch_mutex`.
+    std::chrono::steady_clock::time_point _dispatch_pass_start;
+
+    void _trace_message(DBusMessage* msg, bool sent);
+    void _stats_message(DBusMessage* msg, bool sent);
+    void _stats_call_latency(DBusMessage* call, std::chrono::steady_clock::time_point sent);
+    void _stats_lag(Histogram ConnectionStats::*histogram, std::chrono::steady_clock::time_point since);
+    static DBusHandlerResult static_stats_filter(DBusConnection* connection, DBusMessage* message, void* user_data);
+
+    std::mutex _match_mutex;
+    std::unordered_map<std::string, size_t> _match_rules;
+
+    // ----- EVENT LOOP -----
+    int _epoll_fd = -1;
+    int _wakeup_fd = -1;
+
+    std::mutex _watch_mutex;
+    std::unordered_map<int, std::vector<DBusWatch*>> _watches;
+    std::unordered_map<DBusTimeout*, std::chrono::steady_clock::time_point> _timeouts;
+
+    void _watch_update(int fd);
+    int _timeout_next(int timeout_ms);
+    void _timeout_handle();
+
+    static dbus_bool_t static_add_watch(DBusWatch* watch, void* data);
+    static void static_remove_watch(DBusWatch* watch, void* data);
+    static void static_toggle_watch(DBusWatch* watch, void* data);
+    static dbus_bool_t static_add_timeout(DBusTimeout* timeout, void* data);
+    static void static_remove_timeout(DBusTimeout* timeout, void* data);
+    static void static_toggle_timeout(DBusTimeout* timeout, void* data);
+    static void static_wakeup_main(void* data);
+    static void static_dispatch_status(DBusConnection* connection, DBusDispatchStatus new_status, void* data);
 };
 
 }  // namespace SimpleDBus
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <dbus/dbus.h>
+#include "Holder.h"
+#include "Marshal.h"
+#include "Message.h"
+
+namespace SimpleDBus {
+
+/**
+ * @brief Forward-only view over the arguments of a message, or over the contents of one of
+ *        its containers.
+ *
+ * Values are read in place and skipped without being decoded, a Holder is only built for the
+ * values that are extracted. A cursor is only valid for as long as its message is.
+ */
+class Cursor {
+  public:
+    explicit Cursor(const Message& msg);
+
+    // D-Bus type of the current value, DBUS_TYPE_INVALID once the cursor is exhausted.
+    int type() const;
+    bool at_end() const;
+
+    /**
+     * @brief Move to the next value, returning false if there is none.
+     */
+    bool next();
+
+    /**
+     * @brief Cursor over the contents of the current array, dictionary entry, struct or variant.
+     */
+    Cursor recurse() const;
+
+    /**
+     * @brief Read the current value, which must be of the D-Bus type of `T` (see
+     *        `Marshal::Type`). Strings can be read in place as std::string_view.
+     */
+    template <typename T>
+    T get() const {
+        return Marshal::Type<T>::read(&_iter);
+    }
+
+    /**
+     * @brief Build a Holder out of the current value, unwrapping variants.
+     */
+    Holder extract() const;
+
+    /**
+     * @brief Visit the entries of the current dictionary as `visitor(key, value)`, both given
+     *        as cursors. Iteration stops early if the visitor returns false.
+     */
+    template <typename F>
+    void for_each_entry(F&& visitor) const {
+        for (Cursor entry = recurse(); entry.type() == DBUS_TYPE_DICT_ENTRY; entry.next()) {
+            Cursor key = entry.recurse();
+            Cursor value = key;
+            value.next();
+            if (!visitor(key, value)) {
+                break;
+            }
+        }
+    }
+
+  private:
+    Cursor() = default;
+
+    mutable DBusMessageIter _iter;
+    bool _valid = false;
+};
+
+}  // namespace SimpleDBus
@@ -51,6 +51,15 @@ class PathNotFoundException : public BaseException {
     std::string _message;
 };
 
+class SignatureMismatch : public BaseException {
+  public:
+    SignatureMismatch(const std::string& expected, const std::string& actual);
+    const char* what() const noexcept override;
+
+  private:
+    std::string _message;
+};
+
 }  // namespace Exception
 
 }  // namespace SimpleDBus
@@ -1,10 +1,15 @@
 #pragma once
 
 #include <any>
-#include <optional>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
 #include <vector>
 
 namespace SimpleDBus {
@@ -14,6 +19,7 @@ class ObjectPath {
     ObjectPath(const std::string& path) : path(path) {}
     ObjectPath(const char* path) : path(path) {}
     operator std::string() const { return path; }
+    const char* c_str() const { return path.c_str(); }
     bool operator<(const ObjectPath& other) const { return path < other.path; }
 
   private:
@@ -25,6 +31,7 @@ class Signature {
     Signature(const std::string& signature) : signature(signature) {}
     Signature(const char* signature) : signature(signature) {}
     operator std::string() const { return signature; }
+    const char* c_str() const { return signature.c_str(); }
     bool operator<(const Signature& other) const { return signature < other.signature; }
 
   private:
@@ -38,9 +45,28 @@ class Holder {
     Holder();
     ~Holder();
 
+    Holder(const Holder& other);
+    Holder(Holder&& other) noexcept;
+    Holder& operator=(const Holder& other);
+    Holder& operator=(Holder&& other) noexcept;
+
     bool operator!=(const Holder& rhs) const;
     bool operator==(const Holder& rhs) const;
 
+    /**
+     * @brief Structural hash of the contents, computed on first use and cached until the
+     *        holder is modified. Holders that compare equal have the same hash, so holders
+     *        whose hashes differ are told apart without comparing their contents.
+     */
+    size_t hash() const;
+
+    /**
+     * @brief Whether `latest` holds the same value as this holder, hashing it first. Meant for
+     *        cached values compared against each update: the cache keeps its hash, so an update
+     *        carrying a new value is told apart by hashing the update alone.
+     */
+    bool same_value(const Holder& latest) const;
+
     typedef enum {
         NONE,
         BYTE,
@@ -56,9 +82,34 @@ class Holder {
         OBJ_PATH,
         SIGNATURE,
         ARRAY,
-        DICT
+        DICT,
+        BYTE_ARRAY
     } Type;
 
+    // Dictionaries are stored as <key, value> pairs, sorted by key type and then by key.
+    typedef std::vector<std::pair<Holder, Holder>> Dict;
+
+    /**
+     * @brief Entries of a dictionary holding keys of a single type, borrowed from the holder.
+     *
+     * @note Only valid for as long as the dictionary is neither modified nor destroyed.
+     */
+    class DictView {
+      public:
+        typedef const std::pair<Holder, Holder>* iterator;
+
+        DictView(iterator begin, iterator end) : _begin(begin), _end(end) {}
+
+        iterator begin() const { return _begin; }
+        iterator end() const { return _end; }
+        size_t size() const { return static_cast<size_t>(_end - _begin); }
+        bool empty() const { return _begin == _end; }
+
+      private:
+        iterator _begin;
+        iterator _end;
+    };
+
     Type type() const;
     std::string represent() const;
     std::string signature() const;
@@ -78,8 +129,22 @@ class Holder {
     static Holder create_object_path(const ObjectPath& path);
     static Holder create_signature(const Signature& signature);
     static Holder create_array();
+    static Holder create_array(std::vector<Holder> elements);
     static Holder create_dict();
 
+    /**
+     * @brief Create a dictionary out of unsorted entries, keeping the last value of every
+     *        duplicate key.
+     */
+    static Holder create_dict(Dict entries);
+
+    /**
+     * @brief Create an array of bytes (`ay`), stored contiguously rather than as one
+     *        Holder per byte. It can still be accessed and extended as a regular array.
+     */
+    static Holder create_byte_array(const uint8_t* data, size_t size);
+    static Holder create_byte_array(const std::vector<uint8_t>& bytes);
+
     std::any get_contents() const;
 
     // TODO: Deprecate these functions in favor of templated version.
@@ -96,6 +161,27 @@ class Holder {
     std::string get_object_path() const;
     std::string get_signature() const;
     std::vector<Holder> get_array() const;
+    std::vector<uint8_t> get_byte_array() const;
+
+    // Borrowing accessors, which neither copy nor convert the contents of the holder. They
+    // stay valid for as long as the holder is neither modified nor destroyed.
+
+    // Contents of a STRING, OBJ_PATH or SIGNATURE holder, empty for any other type.
+    std::string_view get_string_view() const;
+
+    // Elements of an ARRAY holder, empty for any other type. Byte arrays are not stored as
+    // elements, so BYTE_ARRAY holders throw std::invalid_argument and are read with `byte_array()`.
+    const std::vector<Holder>& array_view() const;
+
+    // Contents of a BYTE_ARRAY holder, empty for any other type.
+    const std::vector<uint8_t>& byte_array() const;
+
+    // Entries of a dictionary whose key is of the given type.
+    DictView dict_view(Type key_type) const;
+
+    template <typename Key>
+    DictView dict_view() const;
+
     std::map<uint8_t, Holder> get_dict_uint8() const;
     std::map<uint16_t, Holder> get_dict_uint16() const;
     std::map<uint32_t, Holder> get_dict_uint32() const;
@@ -108,6 +194,28 @@ class Holder {
     std::map<std::string, Holder> get_dict_signature() const;
 
     void dict_append(Type key_type, std::any key, Holder value);
+    void dict_append(Holder key, Holder value);
+
+    /**
+     * @brief Entries of a dictionary, to be iterated without conversion or copies.
+     */
+    const Dict& dict_entries() const;
+
+    /**
+     * @brief Move the entries out of a dictionary, leaving it empty, so that its keys and
+     *        values can be handed over without copying them.
+     */
+    Dict dict_take();
+
+    /**
+     * @brief Value stored under `key` in a dictionary, or nullptr if there is none.
+     *
+     * @note Strings look up STRING keys, ObjectPaths look up OBJ_PATH keys.
+     */
+    const Holder* dict_find(const Holder& key) const;
+    const Holder* dict_find(const std::string& key) const;
+    const Holder* dict_find(const char* key) const;
+    const Holder* dict_find(const ObjectPath& key) const;
     void array_append(Holder holder);
 
     // Template speciallizations.
@@ -122,16 +230,22 @@ class Holder {
 
   private:
     Type _type = NONE;
-    std::optional<std::string> _signature;
 
-    bool holder_boolean = false;
-    uint64_t holder_integer = 0;
-    double holder_double = 0;
-    std::string holder_string;
-    std::vector<Holder> holder_array;
+    // Cached result of `hash()`, 0 until it is computed. Fits in the padding after the type.
+    mutable std::atomic<uint32_t> _hash{0};
+
+    // Only allocated for the few holders whose signature is overridden.
+    std::shared_ptr<const std::string> _signature;
 
-    // Dictionaries are stored within a vector as a tuple of <key_type, key, holder>
-    std::vector<std::tuple<Type, std::any, Holder>> holder_dict;
+    // Only the contents of the held type are stored. Integers of every width share a single
+    // alternative, and dictionaries are stored as a vector of <key, value> pairs.
+    std::variant<std::monostate, bool, uint64_t, double, std::string, std::vector<Holder>, std::vector<uint8_t>, Dict>
+        _value;
+
+    uint64_t _integer() const;
+    uint32_t _compute_hash() const;
+    const std::string& _string() const;
+    const std::vector<Holder>& _array() const;
 
     std::vector<std::string> _represent_container() const;
     std::string _represent_simple() const;
@@ -140,6 +254,11 @@ class Holder {
     template <typename T>
     std::map<T, Holder> _get_dict(Type key_type) const;
 
+    const Holder* _dict_find_string(Type key_type, const std::string& key) const;
+
+    static Holder _create_key(Type key_type, const std::any& key);
+    static bool _key_less(const Holder& a, const Holder& b);
+    static uint32_t _hash_byte(uint8_t value);
     static std::string _signature_type(Type type) noexcept;
     static std::string _represent_type(Type type, std::any value) noexcept;
 };
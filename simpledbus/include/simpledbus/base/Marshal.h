@@ -0,0 +1,286 @@
+#pragma once
+
+#include <dbus/dbus.h>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Holder.h"
+
+namespace SimpleDBus {
+
+namespace Marshal {
+
+/**
+ * @brief D-Bus signature of a type, built at compile time.
+ */
+template <size_t N>
+struct SignatureString {
+    char value[N + 1] = {};
+
+    constexpr size_t size() const { return N; }
+    constexpr const char* c_str() const { return value; }
+};
+
+template <size_t A, size_t B>
+constexpr SignatureString<A + B> operator+(const SignatureString<A>& a, const SignatureString<B>& b) {
+    SignatureString<A + B> output;
+    for (size_t i = 0; i < A; i++) {
+        output.value[i] = a.value[i];
+    }
+    for (size_t i = 0; i < B; i++) {
+        output.value[A + i] = b.value[i];
+    }
+    return output;
+}
+
+constexpr SignatureString<1> code(int type) {
+    SignatureString<1> output;
+    output.value[0] = static_cast<char>(type);
+    return output;
+}
+
+/**
+ * @brief Bytes appended as, or read from, an `ay` argument without being copied.
+ *
+ * When read, the bytes belong to the message and are only valid for as long as it is.
+ */
+struct ByteView {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+
+    ByteView() = default;
+    ByteView(const uint8_t* data, size_t size) : data(data), size(size) {}
+};
+
+/**
+ * @brief Marshals a C++ type straight to and from a `DBusMessageIter`.
+ *
+ * Specializations provide the `signature` of the type, `append` and `read`. Supported are
+ * integers, bool, double, std::string (and std::string_view to read strings in place),
+ * ObjectPath, Signature, ByteView, std::vector (`a`), std::map and vectors of std::pair
+ * (`a{}`), and Holder, which is marshalled as a variant (`v`).
+ */
+template <typename T>
+struct Type;
+
+// Holders are marshalled as variants, through the dynamically typed code path of Message.
+void append_variant(DBusMessageIter* iter, const Holder& value);
+Holder read_variant(DBusMessageIter* iter);
+
+template <typename T, int DBusType>
+struct BasicType {
+    static constexpr SignatureString<1> signature = code(DBusType);
+
+    static void append(DBusMessageIter* iter, const T& value) { dbus_message_iter_append_basic(iter, DBusType, &value); }
+
+    static T read(DBusMessageIter* iter) {
+        T value;
+        dbus_message_iter_get_basic(iter, &value);
+        return value;
+    }
+};
+
+template <int DBusType>
+struct StringType {
+    static constexpr SignatureString<1> signature = code(DBusType);
+
+    static void append(DBusMessageIter* iter, const char* value) {
+        dbus_message_iter_append_basic(iter, DBusType, &value);
+    }
+
+    static const char* read(DBusMessageIter* iter) {
+        const char* value;
+        dbus_message_iter_get_basic(iter, &value);
+        return value;
+    }
+};
+
+// clang-format off
+template <> struct Type<uint8_t> : BasicType<uint8_t, DBUS_TYPE_BYTE> {};
+template <> struct Type<int16_t> : BasicType<int16_t, DBUS_TYPE_INT16> {};
+template <> struct Type<uint16_t> : BasicType<uint16_t, DBUS_TYPE_UINT16> {};
+template <> struct Type<int32_t> : BasicType<int32_t, DBUS_TYPE_INT32> {};
+template <> struct Type<uint32_t> : BasicType<uint32_t, DBUS_TYPE_UINT32> {};
+template <> struct Type<int64_t> : BasicType<int64_t, DBUS_TYPE_INT64> {};
+template <> struct Type<uint64_t> : BasicType<uint64_t, DBUS_TYPE_UINT64> {};
+template <> struct Type<double> : BasicType<double, DBUS_TYPE_DOUBLE> {};
+// clang-format on
+
+template <>
+struct Type<bool> {
+    static constexpr SignatureString<1> signature = code(DBUS_TYPE_BOOLEAN);
+
+    static void append(DBusMessageIter* iter, bool value) {
+        dbus_bool_t contents = value;
+        dbus_message_iter_append_basic(iter, DBUS_TYPE_BOOLEAN, &contents);
+    }
+
+    static bool read(DBusMessageIter* iter) {
+        dbus_bool_t contents;
+        dbus_message_iter_get_basic(iter, &contents);
+        return contents;
+    }
+};
+
+template <>
+struct Type<std::string> : StringType<DBUS_TYPE_STRING> {
+    static void append(DBusMessageIter* iter, const std::string& value) { StringType::append(iter, value.c_str()); }
+    static std::string read(DBusMessageIter* iter) { return StringType::read(iter); }
+};
+
+// Strings read in place, which are only valid for as long as the message is.
+template <>
+struct Type<std::string_view> : StringType<DBUS_TYPE_STRING> {
+    static void append(DBusMessageIter* iter, std::string_view value) {
+        StringType::append(iter, std::string(value).c_str());
+    }
+    static std::string_view read(DBusMessageIter* iter) { return StringType::read(iter); }
+};
+
+template <>
+struct Type<ObjectPath> : StringType<DBUS_TYPE_OBJECT_PATH> {
+    static void append(DBusMessageIter* iter, const ObjectPath& value) { StringType::append(iter, value.c_str()); }
+    static ObjectPath read(DBusMessageIter* iter) { return ObjectPath(StringType::read(iter)); }
+};
+
+template <>
+struct Type<Signature> : StringType<DBUS_TYPE_SIGNATURE> {
+    static void append(DBusMessageIter* iter, const Signature& value) { StringType::append(iter, value.c_str()); }
+    static Signature read(DBusMessageIter* iter) { return Signature(StringType::read(iter)); }
+};
+
+template <>
+struct Type<Holder> {
+    static constexpr SignatureString<1> signature = code(DBUS_TYPE_VARIANT);
+
+    static void append(DBusMessageIter* iter, const Holder& value) { append_variant(iter, value); }
+    static Holder read(DBusMessageIter* iter) { return read_variant(iter); }
+};
+
+template <>
+struct Type<ByteView> {
+    static constexpr SignatureString<2> signature = code(DBUS_TYPE_ARRAY) + code(DBUS_TYPE_BYTE);
+
+    static void append(DBusMessageIter* iter, const ByteView& value) {
+        DBusMessageIter sub_iter;
+        dbus_message_iter_open_container(iter, DBUS_TYPE_ARRAY, DBUS_TYPE_BYTE_AS_STRING, &sub_iter);
+        dbus_message_iter_append_fixed_array(&sub_iter, DBUS_TYPE_BYTE, &value.data, static_cast<int>(value.size));
+        dbus_message_iter_close_container(iter, &sub_iter);
+    }
+
+    static ByteView read(DBusMessageIter* iter) {
+        DBusMessageIter sub_iter;
+        dbus_message_iter_recurse(iter, &sub_iter);
+        const uint8_t* data;
+        int size;
+        dbus_message_iter_get_fixed_array(&sub_iter, &data, &size);
+        return ByteView(data, static_cast<size_t>(size));
+    }
+};
+
+// Dictionary entries, only valid as elements of an array.
+template <typename K, typename V>
+struct Type<std::pair<K, V>> {
+    static constexpr auto signature = code(DBUS_DICT_ENTRY_BEGIN_CHAR) + Type<K>::signature + Type<V>::signature +
+                                      code(DBUS_DICT_ENTRY_END_CHAR);
+
+    static void append(DBusMessageIter* iter, const K& key, const V& value) {
+        DBusMessageIter entry_iter;
+        dbus_message_iter_open_container(iter, DBUS_TYPE_DICT_ENTRY, nullptr, &entry_iter);
+        Type<K>::append(&entry_iter, key);
+        Type<V>::append(&entry_iter, value);
+        dbus_message_iter_close_container(iter, &entry_iter);
+    }
+
+    static void append(DBusMessageIter* iter, const std::pair<K, V>& entry) { append(iter, entry.first, entry.second); }
+
+    static std::pair<K, V> read(DBusMessageIter* iter) {
+        DBusMessageIter entry_iter;
+        dbus_message_iter_recurse(iter, &entry_iter);
+        K key = Type<K>::read(&entry_iter);
+        dbus_message_iter_next(&entry_iter);
+        return std::pair<K, V>(std::move(key), Type<V>::read(&entry_iter));
+    }
+};
+
+template <typename T>
+struct Type<std::vector<T>> {
+    static constexpr auto signature = code(DBUS_TYPE_ARRAY) + Type<T>::signature;
+
+    // Arrays of fixed size numbers are copied at once rather than element by element.
+    static constexpr bool fixed = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+    static void append(DBusMessageIter* iter, const std::vector<T>& value) {
+        DBusMessageIter sub_iter;
+        dbus_message_iter_open_container(iter, DBUS_TYPE_ARRAY, Type<T>::signature.c_str(), &sub_iter);
+        if constexpr (fixed) {
+            const T* data = value.data();
+            dbus_message_iter_append_fixed_array(&sub_iter, Type<T>::signature.value[0], &data,
+                                                 static_cast<int>(value.size()));
+        } else {
+            for (const auto& element : value) {
+                Type<T>::append(&sub_iter, element);
+            }
+        }
+        dbus_message_iter_close_container(iter, &sub_iter);
+    }
+
+    static std::vector<T> read(DBusMessageIter* iter) {
+        DBusMessageIter sub_iter;
+        dbus_message_iter_recurse(iter, &sub_iter);
+        std::vector<T> output;
+        if constexpr (fixed) {
+            const T* data;
+            int size;
+            dbus_message_iter_get_fixed_array(&sub_iter, &data, &size);
+            output.assign(data, data + size);
+        } else {
+            while (dbus_message_iter_get_arg_type(&sub_iter) != DBUS_TYPE_INVALID) {
+                output.push_back(Type<T>::read(&sub_iter));
+                dbus_message_iter_next(&sub_iter);
+            }
+        }
+        return output;
+    }
+};
+
+template <typename K, typename V>
+struct Type<std::map<K, V>> {
+    static constexpr auto signature = code(DBUS_TYPE_ARRAY) + Type<std::pair<K, V>>::signature;
+
+    static void append(DBusMessageIter* iter, const std::map<K, V>& value) {
+        DBusMessageIter sub_iter;
+        dbus_message_iter_open_container(iter, DBUS_TYPE_ARRAY, Type<std::pair<K, V>>::signature.c_str(), &sub_iter);
+        for (const auto& [key, element] : value) {
+            Type<std::pair<K, V>>::append(&sub_iter, key, element);
+        }
+        dbus_message_iter_close_container(iter, &sub_iter);
+    }
+
+    static std::map<K, V> read(DBusMessageIter* iter) {
+        DBusMessageIter sub_iter;
+        dbus_message_iter_recurse(iter, &sub_iter);
+        std::map<K, V> output;
+        while (dbus_message_iter_get_arg_type(&sub_iter) != DBUS_TYPE_INVALID) {
+            auto entry = Type<std::pair<K, V>>::read(&sub_iter);
+            output.insert_or_assign(std::move(entry.first), std::move(entry.second));
+            dbus_message_iter_next(&sub_iter);
+        }
+        return output;
+    }
+};
+
+/**
+ * @brief Signature of a sequence of arguments of the given types.
+ */
+template <typename... Ts>
+constexpr auto signature = (Type<Ts>::signature + ...);
+
+}  // namespace Marshal
+
+}  // namespace SimpleDBus
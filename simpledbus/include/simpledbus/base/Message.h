@@ -2,9 +2,14 @@
 
 #include <dbus/dbus.h>
 #include <atomic>
+#include <cstring>
+#include <memory>
 #include <string>
+#include <tuple>
 #include <vector>
+#include "Exceptions.h"
 #include "Holder.h"
+#include "Marshal.h"
 
 namespace SimpleDBus {
 
@@ -22,6 +27,9 @@ class Message {
 
     Message();
     Message(Message&& other) noexcept;
+
+    // Copies share the underlying DBusMessage, which is only duplicated once a copy appends
+    // arguments to it. Sending a copy sends the shared message.
     Message(const Message& other);
     Message& operator=(Message&& other) noexcept;
     Message& operator=(const Message& other);
@@ -31,6 +39,28 @@ class Message {
 
     bool is_valid() const;
     void append_argument(const Holder& argument, const std::string& signature);
+
+    /**
+     * @brief Append arguments straight from C++ values, with a signature derived from their
+     *        types at compile time (see `Marshal::Type`), without going through Holders.
+     */
+    template <typename... Ts>
+    void append(const Ts&... values);
+
+    /**
+     * @brief Read all arguments of the message into C++ values, independently of `extract`.
+     *
+     * @throws Exception::SignatureMismatch if the message does not have the signature of `Ts`.
+     */
+    template <typename... Ts>
+    std::tuple<Ts...> read() const;
+
+    /**
+     * @brief Whether the arguments of the message are those of the types `Ts`.
+     */
+    template <typename... Ts>
+    bool has_signature() const;
+
     Holder extract();
     void extract_reset();
     bool extract_has_next();
@@ -60,19 +90,22 @@ class Message {
   private:
     static std::atomic_int32_t _creation_counter;
 
-    int _indent = 0;
     int32_t _unique_id = INVALID_UNIQUE_ID;
     DBusMessageIter _iter;
     bool _iter_initialized = false;
     bool _is_extracted = false;
     Holder _extracted;
     DBusMessage* _msg = nullptr;
-    std::vector<Holder> _arguments;
 
-    Holder _extract_bytearray(DBusMessageIter* iter);
-    Holder _extract_array(DBusMessageIter* iter);
-    Holder _extract_dict(DBusMessageIter* iter);
-    Holder _extract_generic(DBusMessageIter* iter);
+    // Shared by every copy wrapping the same DBusMessage, so that sharing is tracked without
+    // reading the reference count libdbus keeps private. Set to true when references to the
+    // message are also held outside of the copies, such as by libdbus.
+    std::shared_ptr<const bool> _sharing;
+
+    static Holder _extract_bytearray(DBusMessageIter* iter);
+    static Holder _extract_array(DBusMessageIter* iter);
+    static Holder _extract_dict(DBusMessageIter* iter);
+    static Holder _extract_generic(DBusMessageIter* iter);
 
     /**
      * @brief Append argument to the DBus message iterator.
@@ -80,10 +113,50 @@ class Message {
      * @param argument  Argument to append.
      * @param signature Signature of the argument.
      */
-    void _append_argument(DBusMessageIter* iter, const Holder& argument, const std::string& signature);
+    static void _append_argument(DBusMessageIter* iter, const Holder& argument, const std::string& signature);
 
+    void _copy_from(const Message& other);
+    void _detach();
     void _invalidate();
     void _safe_delete();
+
+    friend class Cursor;
+    friend void Marshal::append_variant(DBusMessageIter* iter, const Holder& value);
+    friend Holder Marshal::read_variant(DBusMessageIter* iter);
 };
 
+template <typename... Ts>
+void Message::append(const Ts&... values) {
+    _detach();
+
+    DBusMessageIter iter;
+    dbus_message_iter_init_append(_msg, &iter);
+    (Marshal::Type<Ts>::append(&iter, values), ...);
+}
+
+template <typename... Ts>
+bool Message::has_signature() const {
+    static constexpr auto signature = Marshal::signature<Ts...>;
+    return is_valid() && std::strcmp(dbus_message_get_signature(_msg), signature.c_str()) == 0;
+}
+
+template <typename... Ts>
+std::tuple<Ts...> Message::read() const {
+    if (!has_signature<Ts...>()) {
+        throw Exception::SignatureMismatch(Marshal::signature<Ts...>.c_str(),
+                                           is_valid() ? dbus_message_get_signature(_msg) : "");
+    }
+
+    DBusMessageIter iter;
+    dbus_message_iter_init(_msg, &iter);
+    auto read_next = [&iter](auto type) {
+        auto value = decltype(type)::read(&iter);
+        dbus_message_iter_next(&iter);
+        return value;
+    };
+
+    // Braced initialization evaluates the arguments in order.
+    return std::tuple<Ts...>{read_next(Marshal::Type<Ts>())...};
+}
+
 }  // namespace SimpleDBus
\ No newline at end of file
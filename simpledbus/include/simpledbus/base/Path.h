@@ -1,15 +1,22 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace SimpleDBus {
 
+/**
+ * @brief Validated object path, which locates its elements once when built so that they can
+ *        be read as views into the path without searching it again.
+ */
 class Path {
   public:
     explicit Path(const std::string& path = "/");
 
     operator std::string() const { return _path; }
+    std::string_view view() const { return _path; }
 
     bool operator<(const Path& other) const { return _path < other._path; }
     bool operator==(const Path& other) const { return _path == other._path; }
@@ -25,26 +32,43 @@ class Path {
     std::string next_child(const Path& base) const;
     std::string next_child_strip(const Path& base) const;
 
+    // Name of the element at `index`, without its separator.
+    std::string_view element(size_t index) const;
+    // Path made of the first `count` elements, "/" if `count` is zero.
+    std::string_view prefix(size_t count) const;
+
   private:
     std::string _path;
+
+    // Offset of the separator in front of every element.
+    std::vector<uint32_t> _offsets;
 };
 
+/**
+ * @brief Operations on object paths given as strings.
+ *
+ * The `_view` variants return views into the given path instead of new strings, and none of
+ * the functions taking views allocate.
+ */
 class PathUtils {
   public:
-    static size_t count_elements(const std::string& path);
-    static std::string fetch_elements(const std::string& path, size_t count);
-    static std::vector<std::string> split_elements(const std::string& path);
+    static size_t count_elements(std::string_view path);
+    static std::string fetch_elements(std::string_view path, size_t count);
+    static std::string_view fetch_elements_view(std::string_view path, size_t count);
+    static std::vector<std::string> split_elements(std::string_view path);
 
-    static bool is_descendant(const std::string& base, const std::string& path);
-    static bool is_ascendant(const std::string& base, const std::string& path);
+    static bool is_descendant(std::string_view base, std::string_view path);
+    static bool is_ascendant(std::string_view base, std::string_view path);
 
-    static bool is_child(const std::string& base, const std::string& path);
-    static bool is_parent(const std::string& base, const std::string& path);
+    static bool is_child(std::string_view base, std::string_view path);
+    static bool is_parent(std::string_view base, std::string_view path);
 
-    static std::string next_child(const std::string& base, const std::string& path);
-    static std::string next_child_strip(const std::string& base, const std::string& path);
+    static std::string next_child(std::string_view base, std::string_view path);
+    static std::string_view next_child_view(std::string_view base, std::string_view path);
+    static std::string next_child_strip(std::string_view base, std::string_view path);
+    static std::string_view next_child_strip_view(std::string_view base, std::string_view path);
 
-    static void validate(const std::string& path);
+    static void validate(std::string_view path);
 };
 
 }  // namespace SimpleDBus
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <dbus/dbus.h>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include "Message.h"
+
+namespace SimpleDBus {
+
+/**
+ * @brief A message captured by a recording, as seen by the recorded connection.
+ */
+struct RecordedMessage {
+    enum class Direction : uint8_t { RECEIVED = 0, SENT = 1 };
+
+    Direction direction;
+    std::chrono::nanoseconds timestamp;
+    Message message;
+};
+
+/**
+ * @brief Appends marshalled messages to a recording file.
+ *
+ * The file starts with the 8-byte magic "SDBUSREC" and a 32-bit format version, followed by
+ * one record per message: a 1-byte direction, a 64-bit monotonic timestamp in nanoseconds
+ * since the recording started, a 32-bit length and the message as marshalled by
+ * `dbus_message_marshal`. Integers are stored in host byte order.
+ */
+class RecordingWriter {
+  public:
+    static constexpr uint32_t VERSION = 1;
+
+    explicit RecordingWriter(const std::string& filename);
+
+    void write(RecordedMessage::Direction direction, DBusMessage* msg);
+    void flush();
+
+  private:
+    std::mutex _mutex;
+    std::ofstream _file;
+    std::chrono::steady_clock::time_point _start;
+};
+
+/**
+ * @brief Reads back the messages of a recording file, in the order they were recorded.
+ */
+class RecordingReader {
+  public:
+    explicit RecordingReader(const std::string& filename);
+
+    /**
+     * @brief Read the next message, returning false once the recording is exhausted.
+     */
+    bool next(RecordedMessage& record);
+
+  private:
+    std::ifstream _file;
+};
+
+}  // namespace SimpleDBus
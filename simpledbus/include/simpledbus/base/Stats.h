@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace SimpleDBus {
+
+/**
+ * @brief Latency histogram with logarithmic buckets, in microseconds.
+ */
+class Histogram {
+  public:
+    // Upper bound of every bucket but the last one, which collects everything above.
+    static constexpr std::array<uint64_t, 22> BOUNDS_US = {
+        1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000, 20000, 50000, 100000, 200000, 500000,
+        1000000, 2000000, 5000000, 10000000};
+
+    void record(uint64_t value_us);
+    void merge(const Histogram& other);
+
+    uint64_t count() const { return _count; }
+    uint64_t max_us() const { return _max_us; }
+    double mean_us() const;
+
+    /**
+     * @brief Upper bound of the bucket holding the given percentile, capped to the maximum.
+     */
+    uint64_t percentile_us(double pct) const;
+
+    const std::array<uint64_t, BOUNDS_US.size() + 1>& buckets() const { return _buckets; }
+
+  private:
+    std::array<uint64_t, BOUNDS_US.size() + 1> _buckets = {};
+    uint64_t _count = 0;
+    uint64_t _sum_us = 0;
+    uint64_t _max_us = 0;
+};
+
+struct ConnectionStats {
+    struct Traffic {
+        uint64_t messages = 0;
+        uint64_t bytes = 0;
+    };
+
+    struct QueueDepth {
+        uint64_t samples = 0;
+        uint64_t total = 0;
+        uint64_t max = 0;
+        uint64_t last = 0;
+
+        double mean() const { return samples == 0 ? 0 : static_cast<double>(total) / samples; }
+    };
+
+    // Keyed by message type ("method_call", "method_return", "error", "signal").
+    std::map<std::string, Traffic> received_by_type;
+    std::map<std::string, Traffic> sent_by_type;
+
+    // Keyed by interface, for the messages that carry one.
+    std::map<std::string, Traffic> received_by_interface;
+    std::map<std::string, Traffic> sent_by_interface;
+
+    // Round trip of method calls, keyed by "interface.member".
+    std::map<std::string, Histogram> call_latency;
+
+    // Time between the dispatch pass that picked up a message and libdbus handing it over.
+    Histogram dispatch_lag;
+
+    // Time spent by routed signals waiting for a dispatch worker.
+    Histogram worker_lag;
+
+    // Messages waiting in the incoming queue at the start of every dispatch pass.
+    QueueDepth queue_depth;
+
+    /**
+     * @brief Accumulate the statistics of another connection, e.g. to report several
+     *        connections serving the same client as one.
+     */
+    void merge(const ConnectionStats& other);
+};
+
+}  // namespace SimpleDBus
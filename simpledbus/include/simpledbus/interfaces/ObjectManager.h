@@ -14,6 +14,8 @@ class ObjectManager : public Interface {
 
     // Names are made matching the ones from the DBus specification
     Holder GetManagedObjects(bool use_callbacks = false);
+    // Reply of GetManagedObjects, to be read in place with a `Cursor` rather than decoded whole.
+    Message GetManagedObjectsReply();
     std::function<void(std::string path, Holder options)> InterfacesAdded;
     std::function<void(std::string path, Holder options)> InterfacesRemoved;
 
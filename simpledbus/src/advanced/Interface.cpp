@@ -1,33 +1,69 @@
 #include <simpledbus/advanced/Interface.h>
 #include <simpledbus/advanced/Proxy.h>
 #include <simpledbus/base/Exceptions.h>
+#include <simpledbus/base/Logging.h>
 #include <simpledbus/interfaces/Properties.h>
 
 using namespace SimpleDBus;
 
-Interface::Interface(std::shared_ptr<Connection> conn, std::shared_ptr<Proxy> proxy, const std::string& interface_name)
+Interface::Interface(std::shared_ptr<Connection> conn, std::shared_ptr<Proxy> proxy, const std::string& interface_name,
+                     const PropertyTable& property_table)
     : _conn(conn),
       _proxy(proxy),
       _bus_name(proxy->bus_name()),
       _path(proxy->path()),
       _interface_name(interface_name),
-      _loaded(true) {}
+      _loaded(true),
+      _property_table(property_table) {
+    _property_slots.reserve(_property_table.size());
+    for (PropertyId id = 0; id < _property_table.size(); id++) {
+        _property_slots.push_back({_property_table[id].initial, false});
+    }
+}
+
+Interface::~Interface() {
+    std::scoped_lock lock(_match_mutex);
+    for (const auto& rule : _match_rules) {
+        try {
+            _conn->remove_match(rule);
+        } catch (const std::exception&) {
+            // The connection might already be closed, in which case the rule is gone anyway.
+        }
+    }
+}
 
 std::shared_ptr<Proxy> Interface::proxy() const { return _proxy.lock(); }
 
 // ----- LIFE CYCLE -----
 
 void Interface::load(Holder options) {
+    std::vector<PropertyId> changed_ids;
+    std::vector<std::string> changed_names;
     _property_update_mutex.lock();
-    auto changed_options = options.get_dict_string();
-    for (auto& [name, value] : changed_options) {
-        _properties[name] = value;
-        _property_valid_map[name] = true;
+    for (auto& [key, value] : options.dict_take()) {
+        if (key.type() != Holder::STRING) {
+            continue;
+        }
+
+        PropertyId id = _property_table.find(key.get_string_view());
+        if (id != PropertyTable::npos) {
+            if (property_store(id, std::move(value))) {
+                changed_ids.push_back(id);
+            }
+            continue;
+        }
+
+        changed_names.push_back(key.get_string());
+        _properties[changed_names.back()] = std::move(value);
+        _property_valid_map[changed_names.back()] = true;
     }
     _property_update_mutex.unlock();
 
     // Notify the user of all properties that have been created.
-    for (auto& [name, value] : changed_options) {
+    for (PropertyId id : changed_ids) {
+        on_property_changed(id);
+    }
+    for (auto& name : changed_names) {
         property_changed(name);
     }
 
@@ -44,10 +80,22 @@ Message Interface::create_method_call(const std::string& method_name) {
     return Message::create_method_call(_bus_name, _path, _interface_name, method_name);
 }
 
+CallTemplate Interface::create_call_template(const std::string& method_name) const {
+    return CallTemplate(_bus_name, _path, _interface_name, method_name);
+}
+
 // ----- PROPERTIES -----
 
 void Interface::property_refresh(const std::string& property_name) {
-    if (!_loaded || !_property_valid_map[property_name]) {
+    PropertyId id = _property_table.find(property_name);
+    if (!_loaded) {
+        return;
+    } else if (id != PropertyTable::npos) {
+        std::scoped_lock lock(_property_update_mutex);
+        if (!_property_slots[id].valid) {
+            return;
+        }
+    } else if (!_property_valid_map[property_name]) {
         return;
     }
 
@@ -62,47 +110,197 @@ void Interface::property_refresh(const std::string& property_name) {
         Holder property_latest = properties_interface->Get(_interface_name, property_name);
 
         _property_update_mutex.lock();
-        _property_valid_map[property_name] = true;
-        if (_properties[property_name] != property_latest) {
-            _properties[property_name] = property_latest;
-            cb_property_changed_required = true;
+        if (id != PropertyTable::npos) {
+            cb_property_changed_required = property_store(id, std::move(property_latest));
+        } else {
+            _property_valid_map[property_name] = true;
+            Holder& property_cached = _properties[property_name];
+            if (!property_cached.same_value(property_latest)) {
+                property_cached = std::move(property_latest);
+                cb_property_changed_required = true;
+            }
         }
         _property_update_mutex.unlock();
     } catch (const Exception::SendFailed& e) {
         _property_update_mutex.lock();
-        _property_valid_map[property_name] = true;
+        if (id != PropertyTable::npos) {
+            _property_slots[id].valid = true;
+        } else {
+            _property_valid_map[property_name] = true;
+        }
         _property_update_mutex.unlock();
     }
 
     if (cb_property_changed_required) {
-        property_changed(property_name);
+        property_notify(id, property_name);
     }
 }
 
 void Interface::property_changed(std::string option_name) {}
 
+void Interface::on_property_changed(PropertyId id) { property_changed(std::string(_property_table[id].name)); }
+
+Holder Interface::property_collect() {
+    Holder properties = Holder::create_dict();
+    std::scoped_lock lock(_property_update_mutex);
+    for (PropertyId id = 0; id < _property_slots.size(); id++) {
+        if (_property_slots[id].valid) {
+            const PropertyTable::Entry& entry = _property_table[id];
+            properties.dict_append(Holder::STRING, std::string(entry.name),
+                                   entry.collect(_property_slots[id].value, entry.type));
+        }
+    }
+    for (const auto& [key, value] : _properties) {
+        properties.dict_append(Holder::STRING, key, value);
+    }
+    return properties;
+}
+
+bool Interface::property_assign(const std::string& property_name, Holder value) {
+    std::scoped_lock lock(_property_update_mutex);
+    PropertyId id = _property_table.find(property_name);
+    if (id != PropertyTable::npos) {
+        if (!_property_slots[id].valid || !_property_table.accepts(id, value)) {
+            return false;
+        }
+        _property_table[id].assign(_property_slots[id].value, std::move(value));
+        return true;
+    }
+
+    auto it = _properties.find(property_name);
+    if (it == _properties.end()) {
+        return false;
+    }
+    it->second = std::move(value);
+    return true;
+}
+
+bool Interface::property_store(PropertyId id, Holder&& value) {
+    const PropertyTable::Entry& entry = _property_table[id];
+    if (!_property_table.accepts(id, value)) {
+        LOG_WARN("Property {} of {} received with unexpected signature {}", entry.name, _interface_name,
+                 value.signature());
+        return false;
+    }
+
+    PropertySlot& slot = _property_slots[id];
+    bool modified = entry.assign(slot.value, std::move(value)) || !slot.valid;
+    slot.valid = true;
+    return modified || entry.event;
+}
+
+void Interface::property_notify(PropertyId id, const std::string& property_name) {
+    if (id != PropertyTable::npos) {
+        on_property_changed(id);
+    } else {
+        property_changed(property_name);
+    }
+}
+
+bool Interface::property_is_event(const std::string&) const { return false; }
+
+const Holder& Interface::property_view(std::string_view name) const {
+    static const Holder empty;
+    auto it = _properties.find(name);
+    return it != _properties.end() ? it->second : empty;
+}
+
 // ----- SIGNALS -----
 
 void Interface::signal_property_changed(Holder changed_properties, Holder invalidated_properties) {
+    std::vector<std::pair<std::string, Holder>> changed;
+    for (auto& [key, value] : changed_properties.dict_entries()) {
+        if (key.type() == Holder::STRING) {
+            changed.emplace_back(key.get_string(), value);
+        }
+    }
+
+    std::vector<std::string> invalidated;
+    for (const auto& removed_option : invalidated_properties.array_view()) {
+        invalidated.push_back(removed_option.get_string());
+    }
+
+    signal_property_changed(std::move(changed), invalidated);
+}
+
+void Interface::signal_property_changed(std::vector<std::pair<std::string, Holder>> changed_properties,
+                                        const std::vector<std::string>& invalidated_properties) {
+    // Properties updated to the value they already had are not reported again.
+    std::vector<bool> notify(changed_properties.size());
+    std::vector<PropertyId> ids(changed_properties.size());
+    bool modified = false;
+
     _property_update_mutex.lock();
-    auto changed_options = changed_properties.get_dict_string();
-    for (auto& [name, value] : changed_options) {
-        _properties[name] = value;
-        _property_valid_map[name] = true;
+    for (size_t i = 0; i < changed_properties.size(); i++) {
+        auto& [name, value] = changed_properties[i];
+        ids[i] = _property_table.find(name);
+        if (ids[i] != PropertyTable::npos) {
+            notify[i] = property_store(ids[i], std::move(value));
+            modified = modified || notify[i];
+            continue;
+        }
+
+        bool& valid = _property_valid_map[name];
+        auto it = _properties.find(name);
+        bool unchanged = valid && it != _properties.end() && it->second.same_value(value);
+        if (!unchanged) {
+            _properties.insert_or_assign(name, std::move(value));
+        }
+        valid = true;
+        notify[i] = !unchanged || property_is_event(name);
+        modified = modified || notify[i];
     }
 
-    auto removed_options = invalidated_properties.get_array();
-    for (auto& removed_option : removed_options) {
-        _property_valid_map[removed_option.get_string()] = false;
+    for (const auto& removed_option : invalidated_properties) {
+        PropertyId id = _property_table.find(removed_option);
+        bool& valid = id != PropertyTable::npos ? _property_slots[id].valid : _property_valid_map[removed_option];
+        modified = modified || valid;
+        valid = false;
     }
     _property_update_mutex.unlock();
 
+    if (modified) {
+        std::shared_ptr<Proxy> owner = proxy();
+        if (owner) {
+            owner->_property_revision++;
+        }
+    }
+
     // Once all properties have been updated, notify the user.
-    for (auto& [name, value] : changed_options) {
-        property_changed(name);
+    for (size_t i = 0; i < changed_properties.size(); i++) {
+        if (notify[i]) {
+            property_notify(ids[i], changed_properties[i].first);
+        }
     }
 }
 
 // ----- MESSAGES -----
 
 void Interface::message_handle(Message& msg) {}
+
+// ----- MATCH RULES -----
+
+void Interface::match_add(const std::string& rule) {
+    std::scoped_lock lock(_match_mutex);
+    if (_match_rules.count(rule) == 0) {
+        _conn->add_match(rule);
+        _match_rules.insert(rule);
+    }
+}
+
+void Interface::match_remove(const std::string& rule) {
+    std::scoped_lock lock(_match_mutex);
+    if (_match_rules.erase(rule) > 0) {
+        _conn->remove_match(rule);
+    }
+}
+
+std::string Interface::match_properties_changed(bool path_namespace, const std::string& interface) const {
+    std::string rule = "type='signal',sender='" + _bus_name +
+                       "',interface='org.freedesktop.DBus.Properties',member='PropertiesChanged'," +
+                       (path_namespace ? "path_namespace='" : "path='") + _path + "'";
+    if (!interface.empty()) {
+        rule += ",arg0='" + interface + "'";
+    }
+    return rule;
+}
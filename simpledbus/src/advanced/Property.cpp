@@ -0,0 +1,31 @@
+#include <simpledbus/advanced/Property.h>
+
+#include <algorithm>
+
+using namespace SimpleDBus;
+
+const PropertyTable& PropertyTable::none() {
+    static const PropertyTable table;
+    return table;
+}
+
+PropertyId PropertyTable::find(std::string_view name) const {
+    auto it = std::lower_bound(_index.begin(), _index.end(), name,
+                               [](const auto& entry, std::string_view key) { return entry.first < key; });
+    if (it == _index.end() || it->first != name) {
+        return npos;
+    }
+    return it->second;
+}
+
+bool PropertyTable::accepts(PropertyId id, const Holder& value) const {
+    return _entries[id].type == Holder::NONE || _entries[id].type == value.type();
+}
+
+void PropertyTable::_index_build() {
+    _index.reserve(_entries.size());
+    for (PropertyId id = 0; id < _entries.size(); id++) {
+        _index.emplace_back(_entries[id].name, id);
+    }
+    std::sort(_index.begin(), _index.end());
+}
@@ -6,13 +6,14 @@
 #include <simpledbus/base/Path.h>
 #include <algorithm>
 #include <iostream>
+#include <utility>
 
 #include <simpledbus/interfaces/Properties.h>
 
 using namespace SimpleDBus;
 
 Proxy::Proxy(std::shared_ptr<Connection> conn, const std::string& bus_name, const std::string& path)
-    : _conn(conn), _bus_name(bus_name), _path(path), _valid(true), _registered(false) {
+    : _conn(conn), _bus_name(bus_name), _path(path), _valid(true), _registered(false), _exported(false) {
     }
 
 Proxy::~Proxy() {
@@ -43,21 +44,30 @@ std::string Proxy::path() const { return _path; }
 
 std::string Proxy::bus_name() const { return _bus_name; }
 
-const std::map<std::string, std::shared_ptr<Proxy>>& Proxy::children() { return _children; }
+const std::map<std::string, std::shared_ptr<Proxy>, std::less<>>& Proxy::children() { return _children; }
 
 const std::map<std::string, std::shared_ptr<Interface>>& Proxy::interfaces() { return _interfaces; }
 
 // ----- PATH HANDLING -----
 
-void Proxy::register_object_path() {
-    if (!_registered && _conn &&
-        _conn->register_object_path(_path, [this](Message& msg) { this->message_handle(msg); })) {
+void Proxy::register_object_path(bool exported) {
+    if (_registered || !_conn) {
+        return;
+    }
+
+    auto handler = [this](Message& msg) { this->message_handle(msg); };
+    if (exported ? _conn->register_object_path(_path, handler) : _conn->register_signal_handler(_path, handler)) {
         _registered = true;
+        _exported = exported;
     }
 }
 
 void Proxy::unregister_object_path() {
-    if (_registered && _conn && _conn->unregister_object_path(_path)) {
+    if (!_registered || !_conn) {
+        return;
+    }
+
+    if (_exported ? _conn->unregister_object_path(_path) : _conn->unregister_signal_handler(_path)) {
         _registered = false;
     }
 }
@@ -97,20 +107,24 @@ size_t Proxy::interfaces_count() {
 }
 
 void Proxy::interfaces_load(Holder managed_interfaces) {
-    auto managed_interface = managed_interfaces.get_dict_string();
-
     std::scoped_lock lock(_interface_access_mutex);
-    for (auto& [iface_name, options] : managed_interface) {
+    for (auto& [key, options] : managed_interfaces.dict_take()) {
+        if (key.type() != Holder::STRING) {
+            continue;
+        }
+
+        std::string iface_name = key.get_string();
         // If the interface has not been loaded, load it
         if (!interface_exists(iface_name)) {
             if (InterfaceRegistry::getInstance().isRegistered(iface_name)) {
                 _interfaces.emplace(std::make_pair(
-                    iface_name, InterfaceRegistry::getInstance().create(iface_name, _conn, shared_from_this(), options)));
+                    iface_name,
+                    InterfaceRegistry::getInstance().create(iface_name, _conn, shared_from_this(), std::move(options))));
             } else {
                 LOG_WARN("Interface {} not registered within SimpleDBus", iface_name);
             }
         } else {
-            _interfaces[iface_name]->load(options);
+            _interfaces[iface_name]->load(std::move(options));
         }
     }
 }
@@ -121,12 +135,12 @@ void Proxy::interfaces_reload(Holder managed_interfaces) {
         interface->unload();
     }
 
-    interfaces_load(managed_interfaces);
+    interfaces_load(std::move(managed_interfaces));
 }
 
 void Proxy::interfaces_unload(SimpleDBus::Holder removed_interfaces) {
     std::scoped_lock lock(_interface_access_mutex);
-    for (auto& option : removed_interfaces.get_array()) {
+    for (const auto& option : removed_interfaces.array_view()) {
         std::string iface_name = option.get_string();
         if (interface_exists(iface_name)) {
             _interfaces[iface_name]->unload();
@@ -159,6 +173,11 @@ std::shared_ptr<Proxy> Proxy::path_get(const std::string& path) {
     return _children[path];
 }
 
+std::shared_ptr<Proxy> Proxy::path_lookup(const std::string& path) {
+    std::shared_ptr<Proxy> proxy = path_index_closest(path);
+    return proxy && proxy->_path == path ? proxy : nullptr;
+}
+
 void Proxy::path_add(const std::string& path, SimpleDBus::Holder managed_interfaces) {
     // If the path is not a child of the current path, then we can't add it.
     if (!PathUtils::is_descendant(_path, path)) {
@@ -166,42 +185,48 @@ void Proxy::path_add(const std::string& path, SimpleDBus::Holder managed_interfa
         return;
     }
 
-    // If the path is already in the map, perform a reload of all interfaces.
-    if (path_exists(path)) {
-        path_get(path)->interfaces_load(managed_interfaces);
-        return;
+    std::shared_ptr<Proxy> closest = path_index_closest(path);
+    if (!closest) {
+        // None of the proxies between this one and the path exist yet.
+        path_insert(path, std::move(managed_interfaces));
+    } else if (closest->_path == path) {
+        // If the path already exists, load the new interfaces into it.
+        closest->interfaces_load(std::move(managed_interfaces));
+    } else {
+        closest->path_insert(path, std::move(managed_interfaces));
     }
+}
 
+void Proxy::path_insert(const std::string& path, SimpleDBus::Holder managed_interfaces) {
     // As children will be extensively accessed, we need to lock the child access mutex.
     std::scoped_lock lock(_child_access_mutex);
 
-    if (PathUtils::is_child(_path, path)) {
-        // If the path is a direct child of the proxy path, create a new proxy for it.
-        std::shared_ptr<Proxy> child = path_create(path);
-        child->interfaces_load(managed_interfaces);
-        _children.emplace(std::make_pair(path, child));
-        on_child_created(path);
-    } else {
-        // If the new path is for a descendant of the current proxy, check if there is a child proxy for it.
-        auto child_result = std::find_if(
-            _children.begin(), _children.end(),
-            [path](const std::pair<std::string, std::shared_ptr<Proxy>>& child_data) -> bool {
-                return PathUtils::is_descendant(child_data.first, path);
-            });
-
-        if (child_result != _children.end()) {
-            // If there is a child proxy for the new path, forward it to that child proxy.
-            child_result->second->path_add(path, managed_interfaces);
+    std::string_view child_path = PathUtils::next_child_view(_path, path);
+    auto child_result = _children.find(child_path);
+    if (child_result != _children.end()) {
+        // If there is a child proxy for the new path, forward it to that child proxy.
+        if (child_path == path) {
+            child_result->second->interfaces_load(std::move(managed_interfaces));
         } else {
-            // If there is no child proxy for the new path, create the child and forward the path to it.
-            // This path will be taken if an empty proxy object needs to be created for an intermediate path.
-            std::string child_path = PathUtils::next_child(_path, path);
-            std::shared_ptr<Proxy> child = path_create(child_path);
-            _children.emplace(std::make_pair(child_path, child));
-            child->path_add(path, managed_interfaces);
-            on_child_created(child_path);
+            child_result->second->path_insert(path, std::move(managed_interfaces));
         }
+        return;
     }
+
+    std::shared_ptr<Proxy> child = path_create(std::string(child_path));
+    if (child_path == path) {
+        // If the path is a direct child of the proxy path, create a new proxy for it.
+        child->interfaces_load(std::move(managed_interfaces));
+        _children.emplace(child->_path, child);
+        path_index_insert(child);
+    } else {
+        // If there is no child proxy for the new path, create the child and forward the path to it.
+        // This path will be taken if an empty proxy object needs to be created for an intermediate path.
+        _children.emplace(child->_path, child);
+        path_index_insert(child);
+        child->path_insert(path, std::move(managed_interfaces));
+    }
+    on_child_created(child->_path);
 }
 
 bool Proxy::path_remove(const std::string& path, SimpleDBus::Holder options) {
@@ -218,22 +243,37 @@ bool Proxy::path_remove(const std::string& path, SimpleDBus::Holder options) {
         return false;
     }
 
+    // The removal is carried out by the parent of the path, found through the index.
+    std::string_view parent_path = std::string_view(path).substr(0, std::max<size_t>(path.rfind('/'), 1));
+    if (parent_path == _path) {
+        path_erase(path, options);
+    } else {
+        std::shared_ptr<Proxy> parent = path_lookup(std::string(parent_path));
+        if (parent) {
+            parent->path_erase(path, options);
+        }
+    }
+
+    return false;
+}
+
+void Proxy::path_erase(std::string_view path, const SimpleDBus::Holder& options) {
     // As children will be extensively accessed, we need to lock the child access mutex.
     std::scoped_lock lock(_child_access_mutex);
 
-    // If the path is a direct child of the proxy path, forward the request to the child proxy.
-    std::string child_path = PathUtils::next_child(_path, path);
-    if (path_exists(child_path)) {
-        bool must_erase = _children.at(child_path)->path_remove(path, options);
-
-        // if the child proxy is no longer needed and there is only one active instance of the child proxy,
-        // then remove it.
-        if (must_erase && _children.at(child_path).use_count() == 1) {
-            _children.erase(child_path);
-        }
+    auto child_result = _children.find(path);
+    if (child_result == _children.end()) {
+        return;
     }
 
-    return false;
+    bool must_erase = child_result->second->path_remove(child_result->first, options);
+
+    // if the child proxy is no longer needed and there is only one active instance of the child proxy,
+    // then remove it.
+    if (must_erase && child_result->second.use_count() == 1) {
+        path_index_erase(child_result->second);
+        _children.erase(child_result);
+    }
 }
 
 bool Proxy::path_prune() {
@@ -248,6 +288,7 @@ bool Proxy::path_prune() {
         }
     }
     for (auto& child_path : to_remove) {
+        path_index_erase(_children.at(child_path));
         _children.erase(child_path);
     }
 
@@ -267,25 +308,18 @@ Holder Proxy::path_collect() {
     SimpleDBus::Holder interfaces = SimpleDBus::Holder::create_dict();
 
     for (const auto& [interface_name, interface_ptr] : _interfaces) {
-        SimpleDBus::Holder properties = SimpleDBus::Holder::create_dict();
-        {
-            std::scoped_lock lock(interface_ptr->_property_update_mutex);
-            for (const auto& [key, value] : interface_ptr->_properties) {
-                properties.dict_append(SimpleDBus::Holder::Type::STRING, key, value);
-            }
-        }
-        interfaces.dict_append(SimpleDBus::Holder::Type::STRING, interface_name, std::move(properties));
+        interfaces.dict_append(SimpleDBus::Holder::Type::STRING, interface_name, interface_ptr->property_collect());
     }
 
-    if (!interfaces.get_dict_string().empty()) {
+    if (!interfaces.dict_entries().empty()) {
         result.dict_append(SimpleDBus::Holder::Type::OBJ_PATH, _path, std::move(interfaces));
     }
 
     for (const auto& [child_path, child] : _children) {
         SimpleDBus::Holder child_result = child->path_collect();
         // Merge child_result into result
-        for (auto&& [path, child_interfaces] : child_result.get_dict_object_path()) {
-            result.dict_append(SimpleDBus::Holder::Type::OBJ_PATH, std::move(path), std::move(child_interfaces));
+        for (const auto& [path, child_interfaces] : child_result.dict_entries()) {
+            result.dict_append(path, child_interfaces);
         }
     }
     return std::move(result);
@@ -304,7 +338,9 @@ void Proxy::path_append_child(const std::string& path, std::shared_ptr<Proxy> ch
 
     // As children will be extensively accessed, we need to lock the child access mutex.
     std::scoped_lock lock(_child_access_mutex);
-    _children.emplace(std::make_pair(path, child));
+    if (_children.emplace(std::make_pair(path, child)).second) {
+        path_index_insert(child);
+    }
 }
 
 void Proxy::path_remove_child(const std::string& path) {
@@ -317,13 +353,92 @@ void Proxy::path_remove_child(const std::string& path) {
     }
 
     std::scoped_lock lock(_child_access_mutex);
-    _children.erase(path);
+    auto child_result = _children.find(path);
+    if (child_result != _children.end()) {
+        path_index_erase(child_result->second);
+        _children.erase(child_result);
+    }
+}
+
+// ----- PATH INDEX -----
+
+std::shared_ptr<Proxy::PathIndex> Proxy::path_index() {
+    std::scoped_lock lock(_child_access_mutex);
+    if (!_path_index) {
+        // The index is created by the root of the tree, the first time it is needed.
+        _path_index = std::make_shared<PathIndex>();
+        _path_index->proxies.emplace(_path, weak_from_this());
+    }
+    return _path_index;
+}
+
+std::shared_ptr<Proxy> Proxy::path_index_closest(const std::string& path) {
+    // Walks up from the path itself, stopping short of this proxy.
+    std::shared_ptr<PathIndex> index = path_index();
+    std::scoped_lock lock(index->mutex);
+
+    std::string current = path;
+    while (PathUtils::is_descendant(_path, current)) {
+        auto entry = index->proxies.find(current);
+        if (entry != index->proxies.end()) {
+            if (std::shared_ptr<Proxy> proxy = entry->second.lock()) {
+                return proxy;
+            }
+        }
+        current.erase(std::max<size_t>(current.rfind('/'), 1));
+    }
+    return nullptr;
+}
+
+void Proxy::path_index_insert(const std::shared_ptr<Proxy>& child) {
+    std::shared_ptr<PathIndex> index = path_index();
+
+    // A child that was built separately brings along the proxies indexed below it.
+    std::shared_ptr<PathIndex> child_index;
+    {
+        std::scoped_lock child_lock(child->_child_access_mutex);
+        child_index = std::exchange(child->_path_index, index);
+    }
+
+    std::scoped_lock lock(index->mutex);
+    if (child_index && child_index != index) {
+        std::scoped_lock child_index_lock(child_index->mutex);
+        for (auto& [path, proxy] : child_index->proxies) {
+            if (auto descendant = proxy.lock()) {
+                descendant->_path_index = index;
+                index->proxies.insert_or_assign(path, std::move(proxy));
+            }
+        }
+    }
+    index->proxies.insert_or_assign(child->_path, child);
+}
+
+void Proxy::path_index_erase(const std::shared_ptr<Proxy>& child) {
+    std::shared_ptr<PathIndex> index = path_index();
+
+    // The proxies below the child leave the index along with it.
+    auto erase = [&index](const std::shared_ptr<Proxy>& proxy, auto& erase_descendants) -> void {
+        {
+            std::scoped_lock lock(index->mutex);
+            auto entry = index->proxies.find(proxy->_path);
+            if (entry != index->proxies.end() && entry->second.lock() == proxy) {
+                index->proxies.erase(entry);
+            }
+        }
+
+        std::scoped_lock child_lock(proxy->_child_access_mutex);
+        for (auto& [descendant_path, descendant] : proxy->_children) {
+            erase_descendants(descendant, erase_descendants);
+        }
+    };
+    erase(child, erase);
 }
 
 // ----- MESSAGE HANDLING -----
 
 void Proxy::message_handle(Message& msg) {
     bool handled = false;
+    uint64_t property_revision = _property_revision;
 
     // ! This is the only block that should be used to forward messages to interfaces.
     if (interface_exists(msg.get_interface())) {
@@ -333,7 +448,10 @@ void Proxy::message_handle(Message& msg) {
         LOG_WARN("Unhandled message for interface {}: {}", msg.get_interface(), msg.to_string());
     }
 
-    if (msg.get_type() == Message::Type::SIGNAL) {
+    // PropertiesChanged signals that leave every property as it was are not reported.
+    bool redundant = msg.is_signal("org.freedesktop.DBus.Properties", "PropertiesChanged") &&
+                     _property_revision == property_revision;
+    if (msg.get_type() == Message::Type::SIGNAL && !redundant) {
         on_signal_received();
     }
 
@@ -0,0 +1,241 @@
+#include <simpledbus/advanced/Replayer.h>
+
+#include <simpledbus/base/Exceptions.h>
+#include <simpledbus/base/Logging.h>
+
+#include <poll.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using namespace SimpleDBus;
+
+static bool same_field(const char* a, const char* b) {
+    return (a == nullptr && b == nullptr) || (a != nullptr && b != nullptr && std::strcmp(a, b) == 0);
+}
+
+static bool is_bus_driver_call(DBusMessage* msg) {
+    const char* destination = dbus_message_get_destination(msg);
+    return dbus_message_get_type(msg) == DBUS_MESSAGE_TYPE_METHOD_CALL &&
+           (same_field(destination, DBUS_SERVICE_DBUS) || same_field(dbus_message_get_interface(msg), DBUS_INTERFACE_DBUS));
+}
+
+Replayer::Replayer(const std::string& filename) : _filename(filename) {
+    // Validate the recording upfront, so that errors surface to the caller.
+    RecordingReader reader(_filename);
+
+    dbus_threads_init_default();
+
+    ::DBusError err;
+    dbus_error_init(&err);
+    _server = dbus_server_listen("unix:tmpdir=/tmp", &err);
+    if (dbus_error_is_set(&err)) {
+        std::string err_name = err.name;
+        std::string err_message = err.message;
+        dbus_error_free(&err);
+        throw Exception::DBusException(err_name, err_message);
+    }
+
+    dbus_server_set_new_connection_function(_server, &Replayer::static_new_connection, this, nullptr);
+    dbus_server_set_watch_functions(_server, &Replayer::static_add_watch, &Replayer::static_remove_watch, nullptr, this,
+                                    nullptr);
+}
+
+Replayer::~Replayer() {
+    _active = false;
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+
+    if (_peer != nullptr) {
+        dbus_connection_close(_peer);
+        dbus_connection_unref(_peer);
+    }
+
+    dbus_server_disconnect(_server);
+    dbus_server_unref(_server);
+}
+
+std::string Replayer::address() const {
+    char* address = dbus_server_get_address(_server);
+    std::string result = address;
+    dbus_free(address);
+    return result;
+}
+
+void Replayer::start(double speed) {
+    if (_active) {
+        return;
+    }
+
+    _speed = speed;
+    _active = true;
+    _thread = std::thread(&Replayer::_run, this);
+}
+
+void Replayer::wait() {
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+void Replayer::_run() {
+    if (!_accept(std::chrono::seconds(10))) {
+        LOG_ERROR("No connection was made to {}", address());
+        _active = false;
+        return;
+    }
+
+    RecordingReader reader(_filename);
+    RecordedMessage record;
+    bool first = true;
+    std::chrono::nanoseconds first_timestamp{0};
+    auto start = std::chrono::steady_clock::now();
+
+    while (_active && reader.next(record)) {
+        if (first) {
+            first_timestamp = record.timestamp;
+            first = false;
+        }
+
+        if (record.direction == RecordedMessage::Direction::SENT) {
+            // Only method calls need to be matched, as their replies are delivered later on.
+            if (record.message.get_type() == Message::Type::METHOD_CALL && !is_bus_driver_call(record.message) &&
+                !_await_call(record.message)) {
+                _skipped++;
+            }
+            continue;
+        }
+
+        if (_speed > 0) {
+            auto due = start + std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   (record.timestamp - first_timestamp) / _speed);
+            while (_active && std::chrono::steady_clock::now() < due) {
+                auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(due -
+                                                                                       std::chrono::steady_clock::now());
+                _pump(static_cast<int>(std::max<int64_t>(0, remaining.count())));
+            }
+        }
+
+        _replay_received(record.message);
+        _pump(0);
+    }
+
+    dbus_connection_flush(_peer);
+    _active = false;
+}
+
+bool Replayer::_accept(std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (_active && _peer == nullptr && std::chrono::steady_clock::now() < deadline) {
+        std::vector<pollfd> fds;
+        for (auto* watch : _server_watches) {
+            if (dbus_watch_get_enabled(watch)) {
+                fds.push_back({dbus_watch_get_unix_fd(watch), POLLIN, 0});
+            }
+        }
+
+        if (poll(fds.data(), fds.size(), 100) <= 0) {
+            continue;
+        }
+
+        // NOTE: Handling a watch can modify the list of watches, so they are handled by descriptor.
+        for (auto& fd : fds) {
+            if (fd.revents == 0) {
+                continue;
+            }
+
+            auto it = std::find_if(_server_watches.begin(), _server_watches.end(),
+                                   [&fd](DBusWatch* watch) { return dbus_watch_get_unix_fd(watch) == fd.fd; });
+            if (it != _server_watches.end()) {
+                dbus_watch_handle(*it, DBUS_WATCH_READABLE);
+            }
+        }
+    }
+
+    return _peer != nullptr;
+}
+
+void Replayer::_pump(int timeout_ms) {
+    dbus_connection_read_write(_peer, timeout_ms);
+
+    for (DBusMessage* msg = dbus_connection_pop_message(_peer); msg != nullptr;
+         msg = dbus_connection_pop_message(_peer)) {
+        Message live = Message::from_acquired(msg);
+        if (is_bus_driver_call(live)) {
+            // There is no bus, so match rules and the like are simply acknowledged.
+            Message reply = Message::create_method_return(live);
+            dbus_connection_send(_peer, reply, nullptr);
+        } else if (live.get_type() == Message::Type::METHOD_CALL) {
+            _live_calls.push_back(std::move(live));
+        }
+    }
+
+    dbus_connection_flush(_peer);
+}
+
+bool Replayer::_await_call(const Message& recorded) {
+    auto matches = [&recorded](const Message& live) {
+        return same_field(dbus_message_get_path(live), dbus_message_get_path(recorded)) &&
+               same_field(dbus_message_get_interface(live), dbus_message_get_interface(recorded)) &&
+               same_field(dbus_message_get_member(live), dbus_message_get_member(recorded));
+    };
+
+    auto deadline = std::chrono::steady_clock::now() + call_timeout;
+    while (_active) {
+        auto it = std::find_if(_live_calls.begin(), _live_calls.end(), matches);
+        if (it != _live_calls.end()) {
+            _calls.push_back({recorded.get_serial(), it->get_serial()});
+            _live_calls.erase(it);
+            return true;
+        }
+
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        _pump(10);
+    }
+
+    return false;
+}
+
+void Replayer::_replay_received(Message& recorded) {
+    // NOTE: Copies of a Message share the recorded message, which sending locks. A duplicate is
+    //       not locked and has no serial, so it can be adjusted and sent again.
+    Message msg = Message::from_acquired(dbus_message_copy(recorded));
+
+    auto type = recorded.get_type();
+    if (type == Message::Type::METHOD_RETURN || type == Message::Type::ERROR) {
+        uint32_t reply_serial = dbus_message_get_reply_serial(recorded);
+        auto it = std::find_if(_calls.begin(), _calls.end(),
+                               [reply_serial](const CallMapping& call) { return call.recorded == reply_serial; });
+        if (it == _calls.end()) {
+            // Replies to bus driver calls, or to calls that were never made.
+            return;
+        }
+
+        dbus_message_set_reply_serial(msg, it->live);
+        _calls.erase(it);
+    }
+
+    dbus_message_set_destination(msg, nullptr);
+    dbus_connection_send(_peer, msg, nullptr);
+    _delivered++;
+}
+
+dbus_bool_t Replayer::static_add_watch(DBusWatch* watch, void* data) {
+    static_cast<Replayer*>(data)->_server_watches.push_back(watch);
+    return true;
+}
+
+void Replayer::static_remove_watch(DBusWatch* watch, void* data) {
+    auto& watches = static_cast<Replayer*>(data)->_server_watches;
+    watches.erase(std::remove(watches.begin(), watches.end(), watch), watches.end());
+}
+
+void Replayer::static_new_connection(DBusServer*, DBusConnection* conn, void* data) {
+    auto* replayer = static_cast<Replayer*>(data);
+    if (replayer->_peer == nullptr) {
+        replayer->_peer = dbus_connection_ref(conn);
+    }
+}
@@ -0,0 +1,25 @@
+#include <simpledbus/base/CallTemplate.h>
+
+#include <stdexcept>
+
+using namespace SimpleDBus;
+
+CallTemplate::CallTemplate(const std::string& bus_name, const std::string& path, const std::string& interface,
+                           const std::string& method)
+    : _prototype(Message::create_method_call(bus_name, path, interface, method)) {}
+
+bool CallTemplate::is_valid() const { return _prototype.is_valid(); }
+
+Message CallTemplate::_duplicate() const {
+    if (!_prototype.is_valid()) {
+        return Message();
+    }
+
+    // Calls are never sent as the prototype itself, as sending locks a message and assigns it
+    // a serial. Duplicates are unlocked and get their own serial when sent.
+    DBusMessage* msg = dbus_message_copy(_prototype);
+    if (msg == nullptr) {
+        throw std::runtime_error("Failed to copy DBusMessage out of a call template");
+    }
+    return Message::from_acquired(msg);
+}
@@ -1,15 +1,26 @@
 #include <simpledbus/base/Connection.h>
 #include <simpledbus/base/Exceptions.h>
 #include <simpledbus/base/Logging.h>
+#include <simpledbus/base/Path.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
 #include <chrono>
+#include <cstring>
+#include <stdexcept>
 #include <thread>
 
-
-
 using namespace SimpleDBus;
 
+// Time libdbus waits for a reply when given `DBUS_TIMEOUT_USE_DEFAULT`.
+static constexpr std::chrono::milliseconds DEFAULT_REPLY_TIMEOUT{25000};
+
 Connection::Connection(DBusBusType dbus_bus_type) : _dbus_bus_type(dbus_bus_type) {}
 
+Connection::Connection(const std::string& address) : _dbus_bus_type(DBUS_BUS_SESSION), _address(address) {}
+
 Connection::~Connection() {
     if (_initialized) {
         uninit();
@@ -27,13 +38,51 @@ void Connection::init() {
     dbus_error_init(&err);
 
     dbus_threads_init_default();
-    _conn = dbus_bus_get(_dbus_bus_type, &err);
+
+    // NOTE: A private connection is used as we take over the main loop integration of the
+    // connection, which would otherwise conflict with any other user of the shared connection.
+    if (_address.empty()) {
+        _conn = dbus_bus_get_private(_dbus_bus_type, &err);
+    } else {
+        _conn = dbus_connection_open_private(_address.c_str(), &err);
+    }
     if (dbus_error_is_set(&err)) {
         std::string err_name = err.name;
         std::string err_message = err.message;
         dbus_error_free(&err);
         throw Exception::DBusException(err_name, err_message);
     }
+
+    _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    _wakeup_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (_epoll_fd < 0 || _wakeup_fd < 0) {
+        std::string err_message = strerror(errno);
+        if (_epoll_fd >= 0) close(_epoll_fd);
+        if (_wakeup_fd >= 0) close(_wakeup_fd);
+        _epoll_fd = -1;
+        _wakeup_fd = -1;
+        dbus_connection_close(_conn);
+        dbus_connection_unref(_conn);
+        throw std::runtime_error("Failed to create event loop: " + err_message);
+    }
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = _wakeup_fd;
+    epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _wakeup_fd, &event);
+
+    dbus_connection_set_watch_functions(_conn, &Connection::static_add_watch, &Connection::static_remove_watch,
+                                        &Connection::static_toggle_watch, this, nullptr);
+    dbus_connection_set_timeout_functions(_conn, &Connection::static_add_timeout, &Connection::static_remove_timeout,
+                                          &Connection::static_toggle_timeout, this, nullptr);
+    dbus_connection_set_wakeup_main_function(_conn, &Connection::static_wakeup_main, this, nullptr);
+    dbus_connection_set_dispatch_status_function(_conn, &Connection::static_dispatch_status, this, nullptr);
+
+    // NOTE: Filters run in the order they were added, so statistics see every message first.
+    dbus_connection_add_filter(_conn, &Connection::static_stats_filter, this, nullptr);
+    dbus_connection_add_filter(_conn, &Connection::static_signal_filter, this, nullptr);
+    _dispatch_workers_start();
+
     _initialized = true;
 }
 
@@ -52,7 +101,35 @@ void Connection::uninit() {
         read_write_dispatch();
     } while (message.is_valid());
 
+    // Release anyone still waiting for a reply that will never arrive.
+    cancel_pending_calls("/");
+    _dispatch_thread = std::thread::id();
+
+    // Any call made by a handler from now on reads its own reply, so workers can be drained.
+    _dispatch_workers_stop();
+
+    dbus_connection_remove_filter(_conn, &Connection::static_signal_filter, this);
+    dbus_connection_remove_filter(_conn, &Connection::static_stats_filter, this);
+
+    // Detach the event loop before releasing the connection.
+    dbus_connection_set_dispatch_status_function(_conn, nullptr, nullptr, nullptr);
+    dbus_connection_set_wakeup_main_function(_conn, nullptr, nullptr, nullptr);
+    dbus_connection_set_timeout_functions(_conn, nullptr, nullptr, nullptr, nullptr, nullptr);
+    dbus_connection_set_watch_functions(_conn, nullptr, nullptr, nullptr, nullptr, nullptr);
+
+    dbus_connection_close(_conn);
     dbus_connection_unref(_conn);
+
+    close(_wakeup_fd);
+    close(_epoll_fd);
+    _wakeup_fd = -1;
+    _epoll_fd = -1;
+    _watches.clear();
+    _timeouts.clear();
+    _match_rules.clear();
+    _held_signals.clear();
+    _released_signals.clear();
+
     _initialized = false;
 }
 
@@ -63,7 +140,10 @@ void Connection::add_match(std::string rule) {
         throw Exception::NotInitialized();
     }
 
-    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    std::scoped_lock lock(_match_mutex);
+    if (_match_rules[rule]++ > 0) {
+        return;
+    }
 
     ::DBusError err;
     dbus_error_init(&err);
@@ -71,6 +151,8 @@ void Connection::add_match(std::string rule) {
     dbus_bus_add_match(_conn, rule.c_str(), &err);
     dbus_connection_flush(_conn);
     if (dbus_error_is_set(&err)) {
+        _match_rules.erase(rule);
+
         std::string err_name = err.name;
         std::string err_message = err.message;
         dbus_error_free(&err);
@@ -83,19 +165,17 @@ void Connection::remove_match(std::string rule) {
         throw Exception::NotInitialized();
     }
 
-    std::lock_guard<std::recursive_mutex> lock(_mutex);
-
-    ::DBusError err;
-    dbus_error_init(&err);
+    std::scoped_lock lock(_match_mutex);
+    auto it = _match_rules.find(rule);
+    if (it == _match_rules.end() || --it->second > 0) {
+        return;
+    }
+    _match_rules.erase(it);
 
-    dbus_bus_remove_match(_conn, rule.c_str(), &err);
+    // NOTE: Without an error object the request does not wait for a reply, which allows
+    //       rules to be removed from within message handlers.
+    dbus_bus_remove_match(_conn, rule.c_str(), nullptr);
     dbus_connection_flush(_conn);
-    if (dbus_error_is_set(&err)) {
-        std::string err_name = err.name;
-        std::string err_message = err.message;
-        dbus_error_free(&err);
-        throw Exception::DBusException(err_name, err_message);
-    }
 }
 
 void Connection::read_write() {
@@ -103,8 +183,6 @@ void Connection::read_write() {
         throw Exception::NotInitialized();
     }
 
-    std::lock_guard<std::recursive_mutex> lock(_mutex);
-
     // Non blocking read of the next available message
     dbus_connection_read_write(_conn, 0);
 }
@@ -114,21 +192,118 @@ void Connection::read_write_dispatch() {
         throw Exception::NotInitialized();
     }
 
-    std::lock_guard<std::recursive_mutex> lock(_mutex);
-
     // Non-blocking read of the next available message
     dbus_connection_read_write(_conn, 0);
 
     // Dispatch incoming messages
-    while (dbus_connection_dispatch(_conn) == DBUS_DISPATCH_DATA_REMAINS) {}
+    std::lock_guard<std::recursive_mutex> lock(_dispatch_mutex);
+    _dispatch_thread = std::this_thread::get_id();
+    _dispatch_pass_start = std::chrono::steady_clock::now();
+
+    // Released signals go ahead of any message dispatched after their route was registered.
+    _dispatch_released();
+    if (!_stats_enabled) {
+        while (dbus_connection_dispatch(_conn) == DBUS_DISPATCH_DATA_REMAINS) {
+            _dispatch_released();
+        }
+        return;
+    }
+
+    // Every dispatched message leaves the incoming queue, so counting them samples its depth.
+    uint64_t depth = 0;
+    if (dbus_connection_get_dispatch_status(_conn) == DBUS_DISPATCH_DATA_REMAINS) {
+        depth++;
+        while (dbus_connection_dispatch(_conn) == DBUS_DISPATCH_DATA_REMAINS) {
+            _dispatch_released();
+            depth++;
+        }
+    }
+
+    std::scoped_lock stats_lock(_stats_mutex);
+    auto& queue_depth = _stats.queue_depth;
+    queue_depth.samples++;
+    queue_depth.total += depth;
+    queue_depth.last = depth;
+    queue_depth.max = std::max(queue_depth.max, depth);
 }
 
-Message Connection::pop_message() {
+void Connection::process_events(int timeout_ms) {
     if (!_initialized) {
         throw Exception::NotInitialized();
     }
 
-    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    epoll_event events[8];
+    int count = epoll_wait(_epoll_fd, events, 8, _timeout_next(timeout_ms));
+    if (count < 0) {
+        if (errno == EINTR) {
+            return;
+        }
+        throw std::runtime_error(std::string("Failed to wait for events: ") + strerror(errno));
+    }
+
+    for (int i = 0; i < count; i++) {
+        int fd = events[i].data.fd;
+
+        if (fd == _wakeup_fd) {
+            uint64_t value;
+            while (read(_wakeup_fd, &value, sizeof(value)) > 0) {}
+            continue;
+        }
+
+        unsigned int flags = 0;
+        if (events[i].events & EPOLLIN) flags |= DBUS_WATCH_READABLE;
+        if (events[i].events & EPOLLOUT) flags |= DBUS_WATCH_WRITABLE;
+        if (events[i].events & EPOLLERR) flags |= DBUS_WATCH_ERROR;
+        if (events[i].events & EPOLLHUP) flags |= DBUS_WATCH_HANGUP;
+
+        // Handling a watch can cause libdbus to add or remove watches, so the
+        // watch list is re-validated before every call into libdbus.
+        std::vector<DBusWatch*> watches;
+        {
+            std::lock_guard<std::mutex> watch_lock(_watch_mutex);
+            auto it = _watches.find(fd);
+            if (it != _watches.end()) {
+                watches = it->second;
+            }
+        }
+
+        for (DBusWatch* watch : watches) {
+            {
+                std::lock_guard<std::mutex> watch_lock(_watch_mutex);
+                auto it = _watches.find(fd);
+                if (it == _watches.end() || std::find(it->second.begin(), it->second.end(), watch) == it->second.end()) {
+                    continue;
+                }
+            }
+
+            if (!dbus_watch_get_enabled(watch)) {
+                continue;
+            }
+
+            unsigned int watch_flags = flags & (dbus_watch_get_flags(watch) | DBUS_WATCH_ERROR | DBUS_WATCH_HANGUP);
+            if (watch_flags != 0) {
+                dbus_watch_handle(watch, watch_flags);
+            }
+        }
+    }
+
+    _timeout_handle();
+}
+
+void Connection::wakeup() {
+    if (_wakeup_fd < 0) {
+        return;
+    }
+
+    uint64_t value = 1;
+    // The result is ignored, a failed write means the counter is already non-zero.
+    [[maybe_unused]] ssize_t result = write(_wakeup_fd, &value, sizeof(value));
+}
+
+Message Connection::pop_message() {
+    if (!_initialized) {
+        throw Exception::NotInitialized();
+    }
 
     DBusMessage* msg = dbus_connection_pop_message(_conn);
     return Message::from_acquired(msg);
@@ -139,11 +314,10 @@ void Connection::send(Message& msg) {
         throw Exception::NotInitialized();
     }
 
-    std::lock_guard<std::recursive_mutex> lock(_mutex);
-
     uint32_t msg_serial = 0;
     dbus_connection_send(_conn, msg, &msg_serial);
     dbus_connection_flush(_conn);
+    _trace_message(msg, true);
 }
 
 Message Connection::send_with_reply_and_block(Message& msg) {
@@ -151,11 +325,79 @@ Message Connection::send_with_reply_and_block(Message& msg) {
         throw Exception::NotInitialized();
     }
 
-    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    return _send_with_reply_and_block(msg, -1);
+}
+
+Message Connection::send_with_reply_and_block(Message& msg, std::chrono::milliseconds timeout) {
+    if (!_initialized) {
+        throw Exception::NotInitialized();
+    }
+
+    // Waiting below needs an actual duration, which libdbus otherwise picks by itself.
+    if (timeout < std::chrono::milliseconds::zero()) {
+        timeout = DEFAULT_REPLY_TIMEOUT;
+    }
+
+    std::thread::id dispatch_thread = _dispatch_thread;
+    if (dispatch_thread == std::thread::id() || dispatch_thread == std::this_thread::get_id()) {
+        return _send_with_reply_and_block(msg, static_cast<int>(timeout.count()));
+    }
+
+    struct BlockingCall {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool completed = false;
+        Message reply;
+    };
+
+    auto call = std::make_shared<BlockingCall>();
+    DBusPendingCall* pending = _send_with_reply_async(
+        msg,
+        [call](Message& reply) {
+            std::scoped_lock lock(call->mutex);
+            call->reply = std::move(reply);
+            call->completed = true;
+            call->cv.notify_all();
+        },
+        timeout);
+
+    std::unique_lock lock(call->mutex);
+    auto is_completed = [&call]() { return call->completed; };
+    if (timeout == TIMEOUT_INFINITE) {
+        call->cv.wait(lock, is_completed);
+    } else if (!call->cv.wait_for(lock, timeout, is_completed)) {
+        lock.unlock();
+        _cancel_pending_call(pending);
+        dbus_pending_call_unref(pending);
+        throw Exception::SendFailed(DBUS_ERROR_NO_REPLY, "Did not receive a reply before the timeout expired",
+                                    msg.to_string());
+    }
+    dbus_pending_call_unref(pending);
 
     ::DBusError err;
     dbus_error_init(&err);
-    DBusMessage* msg_tmp = dbus_connection_send_with_reply_and_block(_conn, msg, -1, &err);
+    if (dbus_set_error_from_message(&err, call->reply)) {
+        std::string err_name = err.name;
+        std::string err_message = err.message;
+        dbus_error_free(&err);
+        throw Exception::SendFailed(err_name, err_message, msg.to_string());
+    }
+
+    return std::move(call->reply);
+}
+
+Message Connection::_send_with_reply_and_block(Message& msg, int timeout_ms) {
+    ::DBusError err;
+    dbus_error_init(&err);
+    auto sent = std::chrono::steady_clock::now();
+    DBusMessage* msg_tmp = dbus_connection_send_with_reply_and_block(_conn, msg, timeout_ms, &err);
+
+    // Replies read by a blocking call never reach the filters, so they are accounted for here.
+    _trace_message(msg, true);
+    _stats_call_latency(msg, sent);
+    if (msg_tmp != nullptr) {
+        _trace_message(msg_tmp, false);
+    }
 
     if (dbus_error_is_set(&err)) {
         std::string err_name = err.name;
@@ -167,14 +409,124 @@ Message Connection::send_with_reply_and_block(Message& msg) {
     return Message::from_acquired(msg_tmp);
 }
 
-std::string Connection::unique_name() {
+void Connection::send_with_reply_async(Message& msg, std::function<void(Message& reply)> callback,
+                                       std::chrono::milliseconds timeout) {
     if (!_initialized) {
         throw Exception::NotInitialized();
     }
 
-    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    dbus_pending_call_unref(_send_with_reply_async(msg, std::move(callback), timeout));
+}
+
+DBusPendingCall* Connection::_send_with_reply_async(Message& msg, std::function<void(Message& reply)> callback,
+                                                    std::chrono::milliseconds timeout) {
+    DBusPendingCall* pending = nullptr;
+    if (!dbus_connection_send_with_reply(_conn, msg, &pending, static_cast<int>(timeout.count())) ||
+        pending == nullptr) {
+        throw Exception::SendFailed(DBUS_ERROR_DISCONNECTED, "Connection is closed", msg.to_string());
+    }
 
-    return std::string(dbus_bus_get_unique_name(_conn));
+    auto* pending_data = new PendingCallData{this, msg, msg.get_path(), std::move(callback),
+                                             std::chrono::steady_clock::now()};
+    _trace_message(msg, true);
+
+    // The call is tracked before the notify function is set, as the latter can run right away.
+    // The tracked reference is released once the call is completed or cancelled.
+    {
+        std::scoped_lock lock(_pending_mutex);
+        _pending_calls[dbus_pending_call_ref(pending)] = pending_data;
+    }
+
+    if (!dbus_pending_call_set_notify(pending, &Connection::static_pending_notify, pending_data,
+                                      &Connection::static_pending_free)) {
+        {
+            std::scoped_lock lock(_pending_mutex);
+            _pending_calls.erase(pending);
+        }
+        delete pending_data;
+        dbus_pending_call_cancel(pending);
+        dbus_pending_call_unref(pending);
+        dbus_pending_call_unref(pending);
+        throw Exception::SendFailed(DBUS_ERROR_NO_MEMORY, "Failed to set pending call notification", msg.to_string());
+    }
+
+    // If the reply was processed before the notify function was set, libdbus will never
+    // invoke it, so the callback needs to be triggered manually.
+    if (dbus_pending_call_get_completed(pending)) {
+        static_pending_notify(pending, pending_data);
+    }
+
+    dbus_connection_flush(_conn);
+    return pending;
+}
+
+void Connection::_cancel_pending_call(DBusPendingCall* pending) {
+    {
+        std::scoped_lock lock(_pending_mutex);
+        if (_pending_calls.erase(pending) == 0) {
+            return;
+        }
+    }
+
+    dbus_pending_call_cancel(pending);
+    dbus_pending_call_unref(pending);
+}
+
+std::future<Message> Connection::send_with_reply_async(Message& msg, std::chrono::milliseconds timeout) {
+    auto promise = std::make_shared<std::promise<Message>>();
+    std::future<Message> future = promise->get_future();
+
+    // The call is only described if it fails, sharing the message until then.
+    send_with_reply_async(msg, [promise, call = msg](Message& reply) {
+        ::DBusError err;
+        dbus_error_init(&err);
+        if (dbus_set_error_from_message(&err, reply)) {
+            std::string err_name = err.name;
+            std::string err_message = err.message;
+            dbus_error_free(&err);
+            promise->set_exception(
+                std::make_exception_ptr(Exception::SendFailed(err_name, err_message, call.to_string())));
+        } else {
+            promise->set_value(std::move(reply));
+        }
+    }, timeout);
+
+    return future;
+}
+
+void Connection::cancel_pending_calls(const std::string& path) {
+    std::vector<std::pair<DBusPendingCall*, PendingCallData*>> cancelled;
+    {
+        std::scoped_lock lock(_pending_mutex);
+        for (auto it = _pending_calls.begin(); it != _pending_calls.end();) {
+            const std::string& call_path = it->second->path;
+            if (call_path == path || PathUtils::is_descendant(path, call_path)) {
+                cancelled.push_back(*it);
+                it = _pending_calls.erase(it);
+            } else {
+                it++;
+            }
+        }
+    }
+
+    for (auto& [pending, pending_data] : cancelled) {
+        dbus_pending_call_cancel(pending);
+        if (!pending_data->notified.exchange(true)) {
+            Message reply = Message::create_error(pending_data->call, ERROR_CANCELLED, "The call was cancelled");
+            _pending_complete(pending_data, reply);
+        }
+        dbus_pending_call_unref(pending);
+    }
+}
+
+std::string Connection::unique_name() {
+    if (!_initialized) {
+        throw Exception::NotInitialized();
+    }
+
+    // NOTE: Peer connections are not registered on a bus, so they have no unique name.
+    const char* name = dbus_bus_get_unique_name(_conn);
+    return name != nullptr ? name : "";
 }
 
 bool Connection::register_object_path(const std::string& path, std::function<void(Message&)> handler) {
@@ -182,7 +534,7 @@ bool Connection::register_object_path(const std::string& path, std::function<voi
         return false;
     }
 
-    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    std::lock_guard<std::recursive_mutex> lock(_dispatch_mutex);
     if (_message_handlers.find(path) == _message_handlers.end()) {
         DBusObjectPathVTable vtable = {0};
         vtable.message_function = &Connection::static_message_handler;
@@ -194,7 +546,9 @@ bool Connection::register_object_path(const std::string& path, std::function<voi
 }
 
 bool Connection::unregister_object_path(const std::string& path) {
-    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    // NOTE: Taking the dispatch lock guarantees that the handler is not running (or is being
+    // run by the current thread) by the time the path is unregistered.
+    std::lock_guard<std::recursive_mutex> lock(_dispatch_mutex);
     auto it = _message_handlers.find(path);
     if (it != _message_handlers.end()) {
         dbus_connection_unregister_object_path(_conn, path.c_str());
@@ -204,16 +558,572 @@ bool Connection::unregister_object_path(const std::string& path) {
     return true;
 }
 
+bool Connection::register_signal_handler(const std::string& path, std::function<void(Message&)> handler) {
+    if (!_initialized) {
+        return false;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(_dispatch_mutex);
+    if (_signal_routes.find(path) == _signal_routes.end()) {
+        auto route = std::make_shared<SignalRoute>();
+        route->path = path;
+        route->handler = std::move(handler);
+        route->shard = _route_shard(route->path);
+        std::string_view key = route->path;
+        _signal_release(_signal_routes.emplace(key, std::move(route)).first->second);
+    }
+
+    return true;
+}
+
+bool Connection::unregister_signal_handler(const std::string& path) {
+    std::shared_ptr<SignalRoute> route;
+    {
+        // NOTE: Taking the dispatch lock guarantees that the handler is not being run by the
+        // dispatching thread (unless it is the current thread) by the time the route is removed.
+        std::lock_guard<std::recursive_mutex> lock(_dispatch_mutex);
+        auto it = _signal_routes.find(path);
+        if (it == _signal_routes.end()) {
+            return true;
+        }
+        route = std::move(it->second);
+        _signal_routes.erase(it);
+    }
+
+    // Wait for a dispatch worker that might be running the handler, and stop any queued signal.
+    std::lock_guard<std::recursive_mutex> route_lock(route->mutex);
+    route->active = false;
+
+    return true;
+}
+
+void Connection::set_signal_fallback(std::function<bool(std::string_view path)> fallback) {
+    std::lock_guard<std::recursive_mutex> lock(_dispatch_mutex);
+    _signal_fallback = std::move(fallback);
+}
+
+void Connection::set_signal_hold(std::chrono::milliseconds duration) {
+    std::lock_guard<std::recursive_mutex> lock(_dispatch_mutex);
+    _signal_hold_duration = duration;
+}
+
+bool Connection::_signal_hold(Message& msg) {
+    if (_signal_hold_duration.count() == 0) {
+        return false;
+    }
+
+    // Signals are held in arrival order, so the expired ones are always at the front.
+    auto now = std::chrono::steady_clock::now();
+    while (!_held_signals.empty() && now - _held_signals.front().first > _signal_hold_duration) {
+        _held_signals.pop_front();
+    }
+    _held_signals.emplace_back(now, msg);
+    return true;
+}
+
+void Connection::_signal_release(const std::shared_ptr<SignalRoute>& route) {
+    if (_held_signals.empty()) {
+        return;
+    }
+
+    std::deque<std::pair<std::chrono::steady_clock::time_point, Message>> released;
+    auto now = std::chrono::steady_clock::now();
+    for (auto it = _held_signals.begin(); it != _held_signals.end();) {
+        if (now - it->first <= _signal_hold_duration && route->path == dbus_message_get_path(it->second)) {
+            released.push_back(std::move(*it));
+            it = _held_signals.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    if (released.empty()) {
+        return;
+    }
+
+    if (_dispatch_workers.empty()) {
+        for (auto& [held, msg] : released) {
+            _released_signals.push_back(std::move(msg));
+        }
+        wakeup();
+        return;
+    }
+
+    // NOTE: Held signals were set aside by the worker of the route, so they are older than any
+    // signal of the route still in its queue.
+    DispatchWorker* worker = _dispatch_workers[route->shard % _dispatch_workers.size()].get();
+    {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        for (auto it = released.rbegin(); it != released.rend(); ++it) {
+            worker->queue.emplace_front(route, std::move(it->second), it->first);
+        }
+    }
+    worker->cv.notify_one();
+}
+
+void Connection::_dispatch_released() {
+    while (!_released_signals.empty()) {
+        Message msg = std::move(_released_signals.front());
+        _released_signals.pop_front();
+
+        auto it = _signal_routes.find(std::string_view(dbus_message_get_path(msg)));
+        if (it != _signal_routes.end()) {
+            it->second->handler(msg);
+        }
+    }
+}
+
+DBusHandlerResult Connection::static_signal_filter(DBusConnection*, DBusMessage* message, void* user_data) {
+    if (dbus_message_get_type(message) != DBUS_MESSAGE_TYPE_SIGNAL) {
+        return DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
+    }
+
+    const char* path = dbus_message_get_path(message);
+    if (path == nullptr) {
+        return DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
+    }
+
+    // NOTE: Filters are only invoked while dispatching, so the dispatch lock is already held.
+    Connection* conn = static_cast<Connection*>(user_data);
+    auto it = conn->_signal_routes.find(std::string_view(path));
+    if (it == conn->_signal_routes.end() && conn->_signal_fallback && conn->_signal_fallback(path)) {
+        // The fallback might register a route for the path, which the signal then follows.
+        it = conn->_signal_routes.find(std::string_view(path));
+    }
+
+    Message msg = Message::from_retained(message);
+    if (conn->_dispatch_workers.empty()) {
+        if (it == conn->_signal_routes.end()) {
+            if (conn->_message_handlers.count(path) == 0 && conn->_signal_hold(msg)) {
+                return DBUS_HANDLER_RESULT_HANDLED;
+            }
+            return DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
+        }
+        it->second->handler(msg);
+        return DBUS_HANDLER_RESULT_HANDLED;
+    }
+
+    std::shared_ptr<SignalRoute> route;
+    size_t shard = 0;
+    if (it != conn->_signal_routes.end()) {
+        route = it->second;
+        shard = route->shard;
+    } else if (conn->_message_handlers.count(path) > 0) {
+        return DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
+    } else {
+        // The route of the object might still be registered by a signal queued before this one,
+        // so it is looked up again by the worker once those have been handled.
+        shard = conn->_route_shard(path);
+    }
+
+    // Signals announcing or removing an object are handled along with the signals of that object,
+    // so that the route its proxy registers exists by the time they are handled.
+    if (dbus_message_has_interface(message, "org.freedesktop.DBus.ObjectManager")) {
+        DBusMessageIter iter;
+        if (dbus_message_iter_init(message, &iter) && dbus_message_iter_get_arg_type(&iter) == DBUS_TYPE_OBJECT_PATH) {
+            const char* object_path = nullptr;
+            dbus_message_iter_get_basic(&iter, &object_path);
+            shard = conn->_route_shard(object_path);
+        }
+    }
+
+    DispatchWorker* worker = conn->_dispatch_workers[shard % conn->_dispatch_workers.size()].get();
+    {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        worker->queue.emplace_back(std::move(route), std::move(msg), std::chrono::steady_clock::now());
+    }
+    worker->cv.notify_one();
+    return DBUS_HANDLER_RESULT_HANDLED;
+}
+
 DBusHandlerResult Connection::static_message_handler(DBusConnection* connection, DBusMessage* message, void* user_data) {
     Connection* conn = static_cast<Connection*>(user_data);
     Message msg = Message::from_retained(message);
     std::string path = msg.get_path();
 
-    std::lock_guard<std::recursive_mutex> lock(conn->_mutex);
+    // NOTE: Handlers are only invoked while dispatching, so the dispatch lock is already held.
     auto it = conn->_message_handlers.find(path);
     if (it != conn->_message_handlers.end()) {
         it->second(msg);
     }
 
     return DBUS_HANDLER_RESULT_HANDLED;
-}
\ No newline at end of file
+}
+
+void Connection::static_pending_notify(DBusPendingCall* pending, void* user_data) {
+    auto* pending_data = static_cast<PendingCallData*>(user_data);
+    if (pending_data->notified.exchange(true)) {
+        return;
+    }
+
+    Message reply = Message::from_acquired(dbus_pending_call_steal_reply(pending));
+
+    // Replies to pending calls never reach the filters, so they are accounted for here.
+    Connection* conn = pending_data->conn;
+    conn->_trace_message(reply, false);
+    conn->_stats_call_latency(pending_data->call, pending_data->sent);
+
+    _pending_complete(pending_data, reply);
+
+    // Release the tracked reference, unless the call is concurrently being cancelled.
+    std::unique_lock lock(conn->_pending_mutex);
+    if (conn->_pending_calls.erase(pending) > 0) {
+        lock.unlock();
+        dbus_pending_call_unref(pending);
+    }
+}
+
+void Connection::_pending_complete(PendingCallData* pending_data, Message& reply) {
+    // Exceptions must not propagate back into libdbus.
+    try {
+        pending_data->callback(reply);
+    } catch (const std::exception& e) {
+        LOG_ERROR("Exception in reply callback: {}", e.what());
+    }
+}
+
+void Connection::static_pending_free(void* user_data) { delete static_cast<PendingCallData*>(user_data); }
+
+// ----- DISPATCH WORKERS -----
+
+void Connection::set_dispatch_workers(size_t workers, size_t subtree_depth) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    _dispatch_worker_count = workers;
+    _dispatch_subtree_depth = subtree_depth;
+}
+
+size_t Connection::_route_shard(std::string_view path) const {
+    if (_dispatch_subtree_depth > 0) {
+        size_t segments = 0;
+        for (size_t i = 1; i < path.size(); i++) {
+            if (path[i] == '/' && ++segments == _dispatch_subtree_depth) {
+                path = path.substr(0, i);
+                break;
+            }
+        }
+    }
+
+    return std::hash<std::string_view>()(path);
+}
+
+void Connection::_dispatch_workers_start() {
+    std::lock_guard<std::recursive_mutex> lock(_dispatch_mutex);
+
+    // Routes registered before a previous `uninit` might have been sharded differently.
+    for (auto& [path, route] : _signal_routes) {
+        route->shard = _route_shard(path);
+    }
+
+    for (size_t i = 0; i < _dispatch_worker_count; i++) {
+        auto worker = std::make_unique<DispatchWorker>();
+        worker->thread = std::thread(&Connection::_dispatch_worker_loop, this, worker.get());
+        _dispatch_workers.push_back(std::move(worker));
+    }
+}
+
+void Connection::_dispatch_workers_stop() {
+    std::vector<std::unique_ptr<DispatchWorker>> workers;
+    {
+        std::lock_guard<std::recursive_mutex> lock(_dispatch_mutex);
+        workers.swap(_dispatch_workers);
+    }
+
+    // NOTE: The dispatch lock must not be held while joining, as handlers running on the
+    // workers may need it to register or unregister routes.
+    for (auto& worker : workers) {
+        {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            worker->active = false;
+        }
+        worker->cv.notify_one();
+        worker->thread.join();
+    }
+}
+
+void Connection::_dispatch_worker_loop(Connection* conn, DispatchWorker* worker) {
+    std::unique_lock<std::mutex> lock(worker->mutex);
+    while (true) {
+        worker->cv.wait(lock, [worker]() { return !worker->active || !worker->queue.empty(); });
+
+        // Queued signals are drained before stopping.
+        if (worker->queue.empty()) {
+            return;
+        }
+
+        auto [route, msg, queued] = std::move(worker->queue.front());
+        worker->queue.pop_front();
+        lock.unlock();
+
+        conn->_stats_lag(&ConnectionStats::worker_lag, queued);
+
+        if (!route) {
+            // NOTE: Waits for the dispatching thread to finish its pass, which is rare enough.
+            std::lock_guard<std::recursive_mutex> dispatch_lock(conn->_dispatch_mutex);
+            auto it = conn->_signal_routes.find(std::string_view(dbus_message_get_path(msg)));
+            if (it != conn->_signal_routes.end()) {
+                route = it->second;
+            } else {
+                conn->_signal_hold(msg);
+            }
+        }
+
+        if (route) {
+            std::lock_guard<std::recursive_mutex> route_lock(route->mutex);
+            if (route->active) {
+                try {
+                    route->handler(msg);
+                } catch (const std::exception& e) {
+                    LOG_ERROR("Exception in signal handler for {}: {}", route->path, e.what());
+                }
+            }
+        }
+
+        lock.lock();
+    }
+}
+
+// ----- RECORDING -----
+
+void Connection::start_recording(const std::string& filename) {
+    auto recorder = std::make_shared<RecordingWriter>(filename);
+    std::atomic_store(&_recorder, recorder);
+    _recording = true;
+}
+
+void Connection::stop_recording() {
+    _recording = false;
+    auto recorder = std::atomic_exchange(&_recorder, std::shared_ptr<RecordingWriter>());
+    if (recorder) {
+        recorder->flush();
+    }
+}
+
+void Connection::_trace_message(DBusMessage* msg, bool sent) {
+    if (_recording) {
+        auto recorder = std::atomic_load(&_recorder);
+        if (recorder) {
+            recorder->write(sent ? RecordedMessage::Direction::SENT : RecordedMessage::Direction::RECEIVED, msg);
+        }
+    }
+
+    _stats_message(msg, sent);
+}
+
+// ----- STATISTICS -----
+
+void Connection::set_stats_enabled(bool enabled) { _stats_enabled = enabled; }
+
+ConnectionStats Connection::stats() {
+    std::scoped_lock lock(_stats_mutex);
+    return _stats;
+}
+
+void Connection::reset_stats() {
+    std::scoped_lock lock(_stats_mutex);
+    _stats = ConnectionStats();
+}
+
+void Connection::_stats_message(DBusMessage* msg, bool sent) {
+    if (!_stats_enabled) {
+        return;
+    }
+
+    // NOTE: libdbus does not expose the wire size of a message, so it has to be marshalled.
+    char* buffer = nullptr;
+    int length = 0;
+    if (dbus_message_marshal(msg, &buffer, &length)) {
+        dbus_free(buffer);
+    }
+
+    const char* type = dbus_message_type_to_string(dbus_message_get_type(msg));
+    const char* interface = dbus_message_get_interface(msg);
+
+    std::scoped_lock lock(_stats_mutex);
+    auto& by_type = sent ? _stats.sent_by_type[type] : _stats.received_by_type[type];
+    by_type.messages++;
+    by_type.bytes += length;
+
+    if (interface != nullptr) {
+        auto& by_interface = sent ? _stats.sent_by_interface[interface] : _stats.received_by_interface[interface];
+        by_interface.messages++;
+        by_interface.bytes += length;
+    }
+}
+
+void Connection::_stats_call_latency(DBusMessage* call, std::chrono::steady_clock::time_point sent) {
+    if (!_stats_enabled) {
+        return;
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - sent;
+    const char* interface = dbus_message_get_interface(call);
+    const char* member = dbus_message_get_member(call);
+    std::string method = std::string(interface ? interface : "") + "." + (member ? member : "");
+
+    std::scoped_lock lock(_stats_mutex);
+    _stats.call_latency[method].record(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+}
+
+void Connection::_stats_lag(Histogram ConnectionStats::*histogram, std::chrono::steady_clock::time_point since) {
+    if (!_stats_enabled) {
+        return;
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - since;
+    std::scoped_lock lock(_stats_mutex);
+    (_stats.*histogram).record(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+}
+
+DBusHandlerResult Connection::static_stats_filter(DBusConnection*, DBusMessage* message, void* user_data) {
+    Connection* conn = static_cast<Connection*>(user_data);
+    conn->_trace_message(message, false);
+
+    // NOTE: Filters are only invoked while dispatching, so the dispatch lock is already held.
+    conn->_stats_lag(&ConnectionStats::dispatch_lag, conn->_dispatch_pass_start);
+
+    return DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
+}
+
+// ----- EVENT LOOP -----
+
+void Connection::_watch_update(int fd) {
+    // NOTE: Must be called with `_watch_mutex` held.
+    auto it = _watches.find(fd);
+    if (it == _watches.end()) {
+        return;
+    }
+
+    if (it->second.empty()) {
+        epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+        _watches.erase(it);
+        return;
+    }
+
+    epoll_event event = {};
+    event.data.fd = fd;
+    for (DBusWatch* watch : it->second) {
+        if (!dbus_watch_get_enabled(watch)) {
+            continue;
+        }
+
+        unsigned int flags = dbus_watch_get_flags(watch);
+        if (flags & DBUS_WATCH_READABLE) event.events |= EPOLLIN;
+        if (flags & DBUS_WATCH_WRITABLE) event.events |= EPOLLOUT;
+    }
+
+    if (epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, fd, &event) < 0 && errno == ENOENT) {
+        epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &event);
+    }
+}
+
+int Connection::_timeout_next(int timeout_ms) {
+    std::lock_guard<std::mutex> watch_lock(_watch_mutex);
+
+    auto now = std::chrono::steady_clock::now();
+    for (auto& [timeout, deadline] : _timeouts) {
+        if (!dbus_timeout_get_enabled(timeout)) {
+            continue;
+        }
+
+        auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - now).count();
+        int remaining_ms = static_cast<int>(std::max<decltype(remaining)>(remaining, 0));
+        if (timeout_ms < 0 || remaining_ms < timeout_ms) {
+            timeout_ms = remaining_ms;
+        }
+    }
+
+    return timeout_ms;
+}
+
+void Connection::_timeout_handle() {
+    std::vector<DBusTimeout*> expired;
+    {
+        std::lock_guard<std::mutex> watch_lock(_watch_mutex);
+        auto now = std::chrono::steady_clock::now();
+        for (auto& [timeout, deadline] : _timeouts) {
+            if (dbus_timeout_get_enabled(timeout) && deadline <= now) {
+                // DBus timeouts are periodic until they get removed or disabled.
+                deadline = now + std::chrono::milliseconds(dbus_timeout_get_interval(timeout));
+                expired.push_back(timeout);
+            }
+        }
+    }
+
+    for (DBusTimeout* timeout : expired) {
+        {
+            std::lock_guard<std::mutex> watch_lock(_watch_mutex);
+            if (_timeouts.find(timeout) == _timeouts.end()) {
+                continue;
+            }
+        }
+        dbus_timeout_handle(timeout);
+    }
+}
+
+dbus_bool_t Connection::static_add_watch(DBusWatch* watch, void* data) {
+    Connection* conn = static_cast<Connection*>(data);
+    int fd = dbus_watch_get_unix_fd(watch);
+
+    std::lock_guard<std::mutex> watch_lock(conn->_watch_mutex);
+    conn->_watches[fd].push_back(watch);
+    conn->_watch_update(fd);
+    return TRUE;
+}
+
+void Connection::static_remove_watch(DBusWatch* watch, void* data) {
+    Connection* conn = static_cast<Connection*>(data);
+    int fd = dbus_watch_get_unix_fd(watch);
+
+    std::lock_guard<std::mutex> watch_lock(conn->_watch_mutex);
+    auto it = conn->_watches.find(fd);
+    if (it != conn->_watches.end()) {
+        it->second.erase(std::remove(it->second.begin(), it->second.end(), watch), it->second.end());
+        conn->_watch_update(fd);
+    }
+}
+
+void Connection::static_toggle_watch(DBusWatch* watch, void* data) {
+    Connection* conn = static_cast<Connection*>(data);
+
+    std::lock_guard<std::mutex> watch_lock(conn->_watch_mutex);
+    conn->_watch_update(dbus_watch_get_unix_fd(watch));
+}
+
+dbus_bool_t Connection::static_add_timeout(DBusTimeout* timeout, void* data) {
+    Connection* conn = static_cast<Connection*>(data);
+
+    std::lock_guard<std::mutex> watch_lock(conn->_watch_mutex);
+    auto interval = std::chrono::milliseconds(dbus_timeout_get_interval(timeout));
+    conn->_timeouts[timeout] = std::chrono::steady_clock::now() + interval;
+    return TRUE;
+}
+
+void Connection::static_remove_timeout(DBusTimeout* timeout, void* data) {
+    Connection* conn = static_cast<Connection*>(data);
+
+    std::lock_guard<std::mutex> watch_lock(conn->_watch_mutex);
+    conn->_timeouts.erase(timeout);
+}
+
+void Connection::static_toggle_timeout(DBusTimeout* timeout, void* data) {
+    Connection* conn = static_cast<Connection*>(data);
+
+    {
+        // Re-enabled timeouts start counting from the moment they get enabled.
+        std::lock_guard<std::mutex> watch_lock(conn->_watch_mutex);
+        auto interval = std::chrono::milliseconds(dbus_timeout_get_interval(timeout));
+        conn->_timeouts[timeout] = std::chrono::steady_clock::now() + interval;
+    }
+
+    // The event loop might be blocked waiting for a longer period of time.
+    conn->wakeup();
+}
+
+void Connection::static_wakeup_main(void* data) { static_cast<Connection*>(data)->wakeup(); }
+
+void Connection::static_dispatch_status(DBusConnection*, DBusDispatchStatus new_status, void* data) {
+    // Messages can be queued without the socket becoming readable (for example, if they were
+    // read while another thread was waiting for a reply), so the event loop must be woken up.
+    if (new_status == DBUS_DISPATCH_DATA_REMAINS) {
+        static_cast<Connection*>(data)->wakeup();
+    }
+}
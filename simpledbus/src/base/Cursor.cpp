@@ -0,0 +1,24 @@
+#include <simpledbus/base/Cursor.h>
+
+using namespace SimpleDBus;
+
+Cursor::Cursor(const Message& msg) { _valid = msg.is_valid() && dbus_message_iter_init(msg, &_iter); }
+
+int Cursor::type() const { return _valid ? dbus_message_iter_get_arg_type(&_iter) : DBUS_TYPE_INVALID; }
+
+bool Cursor::at_end() const { return type() == DBUS_TYPE_INVALID; }
+
+bool Cursor::next() { return _valid && dbus_message_iter_next(&_iter); }
+
+Cursor Cursor::recurse() const {
+    Cursor cursor;
+    int current_type = type();
+    if (current_type == DBUS_TYPE_ARRAY || current_type == DBUS_TYPE_DICT_ENTRY || current_type == DBUS_TYPE_STRUCT ||
+        current_type == DBUS_TYPE_VARIANT) {
+        dbus_message_iter_recurse(&_iter, &cursor._iter);
+        cursor._valid = true;
+    }
+    return cursor;
+}
+
+Holder Cursor::extract() const { return _valid ? Message::_extract_generic(&_iter) : Holder(); }
@@ -34,6 +34,12 @@ PathNotFoundException::PathNotFoundException(const std::string& path, const std:
 
 const char* PathNotFoundException::what() const noexcept { return _message.c_str(); }
 
+SignatureMismatch::SignatureMismatch(const std::string& expected, const std::string& actual) {
+    _message = fmt::format("Expected arguments of signature '{}' but got '{}'", expected, actual);
+}
+
+const char* SignatureMismatch::what() const noexcept { return _message.c_str(); }
+
 }  // namespace Exception
 
 }  // namespace SimpleDBus
@@ -1,6 +1,10 @@
 #include <simpledbus/base/Holder.h>
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 #include "dbus/dbus-protocol.h"
 
@@ -8,11 +12,55 @@ using namespace SimpleDBus;
 
 Holder::Holder() {}
 
+Holder::Holder(const Holder& other)
+    : _type(other._type),
+      _hash(other._hash.load(std::memory_order_relaxed)),
+      _signature(other._signature),
+      _value(other._value) {}
+
+Holder::Holder(Holder&& other) noexcept
+    : _type(other._type),
+      _hash(other._hash.exchange(0, std::memory_order_relaxed)),
+      _signature(std::move(other._signature)),
+      _value(std::move(other._value)) {}
+
+Holder& Holder::operator=(const Holder& other) {
+    if (this != &other) {
+        _type = other._type;
+        _hash.store(other._hash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        _signature = other._signature;
+        _value = other._value;
+    }
+    return *this;
+}
+
+Holder& Holder::operator=(Holder&& other) noexcept {
+    if (this != &other) {
+        _type = other._type;
+        _hash.store(other._hash.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        _signature = std::move(other._signature);
+        _value = std::move(other._value);
+    }
+    return *this;
+}
+
 Holder::~Holder() {}
 
 bool Holder::operator!=(const Holder& other) const { return !(*this == other); }
 
 bool Holder::operator==(const Holder& other) const {
+    // Hashes are only compared once cached, computing them costs as much as comparing.
+    uint32_t hash = _hash.load(std::memory_order_relaxed);
+    uint32_t other_hash = other._hash.load(std::memory_order_relaxed);
+    if (hash != 0 && other_hash != 0 && hash != other_hash) {
+        return false;
+    }
+
+    // Byte arrays compare equal to regular arrays holding the same bytes.
+    if ((type() == BYTE_ARRAY && other.type() == ARRAY) || (type() == ARRAY && other.type() == BYTE_ARRAY)) {
+        return get_array() == other.get_array();
+    }
+
     if (type() != other.type()) {
         return false;
     }
@@ -45,14 +93,12 @@ bool Holder::operator==(const Holder& other) const {
         case SIGNATURE:
             return get_signature() == other.get_signature();
         case ARRAY:
-            return get_array() == other.get_array();
+            return _array() == other._array();
+        case BYTE_ARRAY:
+            return byte_array() == other.byte_array();
         case DICT:
-            return (get_dict_uint8() == other.get_dict_uint8()) && (get_dict_uint16() == other.get_dict_uint16()) &&
-                   (get_dict_int16() == other.get_dict_int16()) && (get_dict_uint32() == other.get_dict_uint32()) &&
-                   (get_dict_int32() == other.get_dict_int32()) && (get_dict_uint64() == other.get_dict_uint64()) &&
-                   (get_dict_int64() == other.get_dict_int64()) && (get_dict_string() == other.get_dict_string()) &&
-                   (get_dict_object_path() == other.get_dict_object_path()) &&
-                   (get_dict_signature() == other.get_dict_signature());
+            // Entries are sorted, so equal dictionaries hold the same entries in the same order.
+            return dict_entries() == other.dict_entries();
         default:
             return false;
     }
@@ -97,6 +143,9 @@ std::string Holder::_represent_simple() const {
         case SIGNATURE:
             output << get_string();
             break;
+        case BYTE_ARRAY:
+            // Byte arrays are containers, represented by `_represent_container`.
+            break;
     }
     return output.str();
 }
@@ -118,16 +167,18 @@ std::vector<std::string> Holder::_represent_container() const {
         case SIGNATURE:
             output_lines.push_back(_represent_simple());
             break;
-        case ARRAY: {
+        case ARRAY:
+        case BYTE_ARRAY: {
             output_lines.push_back("Array:");
             std::vector<std::string> additional_lines;
-            if (holder_array.size() > 0 && holder_array[0]._type == BYTE) {
+            if (_type == BYTE_ARRAY || (_array().size() > 0 && _array()[0]._type == BYTE)) {
                 // Dealing with an array of bytes, use custom print functionality.
+                std::vector<uint8_t> bytes = get_byte_array();
                 std::string temp_line = "";
-                for (int i = 0; i < holder_array.size(); i++) {
+                for (size_t i = 0; i < bytes.size(); i++) {
                     // Represent each byte as a hex string
                     std::stringstream stream;
-                    stream << std::setfill('0') << std::setw(2) << std::hex << ((int)holder_array[i].get_byte());
+                    stream << std::setfill('0') << std::setw(2) << std::hex << ((int)bytes[i]);
                     temp_line += (stream.str() + " ");
                     if ((i + 1) % 32 == 0) {
                         additional_lines.push_back(temp_line);
@@ -136,8 +187,8 @@ std::vector<std::string> Holder::_represent_container() const {
                 }
                 additional_lines.push_back(temp_line);
             } else {
-                for (int i = 0; i < holder_array.size(); i++) {
-                    for (auto& line : holder_array[i]._represent_container()) {
+                for (auto& element : _array()) {
+                    for (auto& line : element._represent_container()) {
                         additional_lines.push_back(line);
                     }
                 }
@@ -149,8 +200,8 @@ std::vector<std::string> Holder::_represent_container() const {
         }
         case DICT:
             output_lines.push_back("Dictionary:");
-            for (auto& [key_type_internal, key, value] : holder_dict) {
-                output_lines.push_back(_represent_type(key_type_internal, key) + ":");
+            for (auto& [key, value] : dict_entries()) {
+                output_lines.push_back(_represent_type(key._type, key.get_contents()) + ":");
                 auto additional_lines = value._represent_container();
                 for (auto& line : additional_lines) {
                     output_lines.push_back("  " + line);
@@ -196,6 +247,8 @@ std::string Holder::_signature_simple() const {
             return DBUS_TYPE_OBJECT_PATH_AS_STRING;
         case SIGNATURE:
             return DBUS_TYPE_SIGNATURE_AS_STRING;
+        case BYTE_ARRAY:
+            return DBUS_TYPE_ARRAY_AS_STRING DBUS_TYPE_BYTE_AS_STRING;
     }
     return "";
 }
@@ -226,6 +279,8 @@ std::string Holder::_signature_type(Type type) noexcept {
             return DBUS_TYPE_OBJECT_PATH_AS_STRING;
         case SIGNATURE:
             return DBUS_TYPE_SIGNATURE_AS_STRING;
+        case BYTE_ARRAY:
+            return DBUS_TYPE_ARRAY_AS_STRING DBUS_TYPE_BYTE_AS_STRING;
     }
     return "";
 }
@@ -267,13 +322,16 @@ std::string Holder::_represent_type(Type type, std::any value) noexcept {
         case SIGNATURE:
             output << std::any_cast<std::string>(value);
             break;
+        case BYTE_ARRAY:
+            // Only used for dictionary keys, which can't be byte arrays.
+            break;
     }
     return output.str();
 }
 
 void Holder::signature_override(const std::string& signature) {
     // TODO: Check that the signature is valid for the Holder type and contents.
-    _signature = signature;
+    _signature = std::make_shared<const std::string>(signature);
 }
 
 std::string Holder::signature() const {
@@ -295,17 +353,19 @@ std::string Holder::signature() const {
         case STRING:
         case OBJ_PATH:
         case SIGNATURE:
+        case BYTE_ARRAY:
             output = _signature_simple();
             break;
-        case ARRAY:
+        case ARRAY: {
+            const auto& array = _array();
             output = DBUS_TYPE_ARRAY_AS_STRING;
-            if (holder_array.size() == 0) {
+            if (array.size() == 0) {
                 output += DBUS_TYPE_VARIANT_AS_STRING;
             } else {
-                // Check if all elements of holder_array are the same type
-                auto first_type = holder_array[0]._type;
+                // Check if all elements of the array are the same type
+                auto first_type = array[0]._type;
                 bool all_same_type = true;
-                for (auto& element : holder_array) {
+                for (auto& element : array) {
                     if (element._type != first_type) {
                         all_same_type = false;
                         break;
@@ -313,25 +373,27 @@ std::string Holder::signature() const {
                 }
 
                 if (all_same_type) {
-                    output += holder_array[0]._signature_simple();
+                    output += array[0]._signature_simple();
                 } else {
                     output += DBUS_TYPE_VARIANT_AS_STRING;
                 }
             }
             break;
-        case DICT:
+        }
+        case DICT: {
+            const auto& dict = dict_entries();
             output = DBUS_TYPE_ARRAY_AS_STRING;
             output += DBUS_DICT_ENTRY_BEGIN_CHAR_AS_STRING;
 
-            if (holder_dict.size() == 0) {
+            if (dict.size() == 0) {
                 output += DBUS_TYPE_STRING_AS_STRING;
                 output += DBUS_TYPE_VARIANT_AS_STRING;
             } else {
-                // Check if all keys of holder_dict are the same type
-                auto first_key_type = std::get<0>(holder_dict[0]);
+                // Check if all keys of the dictionary are the same type
+                auto first_key_type = dict[0].first._type;
                 bool all_same_key_type = true;
-                for (auto& [key_type_internal, key, value] : holder_dict) {
-                    if (key_type_internal != first_key_type) {
+                for (auto& [key, value] : dict) {
+                    if (key._type != first_key_type) {
                         all_same_key_type = false;
                         break;
                     }
@@ -342,10 +404,10 @@ std::string Holder::signature() const {
                     output += DBUS_TYPE_VARIANT_AS_STRING;
                 }
 
-                // Check if all values of holder_dict are the same type
-                auto first_value_type = std::get<2>(holder_dict[0])._type;
+                // Check if all values of the dictionary are the same type
+                auto first_value_type = dict[0].second._type;
                 bool all_same_value_type = true;
-                for (auto& [key_type_internal, key, value] : holder_dict) {
+                for (auto& [key, value] : dict) {
                     if (value._type != first_value_type) {
                         all_same_value_type = false;
                         break;
@@ -353,7 +415,7 @@ std::string Holder::signature() const {
                 }
 
                 if (all_same_value_type && first_value_type != ARRAY && first_value_type != DICT) {
-                    output += std::get<2>(holder_dict[0])._signature_simple();
+                    output += dict[0].second._signature_simple();
                 } else {
                     output += DBUS_TYPE_VARIANT_AS_STRING;
                 }
@@ -361,6 +423,7 @@ std::string Holder::signature() const {
 
             output += DBUS_DICT_ENTRY_END_CHAR_AS_STRING;
             break;
+        }
     }
     return output;
 }
@@ -368,85 +431,128 @@ std::string Holder::signature() const {
 Holder Holder::create_byte(uint8_t value) {
     Holder h;
     h._type = BYTE;
-    h.holder_integer = value;
+    h._value = static_cast<uint64_t>(value);
     return h;
 }
 Holder Holder::create_boolean(bool value) {
     Holder h;
     h._type = BOOLEAN;
-    h.holder_boolean = value;
+    h._value = value;
     return h;
 }
 Holder Holder::create_int16(int16_t value) {
     Holder h;
     h._type = INT16;
-    h.holder_integer = value;
+    h._value = static_cast<uint64_t>(value);
     return h;
 }
 Holder Holder::create_uint16(uint16_t value) {
     Holder h;
     h._type = UINT16;
-    h.holder_integer = value;
+    h._value = static_cast<uint64_t>(value);
     return h;
 }
 Holder Holder::create_int32(int32_t value) {
     Holder h;
     h._type = INT32;
-    h.holder_integer = value;
+    h._value = static_cast<uint64_t>(value);
     return h;
 }
 Holder Holder::create_uint32(uint32_t value) {
     Holder h;
     h._type = UINT32;
-    h.holder_integer = value;
+    h._value = static_cast<uint64_t>(value);
     return h;
 }
 Holder Holder::create_int64(int64_t value) {
     Holder h;
     h._type = INT64;
-    h.holder_integer = value;
+    h._value = static_cast<uint64_t>(value);
     return h;
 }
 Holder Holder::create_uint64(uint64_t value) {
     Holder h;
     h._type = UINT64;
-    h.holder_integer = value;
+    h._value = static_cast<uint64_t>(value);
     return h;
 }
 Holder Holder::create_double(double value) {
     Holder h;
     h._type = DOUBLE;
-    h.holder_double = value;
+    h._value = value;
     return h;
 }
 Holder Holder::create_string(const std::string& str) {
     Holder h;
     h._type = STRING;
-    h.holder_string = str;
+    h._value = str;
     return h;
 }
 Holder Holder::create_object_path(const ObjectPath& path) {
     Holder h;
     h._type = OBJ_PATH;
-    h.holder_string = path;
+    h._value = std::string(path);
     return h;
 }
 Holder Holder::create_signature(const Signature& signature) {
     Holder h;
     h._type = SIGNATURE;
-    h.holder_string = signature;
+    h._value = std::string(signature);
     return h;
 }
 Holder Holder::create_array() {
     Holder h;
     h._type = ARRAY;
-    h.holder_array.clear();
+    h._value = std::vector<Holder>();
+    return h;
+}
+Holder Holder::create_array(std::vector<Holder> elements) {
+    Holder h;
+    h._type = ARRAY;
+    h._value = std::move(elements);
     return h;
 }
 Holder Holder::create_dict() {
     Holder h;
     h._type = DICT;
-    h.holder_dict.clear();
+    h._value = Dict();
+    return h;
+}
+Holder Holder::create_dict(Dict entries) {
+    auto less = [](const auto& a, const auto& b) { return _key_less(a.first, b.first); };
+    if (!std::is_sorted(entries.begin(), entries.end(), less)) {
+        std::stable_sort(entries.begin(), entries.end(), less);
+    }
+
+    // Keep the last of every run of equal keys, as appending them one by one would.
+    auto last = entries.begin();
+    for (auto it = entries.begin(); it != entries.end(); it++) {
+        if (last != entries.begin() && !less(*(last - 1), *it)) {
+            (last - 1)->second = std::move(it->second);
+        } else {
+            if (last != it) {
+                *last = std::move(*it);
+            }
+            last++;
+        }
+    }
+    entries.erase(last, entries.end());
+
+    Holder h;
+    h._type = DICT;
+    h._value = std::move(entries);
+    return h;
+}
+Holder Holder::create_byte_array(const uint8_t* data, size_t size) {
+    Holder h;
+    h._type = BYTE_ARRAY;
+    h._value = std::vector<uint8_t>(data, data + size);
+    return h;
+}
+Holder Holder::create_byte_array(const std::vector<uint8_t>& bytes) {
+    Holder h;
+    h._type = BYTE_ARRAY;
+    h._value = bytes;
     return h;
 }
 
@@ -510,6 +616,11 @@ Holder Holder::create(const Signature& value) {
     return create_signature(value);
 }
 
+template <>
+Holder Holder::create(const std::vector<uint8_t>& value) {
+    return create_byte_array(value);
+}
+
 template <>
 Holder Holder::create<std::vector<Holder>>() {
     return create_array();
@@ -552,31 +663,117 @@ std::any Holder::get_contents() const {
     }
 }
 
-bool Holder::get_boolean() const { return holder_boolean; }
+uint64_t Holder::_integer() const {
+    const uint64_t* value = std::get_if<uint64_t>(&_value);
+    return value != nullptr ? *value : 0;
+}
+
+const std::string& Holder::_string() const {
+    static const std::string empty;
+    const std::string* value = std::get_if<std::string>(&_value);
+    return value != nullptr ? *value : empty;
+}
+
+const std::vector<Holder>& Holder::_array() const {
+    static const std::vector<Holder> empty;
+    const std::vector<Holder>* value = std::get_if<std::vector<Holder>>(&_value);
+    return value != nullptr ? *value : empty;
+}
+
+const Holder::Dict& Holder::dict_entries() const {
+    static const Dict empty;
+    const Dict* value = std::get_if<Dict>(&_value);
+    return value != nullptr ? *value : empty;
+}
+
+Holder::Dict Holder::dict_take() {
+    _hash.store(0, std::memory_order_relaxed);
+    Dict* value = std::get_if<Dict>(&_value);
+    return value != nullptr ? std::exchange(*value, Dict()) : Dict();
+}
+
+std::string_view Holder::get_string_view() const { return _string(); }
+
+const std::vector<Holder>& Holder::array_view() const {
+    if (_type == BYTE_ARRAY) {
+        throw std::invalid_argument("Byte arrays have no elements to view, use byte_array() instead");
+    }
+    return _array();
+}
+
+Holder::DictView Holder::dict_view(Type key_type) const {
+    // Entries are sorted by key type first, so those of a single type are contiguous.
+    const Dict& dict = dict_entries();
+    auto first = std::lower_bound(dict.begin(), dict.end(), key_type,
+                                  [](const auto& entry, Type type) { return entry.first._type < type; });
+    auto last = std::upper_bound(first, dict.end(), key_type,
+                                 [](Type type, const auto& entry) { return type < entry.first._type; });
+    return DictView(dict.data() + (first - dict.begin()), dict.data() + (last - dict.begin()));
+}
+
+const std::vector<uint8_t>& Holder::byte_array() const {
+    static const std::vector<uint8_t> empty;
+    const std::vector<uint8_t>* value = std::get_if<std::vector<uint8_t>>(&_value);
+    return value != nullptr ? *value : empty;
+}
+
+bool Holder::get_boolean() const {
+    const bool* value = std::get_if<bool>(&_value);
+    return value != nullptr && *value;
+}
+
+uint8_t Holder::get_byte() const { return (uint8_t)(_integer() & 0x00000000000000FFL); }
+
+int16_t Holder::get_int16() const { return (int16_t)(_integer() & 0x000000000000FFFFL); }
 
-uint8_t Holder::get_byte() const { return (uint8_t)(holder_integer & 0x00000000000000FFL); }
+uint16_t Holder::get_uint16() const { return (uint16_t)(_integer() & 0x000000000000FFFFL); }
 
-int16_t Holder::get_int16() const { return (int16_t)(holder_integer & 0x000000000000FFFFL); }
+int32_t Holder::get_int32() const { return (int32_t)(_integer() & 0x00000000FFFFFFFFL); }
 
-uint16_t Holder::get_uint16() const { return (uint16_t)(holder_integer & 0x000000000000FFFFL); }
+uint32_t Holder::get_uint32() const { return (uint32_t)(_integer() & 0x00000000FFFFFFFFL); }
 
-int32_t Holder::get_int32() const { return (int32_t)(holder_integer & 0x00000000FFFFFFFFL); }
+int64_t Holder::get_int64() const { return (int64_t)_integer(); }
 
-uint32_t Holder::get_uint32() const { return (uint32_t)(holder_integer & 0x00000000FFFFFFFFL); }
+uint64_t Holder::get_uint64() const { return _integer(); }
 
-int64_t Holder::get_int64() const { return (int64_t)holder_integer; }
+double Holder::get_double() const {
+    const double* value = std::get_if<double>(&_value);
+    return value != nullptr ? *value : 0;
+}
 
-uint64_t Holder::get_uint64() const { return holder_integer; }
+std::string Holder::get_string() const { return _string(); }
 
-double Holder::get_double() const { return holder_double; }
+std::string Holder::get_object_path() const { return get_string(); }
 
-std::string Holder::get_string() const { return holder_string; }
+std::string Holder::get_signature() const { return get_string(); }
 
-std::string Holder::get_object_path() const { return holder_string; }
+std::vector<Holder> Holder::get_array() const {
+    if (_type != BYTE_ARRAY) {
+        return _array();
+    }
 
-std::string Holder::get_signature() const { return holder_string; }
+    const std::vector<uint8_t>& bytes = byte_array();
+    std::vector<Holder> output;
+    output.reserve(bytes.size());
+    for (uint8_t byte : bytes) {
+        output.push_back(create_byte(byte));
+    }
+    return output;
+}
 
-std::vector<Holder> Holder::get_array() const { return holder_array; }
+std::vector<uint8_t> Holder::get_byte_array() const {
+    if (_type == BYTE_ARRAY) {
+        return byte_array();
+    }
+
+    const std::vector<Holder>& array = _array();
+    std::vector<uint8_t> output;
+    output.reserve(array.size());
+    for (const auto& element : array) {
+        output.push_back(element.get_byte());
+    }
+    return output;
+}
 
 std::map<uint8_t, Holder> Holder::get_dict_uint8() const { return _get_dict<uint8_t>(BYTE); }
 
@@ -653,6 +850,11 @@ std::vector<Holder> Holder::get() const {
     return get_array();
 }
 
+template <>
+std::vector<uint8_t> Holder::get() const {
+    return get_byte_array();
+}
+
 template <>
 std::map<uint8_t, Holder> Holder::get() const {
     return get_dict_uint8();
@@ -696,9 +898,9 @@ std::map<std::string, Holder> Holder::get() const {
 template <>
 std::map<ObjectPath, Holder> Holder::get() const {
     std::map<ObjectPath, Holder> output;
-    for (auto& [key_type_internal, key, value] : holder_dict) {
-        if (key_type_internal == OBJ_PATH) {
-            output[ObjectPath(std::any_cast<std::string>(key))] = value;
+    for (auto& [key, value] : dict_entries()) {
+        if (key._type == OBJ_PATH) {
+            output.emplace_hint(output.end(), ObjectPath(key._string()), value);
         }
     }
     return output;
@@ -707,15 +909,93 @@ std::map<ObjectPath, Holder> Holder::get() const {
 template <>
 std::map<Signature, Holder> Holder::get() const {
     std::map<Signature, Holder> output;
-    for (auto& [key_type_internal, key, value] : holder_dict) {
-        if (key_type_internal == SIGNATURE) {
-            output[Signature(std::any_cast<std::string>(key))] = value;
+    for (auto& [key, value] : dict_entries()) {
+        if (key._type == SIGNATURE) {
+            output.emplace_hint(output.end(), Signature(key._string()), value);
         }
     }
     return output;
 }
 
-void Holder::array_append(Holder holder) { holder_array.push_back(holder); }
+template <>
+Holder::DictView Holder::dict_view<bool>() const {
+    return dict_view(BOOLEAN);
+}
+
+template <>
+Holder::DictView Holder::dict_view<uint8_t>() const {
+    return dict_view(BYTE);
+}
+
+template <>
+Holder::DictView Holder::dict_view<int16_t>() const {
+    return dict_view(INT16);
+}
+
+template <>
+Holder::DictView Holder::dict_view<uint16_t>() const {
+    return dict_view(UINT16);
+}
+
+template <>
+Holder::DictView Holder::dict_view<int32_t>() const {
+    return dict_view(INT32);
+}
+
+template <>
+Holder::DictView Holder::dict_view<uint32_t>() const {
+    return dict_view(UINT32);
+}
+
+template <>
+Holder::DictView Holder::dict_view<int64_t>() const {
+    return dict_view(INT64);
+}
+
+template <>
+Holder::DictView Holder::dict_view<uint64_t>() const {
+    return dict_view(UINT64);
+}
+
+template <>
+Holder::DictView Holder::dict_view<double>() const {
+    return dict_view(DOUBLE);
+}
+
+template <>
+Holder::DictView Holder::dict_view<std::string>() const {
+    return dict_view(STRING);
+}
+
+template <>
+Holder::DictView Holder::dict_view<ObjectPath>() const {
+    return dict_view(OBJ_PATH);
+}
+
+template <>
+Holder::DictView Holder::dict_view<Signature>() const {
+    return dict_view(SIGNATURE);
+}
+
+void Holder::array_append(Holder holder) {
+    _hash.store(0, std::memory_order_relaxed);
+    if (_type == BYTE_ARRAY) {
+        if (holder._type == BYTE) {
+            std::get<std::vector<uint8_t>>(_value).push_back(holder.get_byte());
+            return;
+        }
+
+        // Anything but a byte turns this into a regular array.
+        _value = get_array();
+        _type = ARRAY;
+    }
+
+    std::vector<Holder>* array = std::get_if<std::vector<Holder>>(&_value);
+    if (array == nullptr) {
+        array = &_value.emplace<std::vector<Holder>>();
+    }
+    array->push_back(std::move(holder));
+}
 
 void Holder::dict_append(Type key_type, std::any key, Holder value) {
     if (key.type() == typeid(const char*)) {
@@ -724,16 +1004,200 @@ void Holder::dict_append(Type key_type, std::any key, Holder value) {
 
     // TODO : VALIDATE THAT THE SPECIFIED KEY TYPE IS CORRECT
 
-    holder_dict.push_back(std::make_tuple(key_type, key, value));
+    dict_append(_create_key(key_type, key), std::move(value));
+}
+
+void Holder::dict_append(Holder key, Holder value) {
+    _hash.store(0, std::memory_order_relaxed);
+    Dict* dict = std::get_if<Dict>(&_value);
+    if (dict == nullptr) {
+        dict = &_value.emplace<Dict>();
+    }
+
+    // Entries mostly arrive in order, in which case they are simply appended.
+    if (dict->empty() || _key_less(dict->back().first, key)) {
+        dict->emplace_back(std::move(key), std::move(value));
+        return;
+    }
+
+    auto it = std::lower_bound(dict->begin(), dict->end(), key,
+                               [](const auto& entry, const Holder& key) { return _key_less(entry.first, key); });
+    if (it != dict->end() && !_key_less(key, it->first)) {
+        it->second = std::move(value);
+    } else {
+        dict->emplace(it, std::move(key), std::move(value));
+    }
+}
+
+const Holder* Holder::dict_find(const Holder& key) const {
+    const Dict& dict = dict_entries();
+    auto it = std::lower_bound(dict.begin(), dict.end(), key,
+                               [](const auto& entry, const Holder& key) { return _key_less(entry.first, key); });
+    if (it != dict.end() && !_key_less(key, it->first)) {
+        return &it->second;
+    }
+    return nullptr;
+}
+
+const Holder* Holder::dict_find(const std::string& key) const { return _dict_find_string(STRING, key); }
+
+const Holder* Holder::dict_find(const char* key) const { return _dict_find_string(STRING, key); }
+
+const Holder* Holder::dict_find(const ObjectPath& key) const { return _dict_find_string(OBJ_PATH, key); }
+
+const Holder* Holder::_dict_find_string(Type key_type, const std::string& key) const {
+    // Compares against the key in place, rather than creating a Holder for it.
+    const Dict& dict = dict_entries();
+    auto it = std::lower_bound(dict.begin(), dict.end(), key, [key_type](const auto& entry, const std::string& key) {
+        return entry.first._type < key_type || (entry.first._type == key_type && entry.first._string() < key);
+    });
+    if (it != dict.end() && it->first._type == key_type && it->first._string() == key) {
+        return &it->second;
+    }
+    return nullptr;
+}
+
+bool Holder::_key_less(const Holder& a, const Holder& b) {
+    if (a._type != b._type) {
+        return a._type < b._type;
+    }
+
+    switch (a._type) {
+        case BOOLEAN:
+            return a.get_boolean() < b.get_boolean();
+        case INT16:
+        case INT32:
+        case INT64:
+            // Signed integers are stored sign-extended.
+            return a.get_int64() < b.get_int64();
+        case DOUBLE:
+            return a.get_double() < b.get_double();
+        case STRING:
+        case OBJ_PATH:
+        case SIGNATURE:
+            return a._string() < b._string();
+        default:
+            return a._integer() < b._integer();
+    }
+}
+
+Holder Holder::_create_key(Type key_type, const std::any& key) {
+    switch (key_type) {
+        case BOOLEAN:
+            return create_boolean(std::any_cast<bool>(key));
+        case BYTE:
+            return create_byte(std::any_cast<uint8_t>(key));
+        case INT16:
+            return create_int16(std::any_cast<int16_t>(key));
+        case UINT16:
+            return create_uint16(std::any_cast<uint16_t>(key));
+        case INT32:
+            return create_int32(std::any_cast<int32_t>(key));
+        case UINT32:
+            return create_uint32(std::any_cast<uint32_t>(key));
+        case INT64:
+            return create_int64(std::any_cast<int64_t>(key));
+        case UINT64:
+            return create_uint64(std::any_cast<uint64_t>(key));
+        case DOUBLE:
+            return create_double(std::any_cast<double>(key));
+        case STRING:
+            return create_string(std::any_cast<std::string>(key));
+        case OBJ_PATH:
+            return create_object_path(std::any_cast<std::string>(key));
+        case SIGNATURE:
+            return create_signature(std::any_cast<std::string>(key));
+        default:
+            return Holder();
+    }
 }
 
 template <typename T>
 std::map<T, Holder> Holder::_get_dict(Type key_type) const {
+    // Entries are already in key order, so each one is inserted at the end of the map.
     std::map<T, Holder> output;
-    for (auto& [key_type_internal, key, value] : holder_dict) {
-        if (key_type_internal == key_type) {
-            output[std::any_cast<T>(key)] = value;
+    for (auto& [key, value] : dict_entries()) {
+        if (key._type == key_type) {
+            if constexpr (std::is_same_v<T, std::string>) {
+                output.emplace_hint(output.end(), key._string(), value);
+            } else {
+                output.emplace_hint(output.end(), static_cast<T>(key._integer()), value);
+            }
         }
     }
     return output;
 }
+
+size_t Holder::hash() const {
+    uint32_t hash = _hash.load(std::memory_order_relaxed);
+    if (hash == 0) {
+        hash = _compute_hash();
+        _hash.store(hash, std::memory_order_relaxed);
+    }
+    return hash;
+}
+
+bool Holder::same_value(const Holder& latest) const { return hash() == latest.hash() && *this == latest; }
+
+namespace {
+
+void hash_combine(size_t& seed, size_t value) { seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2); }
+
+// Folds a hash into the 32 bits cached by a holder, where 0 stands for a hash not yet computed.
+uint32_t hash_finish(size_t seed) {
+    uint32_t hash = static_cast<uint32_t>(seed ^ (static_cast<uint64_t>(seed) >> 32));
+    return hash != 0 ? hash : 1;
+}
+
+}  // namespace
+
+uint32_t Holder::_hash_byte(uint8_t value) {
+    size_t seed = std::hash<int>()(BYTE);
+    hash_combine(seed, value);
+    return hash_finish(seed);
+}
+
+uint32_t Holder::_compute_hash() const {
+    // Byte arrays hash like the arrays of bytes they compare equal to.
+    size_t seed = std::hash<int>()(_type == BYTE_ARRAY ? ARRAY : _type);
+    switch (_type) {
+        case NONE:
+            break;
+        case BYTE:
+            return _hash_byte(get_byte());
+        case BOOLEAN:
+            hash_combine(seed, get_boolean());
+            break;
+        case DOUBLE: {
+            // Zeroes of either sign compare equal.
+            double value = get_double();
+            hash_combine(seed, std::hash<double>()(value == 0.0 ? 0.0 : value));
+            break;
+        }
+        case STRING:
+        case OBJ_PATH:
+        case SIGNATURE:
+            hash_combine(seed, std::hash<std::string_view>()(_string()));
+            break;
+        case ARRAY:
+            for (const auto& element : _array()) {
+                hash_combine(seed, element.hash());
+            }
+            break;
+        case BYTE_ARRAY:
+            for (uint8_t byte : byte_array()) {
+                hash_combine(seed, _hash_byte(byte));
+            }
+            break;
+        case DICT:
+            for (const auto& [key, value] : dict_entries()) {
+                hash_combine(seed, key.hash());
+                hash_combine(seed, value.hash());
+            }
+            break;
+        default:
+            hash_combine(seed, _integer());
+            break;
+    }
+    return hash_finish(seed);
+}
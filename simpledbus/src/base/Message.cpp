@@ -1,27 +1,55 @@
 #include <simpledbus/base/Message.h>
 
+#include <iterator>
 #include <sstream>
 
 using namespace SimpleDBus;
 
-#define MESSAGE_DICT_APPEND_KEY_NUM(key_sig, dict_contents)                                   \
-    for (auto& [key, value] : dict_contents) {                                                \
-        DBusMessageIter entry_iter;                                                           \
-        dbus_message_iter_open_container(&sub_iter, DBUS_TYPE_DICT_ENTRY, NULL, &entry_iter); \
-        dbus_message_iter_append_basic(&entry_iter, key_sig, &key);                           \
-        _append_argument(&entry_iter, value, value_sig);                                      \
-        dbus_message_iter_close_container(&sub_iter, &entry_iter);                            \
+namespace {
+
+// Buffer that a container is decoded into before being moved into storage of its final size,
+// so that the decoded tree is not grown element by element. Buffers are reused by the
+// containers decoded afterwards on the same thread, up to a bounded capacity.
+template <typename T>
+class ScratchBuffer {
+  public:
+    ScratchBuffer() {
+        if (!pool().empty()) {
+            _buffer = std::move(pool().back());
+            pool().pop_back();
+        }
+    }
+
+    ~ScratchBuffer() {
+        if (_buffer.capacity() <= MAX_RETAINED_CAPACITY) {
+            _buffer.clear();
+            pool().push_back(std::move(_buffer));
+        }
+    }
+
+    template <typename... Args>
+    void emplace_back(Args&&... args) {
+        _buffer.emplace_back(std::forward<Args>(args)...);
+    }
+
+    std::vector<T> take() {
+        return std::vector<T>(std::make_move_iterator(_buffer.begin()), std::make_move_iterator(_buffer.end()));
     }
 
-#define MESSAGE_DICT_APPEND_KEY_STR(key_sig, dict_contents)                                   \
-    for (auto& [key, value] : dict_contents) {                                                \
-        const char* p_value = key.c_str();                                                    \
-        DBusMessageIter entry_iter;                                                           \
-        dbus_message_iter_open_container(&sub_iter, DBUS_TYPE_DICT_ENTRY, NULL, &entry_iter); \
-        dbus_message_iter_append_basic(&entry_iter, key_sig, &p_value);                       \
-        _append_argument(&entry_iter, value, value_sig);                                      \
-        dbus_message_iter_close_container(&sub_iter, &entry_iter);                            \
+    bool empty() const { return _buffer.empty(); }
+
+  private:
+    static constexpr size_t MAX_RETAINED_CAPACITY = 1024;
+
+    std::vector<T> _buffer;
+
+    static std::vector<std::vector<T>>& pool() {
+        thread_local std::vector<std::vector<T>> buffers;
+        return buffers;
     }
+};
+
+}  // namespace
 
 std::atomic_int32_t Message::_creation_counter = 0;
 
@@ -34,14 +62,13 @@ Message::~Message() {
 }
 
 Message::Message(Message&& other) noexcept
-    : _indent(other._indent),
-      _unique_id(other._unique_id),
+    : _unique_id(other._unique_id),
       _iter(std::move(other._iter)),
       _iter_initialized(other._iter_initialized),
       _is_extracted(other._is_extracted),
       _extracted(std::move(other._extracted)),
       _msg(other._msg),
-      _arguments(std::move(other._arguments)) {
+      _sharing(std::move(other._sharing)) {
     // Move constructor: Transfer ownership of resources from 'other' to this object.
     // After the move, 'other' will be left in a valid but unspecified state.
 
@@ -49,23 +76,10 @@ Message::Message(Message&& other) noexcept
     other._invalidate();
 }
 
-Message::Message(const Message& other)
-    : _indent(other._indent),
-      _unique_id(_creation_counter++),
-      _is_extracted(other._is_extracted),
-      _extracted(other._extracted),
-      _arguments(other._arguments) {
-    // Copy constructor: Create a new Message as a deep copy of 'other'.
-    // If 'other' is valid, all its contents are duplicated.
-
-    if (other._msg) {
-        _msg = dbus_message_copy(other._msg);
-        if (_msg == nullptr) {
-            throw std::runtime_error("Failed to copy DBusMessage in copy constructor");
-        }
-    } else {
-        _msg = nullptr;
-    }
+Message::Message(const Message& other) : _unique_id(_creation_counter++) {
+    // Copy constructor: Share the underlying DBusMessage of 'other', which is only duplicated
+    // once either copy appends arguments to it.
+    _copy_from(other);
 }
 
 Message& Message::operator=(Message&& other) noexcept {
@@ -77,14 +91,13 @@ Message& Message::operator=(Message&& other) noexcept {
         _safe_delete();  // Clean up existing resources
 
         // Transfer ownership
-        _indent = other._indent;
         _unique_id = other._unique_id;
         _iter = other._iter;
         _iter_initialized = other._iter_initialized;
         _is_extracted = other._is_extracted;
         _extracted = std::move(other._extracted);
         _msg = other._msg;
-        _arguments = std::move(other._arguments);
+        _sharing = std::move(other._sharing);
 
         // Invalidate the moved-from object
         other._invalidate();
@@ -93,29 +106,46 @@ Message& Message::operator=(Message&& other) noexcept {
 }
 
 Message& Message::operator=(const Message& other) {
-    // Copy assignment operator: Replace the contents of this Message with a deep copy of 'other'.
-    // Any existing resources in this object are safely deleted before the copy.
-    // If 'other' is valid, all its contents are duplicated.
+    // Copy assignment operator: Replace the contents of this Message with a reference to the
+    // DBusMessage of 'other', with the same copy-on-write semantics as the copy constructor.
 
     if (this != &other) {
         _safe_delete();  // Clean up existing resources
 
-        _indent = other._indent;
         _unique_id = _creation_counter++;
-        _is_extracted = other._is_extracted;
-        _extracted = other._extracted;
-        _arguments = other._arguments;
+        _copy_from(other);
+    }
+    return *this;
+}
 
-        if (other._msg) {
-            _msg = dbus_message_copy(other._msg);
-            if (_msg == nullptr) {
-                throw std::runtime_error("Failed to copy DBusMessage in copy assignment");
-            }
-        } else {
-            _msg = nullptr;
+void Message::_copy_from(const Message& other) {
+    if (other._msg) {
+        _msg = dbus_message_ref(other._msg);
+        _sharing = other._sharing;
+    }
+
+    // Reading iterators only point into the message, so the copy resumes from the same
+    // argument. The extracted holder is not copied, it is extracted again if needed.
+    _iter = other._iter;
+    _iter_initialized = other._iter_initialized;
+    _is_extracted = false;
+}
+
+void Message::_detach() {
+    // The message is shared with other copies (or still referenced by libdbus), so it is
+    // duplicated before being modified. Iterators into the shared message are discarded.
+    if (is_valid() && (*_sharing || _sharing.use_count() > 1)) {
+        DBusMessage* copy = dbus_message_copy(_msg);
+        if (copy == nullptr) {
+            throw std::runtime_error("Failed to copy DBusMessage before modifying it");
         }
+        dbus_message_unref(_msg);
+        _msg = copy;
+        _sharing = std::make_shared<const bool>(false);
+        _iter_initialized = false;
+        _is_extracted = false;
+        _extracted = Holder();
     }
-    return *this;
 }
 
 Message::operator DBusMessage*() const { return _msg; }
@@ -199,67 +229,38 @@ void Message::_append_argument(DBusMessageIter* iter, const Holder& argument, co
             auto sig_next = signature.substr(1);
             DBusMessageIter sub_iter;
             dbus_message_iter_open_container(iter, DBUS_TYPE_ARRAY, sig_next.c_str(), &sub_iter);
-            if (sig_next[0] != DBUS_DICT_ENTRY_BEGIN_CHAR) {
-                auto array_contents = argument.get_array();
-                for (auto elem : array_contents) {
+            if (sig_next[0] == DBUS_TYPE_BYTE && argument.type() == Holder::BYTE_ARRAY) {
+                // Contiguous bytes are appended at once.
+                const std::vector<uint8_t>& bytes = argument.byte_array();
+                const uint8_t* data = bytes.data();
+                dbus_message_iter_append_fixed_array(&sub_iter, DBUS_TYPE_BYTE, &data, static_cast<int>(bytes.size()));
+            } else if (sig_next[0] != DBUS_DICT_ENTRY_BEGIN_CHAR) {
+                // Elements are appended in place, only byte arrays appended with another
+                // signature than `ay` need to be expanded.
+                std::vector<Holder> expanded;
+                if (argument.type() == Holder::BYTE_ARRAY) {
+                    expanded = argument.get_array();
+                }
+                for (const auto& elem : argument.type() == Holder::BYTE_ARRAY ? expanded : argument.array_view()) {
                     _append_argument(&sub_iter, elem, sig_next);
                 }
             } else {
                 sig_next = sig_next.substr(1, sig_next.length() - 2);
-                auto key_sig = sig_next[0];
+                auto key_sig = sig_next.substr(0, 1);
                 auto value_sig = sig_next.substr(1);
 
-                switch (key_sig) {
-                    case DBUS_TYPE_BYTE: {
-                        auto dict_contents = argument.get_dict_uint8();
-                        MESSAGE_DICT_APPEND_KEY_NUM(key_sig, dict_contents);
-                        break;
-                    }
-                    case DBUS_TYPE_INT16: {
-                        auto dict_contents = argument.get_dict_int16();
-                        MESSAGE_DICT_APPEND_KEY_NUM(key_sig, dict_contents);
-                        break;
-                    }
-                    case DBUS_TYPE_UINT16: {
-                        auto dict_contents = argument.get_dict_uint16();
-                        MESSAGE_DICT_APPEND_KEY_NUM(key_sig, dict_contents);
-                        break;
-                    }
-                    case DBUS_TYPE_INT32: {
-                        auto dict_contents = argument.get_dict_int32();
-                        MESSAGE_DICT_APPEND_KEY_NUM(key_sig, dict_contents);
-                        break;
-                    }
-                    case DBUS_TYPE_UINT32: {
-                        auto dict_contents = argument.get_dict_uint32();
-                        MESSAGE_DICT_APPEND_KEY_NUM(key_sig, dict_contents);
-                        break;
-                    }
-                    case DBUS_TYPE_INT64: {
-                        auto dict_contents = argument.get_dict_int64();
-                        MESSAGE_DICT_APPEND_KEY_NUM(key_sig, dict_contents);
-                        break;
-                    }
-                    case DBUS_TYPE_UINT64: {
-                        auto dict_contents = argument.get_dict_uint64();
-                        MESSAGE_DICT_APPEND_KEY_NUM(key_sig, dict_contents);
-                        break;
-                    }
-                    case DBUS_TYPE_STRING: {
-                        auto dict_contents = argument.get_dict_string();
-                        MESSAGE_DICT_APPEND_KEY_STR(key_sig, dict_contents);
-                        break;
-                    }
-                    case DBUS_TYPE_OBJECT_PATH: {
-                        auto dict_contents = argument.get_dict_object_path();
-                        MESSAGE_DICT_APPEND_KEY_STR(key_sig, dict_contents);
-                        break;
-                    }
-                    case DBUS_TYPE_SIGNATURE: {
-                        auto dict_contents = argument.get_dict_signature();
-                        MESSAGE_DICT_APPEND_KEY_STR(key_sig, dict_contents);
-                        break;
+                // Entries are appended straight from the dictionary, those with keys of
+                // another type than the signature are left out.
+                for (const auto& [key, value] : argument.dict_entries()) {
+                    if (key.signature() != key_sig) {
+                        continue;
                     }
+
+                    DBusMessageIter entry_iter;
+                    dbus_message_iter_open_container(&sub_iter, DBUS_TYPE_DICT_ENTRY, NULL, &entry_iter);
+                    _append_argument(&entry_iter, key, key_sig);
+                    _append_argument(&entry_iter, value, value_sig);
+                    dbus_message_iter_close_container(&sub_iter, &entry_iter);
                 }
             }
             dbus_message_iter_close_container(iter, &sub_iter);
@@ -268,11 +269,17 @@ void Message::_append_argument(DBusMessageIter* iter, const Holder& argument, co
 }
 
 void Message::append_argument(const Holder& argument, const std::string& signature) {
+    _detach();
     dbus_message_iter_init_append(_msg, &_iter);
     _append_argument(&_iter, argument, signature);
-    _arguments.push_back(argument);
 }
 
+void Marshal::append_variant(DBusMessageIter* iter, const Holder& value) {
+    Message::_append_argument(iter, value, DBUS_TYPE_VARIANT_AS_STRING);
+}
+
+Holder Marshal::read_variant(DBusMessageIter* iter) { return Message::_extract_generic(iter); }
+
 uint32_t Message::get_ref_count() const {
     // NOTE: This is a hack based on the DBusMessage structure documentation that says that
     // the first 4 bytes of the DBusMessage structure is the ref count.
@@ -373,8 +380,13 @@ std::string Message::to_string(bool append_arguments) const {
     if (get_type() == Message::Type::METHOD_CALL && append_arguments) {
         oss << std::endl;
         oss << "Arguments: " << std::endl;
-        for (const auto& arg : _arguments) {
-            oss << arg.represent();
+
+        // Arguments are read back from the message itself, rather than retained when appended.
+        DBusMessageIter iter;
+        if (dbus_message_iter_init(_msg, &iter)) {
+            do {
+                oss << _extract_generic(&iter).represent();
+            } while (dbus_message_iter_next(&iter));
         }
     }
     return oss.str();
@@ -415,36 +427,28 @@ Holder Message::_extract_bytearray(DBusMessageIter* iter) {
     const unsigned char* bytes;
     int len;
     dbus_message_iter_get_fixed_array(iter, &bytes, &len);
-    Holder holder_array = Holder::create_array();
-    for (int i = 0; i < len; i++) {
-        holder_array.array_append(Holder::create_byte(bytes[i]));
-    }
-    return holder_array;
+    return Holder::create_byte_array(bytes, len);
 }
 
 Holder Message::_extract_array(DBusMessageIter* iter) {
-    Holder holder_array = Holder::create_array();
-    _indent += 1;
     int current_type = dbus_message_iter_get_arg_type(iter);
     if (current_type == DBUS_TYPE_BYTE) {
-        holder_array = _extract_bytearray(iter);
-    } else {
-        while ((current_type = dbus_message_iter_get_arg_type(iter)) != DBUS_TYPE_INVALID) {
-            Holder h = _extract_generic(iter);
-            if (h.type() != Holder::NONE) {
-                holder_array.array_append(h);
-            }
-            dbus_message_iter_next(iter);
+        return _extract_bytearray(iter);
+    }
+
+    ScratchBuffer<Holder> elements;
+    while ((current_type = dbus_message_iter_get_arg_type(iter)) != DBUS_TYPE_INVALID) {
+        Holder h = _extract_generic(iter);
+        if (h.type() != Holder::NONE) {
+            elements.emplace_back(std::move(h));
         }
+        dbus_message_iter_next(iter);
     }
-    _indent -= 1;
-    return holder_array;
+    return Holder::create_array(elements.take());
 }
 
 Holder Message::_extract_dict(DBusMessageIter* iter) {
-    bool holder_initialized = false;
-    Holder holder_dict;
-    _indent += 1;
+    ScratchBuffer<std::pair<Holder, Holder>> entries;
     int current_type;
 
     // Loop through all dictionary entries.
@@ -458,17 +462,11 @@ Holder Message::_extract_dict(DBusMessageIter* iter) {
         dbus_message_iter_next(&sub);
         Holder value = _extract_generic(&sub);
 
-        // Add the data to the dictionary
-        if (!holder_initialized) {
-            holder_dict = Holder::create_dict();
-            holder_initialized = true;
-        }
-
-        holder_dict.dict_append(key.type(), key.get_contents(), value);
+        // Add the data to the dictionary, which is sorted once complete.
+        entries.emplace_back(std::move(key), std::move(value));
         dbus_message_iter_next(iter);
     }
-    _indent -= 1;
-    return holder_dict;
+    return entries.empty() ? Holder() : Holder::create_dict(entries.take());
 }
 
 Holder Message::_extract_generic(DBusMessageIter* iter) {
@@ -548,10 +546,8 @@ Holder Message::_extract_generic(DBusMessageIter* iter) {
             case DBUS_TYPE_VARIANT: {
                 DBusMessageIter sub;
                 dbus_message_iter_recurse(iter, &sub);
-                _indent += 1;
-                Holder h = _extract_generic(&sub);
-                _indent -= 1;
-                return h;
+                            Holder h = _extract_generic(&sub);
+                            return h;
             }
         }
     }
@@ -564,6 +560,7 @@ Message Message::from_retained(DBusMessage* msg) {
         dbus_message_ref(msg);
         message._msg = msg;
         message._unique_id = _creation_counter++;
+        message._sharing = std::make_shared<const bool>(true);
     }
     return message;
 }
@@ -573,6 +570,7 @@ Message Message::from_acquired(DBusMessage* msg) {
     if (msg) {
         message._msg = msg;
         message._unique_id = _creation_counter++;
+        message._sharing = std::make_shared<const bool>(false);
     }
     return message;
 }
@@ -601,6 +599,7 @@ Message Message::create_signal(const std::string& path, const std::string& inter
 void Message::_invalidate() {
     _unique_id = INVALID_UNIQUE_ID;
     _msg = nullptr;
+    _sharing.reset();
     _iter_initialized = false;
     _is_extracted = false;
     _extracted = Holder();
@@ -611,7 +610,6 @@ void Message::_invalidate() {
     // For older versions of DBus, DBUS_MESSAGE_ITER_INIT_CLOSED is not defined.
     _iter = DBusMessageIter();
 #endif
-    _arguments.clear();
 }
 
 void Message::_safe_delete() {
@@ -1,25 +1,58 @@
 #include "simpledbus/base/Path.h"
 
 #include <algorithm>
-#include <regex>
 #include <stdexcept>
 
 namespace SimpleDBus {
 
-Path::Path(const std::string& path) : _path(path) { PathUtils::validate(_path); }
+Path::Path(const std::string& path) : _path(path) {
+    PathUtils::validate(_path);
 
-// Member functions delegating to PathUtils
-size_t Path::count_elements() const { return PathUtils::count_elements(_path); }
-std::string Path::fetch_elements(size_t count) const { return PathUtils::fetch_elements(_path, count); }
+    if (_path != "/") {
+        for (size_t i = 0; i < _path.size(); i++) {
+            if (_path[i] == '/') {
+                _offsets.push_back(static_cast<uint32_t>(i));
+            }
+        }
+    }
+}
+
+size_t Path::count_elements() const { return _offsets.size(); }
+
+std::string_view Path::element(size_t index) const {
+    if (index >= _offsets.size()) {
+        return std::string_view();
+    }
+
+    size_t end = index + 1 < _offsets.size() ? _offsets[index + 1] : _path.size();
+    return std::string_view(_path).substr(_offsets[index] + 1, end - _offsets[index] - 1);
+}
+
+std::string_view Path::prefix(size_t count) const {
+    if (count == 0) {
+        return "/";
+    }
+
+    if (count >= _offsets.size()) {
+        return _path;
+    }
+
+    return std::string_view(_path).substr(0, _offsets[count]);
+}
+
+// Member functions delegating to PathUtils, or reading the cached elements
+std::string Path::fetch_elements(size_t count) const { return std::string(prefix(count)); }
 std::vector<std::string> Path::split_elements() const { return PathUtils::split_elements(_path); }
 bool Path::is_descendant(const Path& base) const { return PathUtils::is_descendant(base._path, _path); }
 bool Path::is_ascendant(const Path& base) const { return PathUtils::is_ascendant(base._path, _path); }
-bool Path::is_child(const Path& base) const { return PathUtils::is_child(base._path, _path); }
+bool Path::is_child(const Path& base) const {
+    return PathUtils::is_descendant(base._path, _path) && base.count_elements() + 1 == count_elements();
+}
 bool Path::is_parent(const Path& base) const { return PathUtils::is_parent(base._path, _path); }
-std::string Path::next_child(const Path& base) const { return PathUtils::next_child(base._path, _path); }
+std::string Path::next_child(const Path& base) const { return std::string(prefix(base.count_elements() + 1)); }
 std::string Path::next_child_strip(const Path& base) const { return PathUtils::next_child_strip(base._path, _path); }
 
-size_t PathUtils::count_elements(const std::string& path) {
+size_t PathUtils::count_elements(std::string_view path) {
     if (path.empty() || path == "/") {
         return 0;
     }
@@ -27,7 +60,7 @@ size_t PathUtils::count_elements(const std::string& path) {
     return std::count(path.begin(), path.end(), '/');
 }
 
-std::vector<std::string> PathUtils::split_elements(const std::string& path) {
+std::vector<std::string> PathUtils::split_elements(std::string_view path) {
     std::vector<std::string> elements;
 
     if (path.empty() || path == "/") {
@@ -35,42 +68,39 @@ std::vector<std::string> PathUtils::split_elements(const std::string& path) {
     }
 
     // Note: Skip the first element, which is the root
-    std::string::const_iterator it = path.begin() + 1;
-    std::string::const_iterator end = path.end();
-
-    while (it != end) {
-        std::string::const_iterator next = std::find(it, end, '/');
-        elements.push_back(std::string(it, next));
-        it = next;
-        if (it != end) {
-            ++it;
-        }
+    size_t start = 1;
+    while (start < path.size()) {
+        size_t next = std::min(path.find('/', start), path.size());
+        elements.emplace_back(path.substr(start, next - start));
+        start = next + 1;
     }
 
     return elements;
 }
 
-std::string PathUtils::fetch_elements(const std::string& path, size_t count) {
+std::string_view PathUtils::fetch_elements_view(std::string_view path, size_t count) {
     if (count == 0) {
         return "/";
     }
 
-    if (count > count_elements(path)) {
-        // TODO: Should we throw an exception?
-        return path;
+    // The elements end at the separator in front of element `count`, or at the end of the path.
+    size_t position = 0;
+    for (size_t found = 0; found <= count; found++) {
+        position = path.find('/', position + (found > 0 ? 1 : 0));
+        if (position == std::string_view::npos) {
+            // TODO: Should we throw an exception if there are less than `count` elements?
+            return path;
+        }
     }
 
-    std::vector<std::string> elements = split_elements(path);
-    std::string result;
-
-    for (size_t i = 0; i < count; i++) {
-        result += "/" + elements[i];
-    }
+    return path.substr(0, position);
+}
 
-    return result;
+std::string PathUtils::fetch_elements(std::string_view path, size_t count) {
+    return std::string(fetch_elements_view(path, count));
 }
 
-bool PathUtils::is_descendant(const std::string& base, const std::string& path) {
+bool PathUtils::is_descendant(std::string_view base, std::string_view path) {
     if (base.empty() || path.empty()) {
         return false;
     }
@@ -83,10 +113,11 @@ bool PathUtils::is_descendant(const std::string& base, const std::string& path)
         return true;
     }
 
-    return path.rfind(base) == 0;
+    // Paths sharing a prefix are only related if it ends on an element boundary.
+    return path.size() > base.size() && path.compare(0, base.size(), base) == 0 && path[base.size()] == '/';
 }
 
-bool PathUtils::is_ascendant(const std::string& base, const std::string& path) {
+bool PathUtils::is_ascendant(std::string_view base, std::string_view path) {
     if (base.empty() || path.empty()) {
         return false;
     }
@@ -98,7 +129,7 @@ bool PathUtils::is_ascendant(const std::string& base, const std::string& path) {
     return !is_descendant(base, path);
 }
 
-bool PathUtils::is_child(const std::string& base, const std::string& path) {
+bool PathUtils::is_child(std::string_view base, std::string_view path) {
     if (base.empty() || path.empty()) {
         return false;
     }
@@ -114,7 +145,7 @@ bool PathUtils::is_child(const std::string& base, const std::string& path) {
     return count_elements(base) + 1 == count_elements(path);
 }
 
-bool PathUtils::is_parent(const std::string& base, const std::string& path) {
+bool PathUtils::is_parent(std::string_view base, std::string_view path) {
     if (base.empty() || path.empty()) {
         return false;
     }
@@ -130,26 +161,40 @@ bool PathUtils::is_parent(const std::string& base, const std::string& path) {
     return count_elements(base) - 1 == count_elements(path);
 }
 
-std::string PathUtils::next_child(const std::string& base, const std::string& path) {
-    return fetch_elements(path, count_elements(base) + 1);
+std::string_view PathUtils::next_child_view(std::string_view base, std::string_view path) {
+    return fetch_elements_view(path, count_elements(base) + 1);
+}
+
+std::string PathUtils::next_child(std::string_view base, std::string_view path) {
+    return std::string(next_child_view(base, path));
 }
 
-std::string PathUtils::next_child_strip(const std::string& base, const std::string& path) {
-    const std::string child = next_child(base, path);
-    return child.substr(base.length() + 1);
+std::string_view PathUtils::next_child_strip_view(std::string_view base, std::string_view path) {
+    std::string_view child = next_child_view(base, path);
+    size_t start = base == "/" ? 1 : base.size() + 1;
+    return start < child.size() ? child.substr(start) : std::string_view();
 }
 
-void PathUtils::validate(const std::string& path) {
+std::string PathUtils::next_child_strip(std::string_view base, std::string_view path) {
+    return std::string(next_child_strip_view(base, path));
+}
+
+void PathUtils::validate(std::string_view path) {
     if (path.empty()) {
         throw std::invalid_argument("Path cannot be empty");
     }
     if (path != "/" && path[0] != '/') {
         throw std::invalid_argument("Path must start with '/'");
     }
-    // Allow alphanumeric, underscores, and slashes only
-    std::regex valid_path_regex("^/([a-zA-Z0-9_]+/)*[a-zA-Z0-9_]*$");
-    if (!std::regex_match(path, valid_path_regex)) {
-        throw std::invalid_argument("Path contains invalid characters");
+    // Allow alphanumeric, underscores, and slashes only. Elements can't be empty, other than
+    // after a trailing slash.
+    for (size_t i = 0; i < path.size(); i++) {
+        char c = path[i];
+        bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' ||
+                     (c == '/' && (i == 0 || path[i - 1] != '/'));
+        if (!valid) {
+            throw std::invalid_argument("Path contains invalid characters");
+        }
     }
 }
 
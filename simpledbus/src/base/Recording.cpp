@@ -0,0 +1,88 @@
+#include <simpledbus/base/Recording.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+using namespace SimpleDBus;
+
+static constexpr char MAGIC[8] = {'S', 'D', 'B', 'U', 'S', 'R', 'E', 'C'};
+
+RecordingWriter::RecordingWriter(const std::string& filename)
+    : _file(filename, std::ios::binary | std::ios::trunc), _start(std::chrono::steady_clock::now()) {
+    if (!_file) {
+        throw std::runtime_error("Failed to open recording " + filename);
+    }
+
+    _file.write(MAGIC, sizeof(MAGIC));
+    _file.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+}
+
+void RecordingWriter::write(RecordedMessage::Direction direction, DBusMessage* msg) {
+    char* buffer = nullptr;
+    int length = 0;
+    if (!dbus_message_marshal(msg, &buffer, &length)) {
+        return;
+    }
+
+    uint64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start)
+                             .count();
+    uint32_t size = static_cast<uint32_t>(length);
+
+    {
+        std::scoped_lock lock(_mutex);
+        _file.put(static_cast<char>(direction));
+        _file.write(reinterpret_cast<const char*>(&timestamp), sizeof(timestamp));
+        _file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        _file.write(buffer, length);
+    }
+
+    dbus_free(buffer);
+}
+
+void RecordingWriter::flush() {
+    std::scoped_lock lock(_mutex);
+    _file.flush();
+}
+
+RecordingReader::RecordingReader(const std::string& filename) : _file(filename, std::ios::binary) {
+    char magic[sizeof(MAGIC)] = {};
+    uint32_t version = 0;
+    _file.read(magic, sizeof(magic));
+    _file.read(reinterpret_cast<char*>(&version), sizeof(version));
+
+    if (!_file || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || version != RecordingWriter::VERSION) {
+        throw std::runtime_error("Failed to open recording " + filename);
+    }
+}
+
+bool RecordingReader::next(RecordedMessage& record) {
+    char direction = 0;
+    uint64_t timestamp = 0;
+    uint32_t size = 0;
+    _file.get(direction);
+    _file.read(reinterpret_cast<char*>(&timestamp), sizeof(timestamp));
+    _file.read(reinterpret_cast<char*>(&size), sizeof(size));
+    if (!_file) {
+        return false;
+    }
+
+    std::vector<char> buffer(size);
+    _file.read(buffer.data(), size);
+    if (!_file) {
+        return false;
+    }
+
+    ::DBusError err;
+    dbus_error_init(&err);
+    DBusMessage* msg = dbus_message_demarshal(buffer.data(), static_cast<int>(size), &err);
+    if (msg == nullptr) {
+        dbus_error_free(&err);
+        return false;
+    }
+
+    record.direction = static_cast<RecordedMessage::Direction>(direction);
+    record.timestamp = std::chrono::nanoseconds(timestamp);
+    record.message = Message::from_acquired(msg);
+    return true;
+}
@@ -0,0 +1,67 @@
+#include <simpledbus/base/Stats.h>
+
+#include <algorithm>
+
+using namespace SimpleDBus;
+
+void Histogram::record(uint64_t value_us) {
+    auto it = std::lower_bound(BOUNDS_US.begin(), BOUNDS_US.end(), value_us);
+    _buckets[it - BOUNDS_US.begin()]++;
+    _count++;
+    _sum_us += value_us;
+    _max_us = std::max(_max_us, value_us);
+}
+
+void Histogram::merge(const Histogram& other) {
+    for (size_t i = 0; i < _buckets.size(); i++) {
+        _buckets[i] += other._buckets[i];
+    }
+    _count += other._count;
+    _sum_us += other._sum_us;
+    _max_us = std::max(_max_us, other._max_us);
+}
+
+double Histogram::mean_us() const { return _count == 0 ? 0 : static_cast<double>(_sum_us) / _count; }
+
+uint64_t Histogram::percentile_us(double pct) const {
+    if (_count == 0) {
+        return 0;
+    }
+
+    uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(pct / 100.0 * _count + 0.5));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BOUNDS_US.size(); i++) {
+        seen += _buckets[i];
+        if (seen >= target) {
+            return std::min(BOUNDS_US[i], _max_us);
+        }
+    }
+
+    return _max_us;
+}
+
+static void merge_traffic(std::map<std::string, ConnectionStats::Traffic>& into,
+                          const std::map<std::string, ConnectionStats::Traffic>& from) {
+    for (const auto& [key, traffic] : from) {
+        into[key].messages += traffic.messages;
+        into[key].bytes += traffic.bytes;
+    }
+}
+
+void ConnectionStats::merge(const ConnectionStats& other) {
+    merge_traffic(received_by_type, other.received_by_type);
+    merge_traffic(sent_by_type, other.sent_by_type);
+    merge_traffic(received_by_interface, other.received_by_interface);
+    merge_traffic(sent_by_interface, other.sent_by_interface);
+
+    for (const auto& [key, histogram] : other.call_latency) {
+        call_latency[key].merge(histogram);
+    }
+    dispatch_lag.merge(other.dispatch_lag);
+    worker_lag.merge(other.worker_lag);
+
+    queue_depth.samples += other.queue_depth.samples;
+    queue_depth.total += other.queue_depth.total;
+    queue_depth.max = std::max(queue_depth.max, other.queue_depth.max);
+    queue_depth.last += other.queue_depth.last;
+}
@@ -1,5 +1,8 @@
 #include <simpledbus/interfaces/ObjectManager.h>
+#include <simpledbus/advanced/InterfaceRegistry.h>
 #include <simpledbus/advanced/Proxy.h>
+#include <simpledbus/base/Cursor.h>
+#include <simpledbus/base/Logging.h>
 
 using namespace SimpleDBus;
 using namespace SimpleDBus::Interfaces;
@@ -16,16 +19,19 @@ const AutoRegisterInterface<ObjectManager> ObjectManager::registry{
 ObjectManager::ObjectManager(std::shared_ptr<Connection> conn, std::shared_ptr<Proxy> proxy)
     : Interface(conn, proxy, "org.freedesktop.DBus.ObjectManager") {}
 
-Holder ObjectManager::GetManagedObjects(bool use_callbacks) {
+Message ObjectManager::GetManagedObjectsReply() {
     Message query_msg = Message::create_method_call(_bus_name, _path, _interface_name, "GetManagedObjects");
-    Message reply_msg = _conn->send_with_reply_and_block(query_msg);
-    Holder managed_objects = reply_msg.extract();
+    return _conn->send_with_reply_and_block(query_msg);
+}
+
+Holder ObjectManager::GetManagedObjects(bool use_callbacks) {
+    Message reply_msg = GetManagedObjectsReply();
+    Holder managed_objects = Cursor(reply_msg).extract();
     // TODO: Remove immediate callback support.
     if (use_callbacks) {
-        auto managed_object = managed_objects.get_dict_object_path();
-        for (auto& [path, options] : managed_object) {
-            if (InterfacesAdded) {
-                InterfacesAdded(path, options);
+        for (const auto& [path, options] : managed_objects.dict_entries()) {
+            if (InterfacesAdded && path.type() == Holder::OBJ_PATH) {
+                InterfacesAdded(path.get_object_path(), options);
             }
         }
     }
@@ -34,18 +40,45 @@ Holder ObjectManager::GetManagedObjects(bool use_callbacks) {
 
 void ObjectManager::message_handle(Message& msg) {
     if (msg.is_signal(_interface_name, "InterfacesAdded")) {
-        std::string path = msg.extract().get_string();
-        msg.extract_next();
-        Holder options = msg.extract();
+        if (!msg.has_signature<ObjectPath, std::map<std::string, std::map<std::string, Holder>>>()) {
+            LOG_WARN("Malformed InterfacesAdded signal with signature {}", msg.get_signature());
+            return;
+        }
+
+        Cursor cursor(msg);
+        std::string path(cursor.get<std::string_view>());
+
+        // Only the interfaces that can be instantiated are decoded, the rest are skipped unread.
+        Holder::Dict interfaces;
+        cursor.next();
+        cursor.for_each_entry([&](const Cursor& key, const Cursor& value) {
+            std::string iface_name(key.get<std::string_view>());
+            if (InterfaceRegistry::getInstance().isRegistered(iface_name)) {
+                interfaces.emplace_back(Holder::create_string(iface_name), value.extract());
+            }
+            return true;
+        });
+
         if (InterfacesAdded) {
-            InterfacesAdded(path, options);
+            InterfacesAdded(path, Holder::create_dict(std::move(interfaces)));
         }
     } else if (msg.is_signal(_interface_name, "InterfacesRemoved")) {
-        std::string path = msg.extract().get_string();
-        msg.extract_next();
-        Holder options = msg.extract();
+        if (!msg.has_signature<ObjectPath, std::vector<std::string>>()) {
+            LOG_WARN("Malformed InterfacesRemoved signal with signature {}", msg.get_signature());
+            return;
+        }
+
+        Cursor cursor(msg);
+        std::string path(cursor.get<std::string_view>());
+
+        Holder interfaces = Holder::create_array();
+        cursor.next();
+        for (Cursor name = cursor.recurse(); !name.at_end(); name.next()) {
+            interfaces.array_append(Holder::create_string(std::string(name.get<std::string_view>())));
+        }
+
         if (InterfacesRemoved) {
-            InterfacesRemoved(path, options);
+            InterfacesRemoved(path, interfaces);
         }
         // TODO: Make a call directly to the proxy to do this?
 
@@ -1,4 +1,6 @@
 #include <simpledbus/advanced/Proxy.h>
+#include <simpledbus/base/Cursor.h>
+#include <simpledbus/base/Logging.h>
 #include <simpledbus/interfaces/Properties.h>
 
 using namespace SimpleDBus;
@@ -37,8 +39,7 @@ Holder Properties::GetAll(const std::string& interface_name) {
     query_msg.append_argument(h_interface, "s");
 
     Message reply_msg = _conn->send_with_reply_and_block(query_msg);
-    Holder result = reply_msg.extract();
-    return result;
+    return Cursor(reply_msg).extract();
 }
 
 void Properties::Set(const std::string& interface_name, const std::string& property_name, const Holder& value) {
@@ -72,20 +73,7 @@ void Properties::PropertiesChanged(const std::string& interface_name,
                                    const std::vector<std::string>& invalidated_properties) {
     Message signal_msg = Message::create_signal(_path, "org.freedesktop.DBus.Properties", "PropertiesChanged");
 
-    Holder interface_h = Holder::create_string(interface_name);
-    signal_msg.append_argument(interface_h, "s");
-
-    Holder changed_properties_h = Holder::create_dict();
-    for (const auto& [key, value] : changed_properties) {
-        changed_properties_h.dict_append(Holder::STRING, key, value);
-    }
-    signal_msg.append_argument(changed_properties_h, "a{sv}");
-
-    Holder invalidated_properties_h = Holder::create_array();
-    for (const auto& property : invalidated_properties) {
-        invalidated_properties_h.array_append(Holder::create_string(property));
-    }
-    signal_msg.append_argument(invalidated_properties_h, "as");
+    signal_msg.append(interface_name, changed_properties, invalidated_properties);
     _conn->send(signal_msg);
 }
 
@@ -95,13 +83,7 @@ void Properties::message_handle(Message& msg) {
         std::string iface_name = interface_h.get_string();
 
         std::shared_ptr<Interface> interface = proxy()->interface_get(iface_name);
-        SimpleDBus::Holder properties = SimpleDBus::Holder::create_dict();
-        {
-            std::scoped_lock lock(interface->_property_update_mutex);
-            for (const auto& [key, value] : interface->_properties) {
-                properties.dict_append(SimpleDBus::Holder::Type::STRING, key, value);
-            }
-        }
+        SimpleDBus::Holder properties = interface->property_collect();
 
         SimpleDBus::Message reply = SimpleDBus::Message::create_method_return(msg);
         reply.append_argument(properties, "a{sv}");
@@ -117,24 +99,17 @@ void Properties::message_handle(Message& msg) {
 
         std::shared_ptr<Interface> interface = proxy()->interface_get(iface_name);
 
-        bool property_exists = false;
-        Holder property_value;
-        {
-            std::scoped_lock lock(interface->_property_update_mutex);
-            property_exists = interface->_properties.find(property_name) != interface->_properties.end();
-            if (property_exists) {
-                property_value = interface->_properties[property_name];
-            }
-        }
+        Holder properties = interface->property_collect();
+        const Holder* property_value = properties.dict_find(property_name);
 
-        if (!property_exists) {
+        if (property_value == nullptr) {
             SimpleDBus::Message reply = SimpleDBus::Message::create_error(msg, "org.freedesktop.DBus.Error.InvalidArgs", "Property not found");
             _conn->send(reply);
             return;
         }
 
         SimpleDBus::Message reply = SimpleDBus::Message::create_method_return(msg);
-        reply.append_argument(property_value, "v");
+        reply.append_argument(*property_value, "v");
         _conn->send(reply);
 
     } else if (msg.is_method_call(_interface_name, "Set")) {
@@ -149,31 +124,42 @@ void Properties::message_handle(Message& msg) {
         Holder value_h = msg.extract();
 
         std::shared_ptr<Interface> interface = proxy()->interface_get(iface_name);
-        {
-            std::scoped_lock lock(interface->_property_update_mutex);
-            // Only update the property if it exists.
-            // TODO: Should we send an error message if the property doesn't exist?
-            if (interface->_properties.find(property_name) != interface->_properties.end()) {
-                interface->_properties[property_name] = value_h;
-            }
-        }
+        // Only update the property if it exists.
+        // TODO: Should we send an error message if the property doesn't exist?
+        interface->property_assign(property_name, std::move(value_h));
 
         SimpleDBus::Message reply = SimpleDBus::Message::create_method_return(msg);
         _conn->send(reply);
 
     } else if (msg.is_signal(_interface_name, "PropertiesChanged")) {
-        Holder interface_h = msg.extract();
-        std::string iface_name = interface_h.get_string();
-        msg.extract_next();
-        Holder changed_properties = msg.extract();
-        msg.extract_next();
-        Holder invalidated_properties = msg.extract();
+        if (!msg.has_signature<std::string, std::vector<std::pair<std::string, Holder>>, std::vector<std::string>>()) {
+            LOG_WARN("Malformed PropertiesChanged signal with signature {}", msg.get_signature());
+            return;
+        }
+
+        Cursor cursor(msg);
+        std::string iface_name(cursor.get<std::string_view>());
 
-        // If the interface is not loaded, then ignore the message.
+        // If the interface is not loaded, then ignore the message without decoding the rest of it.
         if (!proxy()->interface_exists(iface_name)) {
             return;
         }
 
-        proxy()->interface_get(iface_name)->signal_property_changed(changed_properties, invalidated_properties);
+        // Changed values are read straight into the holders they will be stored in.
+        std::vector<std::pair<std::string, Holder>> changed_properties;
+        cursor.next();
+        cursor.for_each_entry([&](const Cursor& key, const Cursor& value) {
+            changed_properties.emplace_back(key.get<std::string_view>(), value.extract());
+            return true;
+        });
+
+        std::vector<std::string> invalidated_properties;
+        cursor.next();
+        for (Cursor name = cursor.recurse(); !name.at_end(); name.next()) {
+            invalidated_properties.emplace_back(name.get<std::string_view>());
+        }
+
+        proxy()->interface_get(iface_name)->signal_property_changed(std::move(changed_properties),
+                                                                   invalidated_properties);
     }
 }
\ No newline at end of file
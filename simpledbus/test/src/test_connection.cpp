@@ -0,0 +1,464 @@
+#include <gtest/gtest.h>
+
+#include <simpledbus/advanced/Replayer.h>
+#include <simpledbus/base/Connection.h>
+#include <simpledbus/base/Exceptions.h>
+#include <simpledbus/base/Message.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace SimpleDBus;
+
+class ConnectionTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        conn = new Connection(DBUS_BUS_SESSION);
+        conn->init();
+        server = new Connection(DBUS_BUS_SESSION);
+        server->init();
+    }
+
+    void TearDown() override {
+        dispatch_stop();
+        server->uninit();
+        delete server;
+        server = nullptr;
+        conn->uninit();
+        delete conn;
+        conn = nullptr;
+    }
+
+    // Exports an object on the server answering calls with their own arguments, or with an
+    // error if the method is "Fail".
+    void serve_echo(const std::string& path) {
+        server->register_object_path(path, [this](Message& call) {
+            if (call.get_member() == "Fail") {
+                Message error = Message::create_error(call, "org.simpledbus.Error.Test", "Failed on purpose");
+                server->send(error);
+                return;
+            }
+            Message reply = Message::create_method_return(call);
+            reply.append_argument(call.extract(), DBUS_TYPE_STRING_AS_STRING);
+            server->send(reply);
+        });
+    }
+
+    void dispatch_start(Connection* connection) {
+        dispatch_threads.emplace_back([this, connection]() {
+            while (running) {
+                connection->read_write_dispatch();
+                connection->process_events(10);
+            }
+        });
+        dispatch_connections.push_back(connection);
+    }
+
+    void dispatch_stop() {
+        running = false;
+        for (Connection* connection : dispatch_connections) {
+            connection->wakeup();
+        }
+        for (std::thread& thread : dispatch_threads) {
+            thread.join();
+        }
+        dispatch_threads.clear();
+        dispatch_connections.clear();
+    }
+
+    template <typename Predicate>
+    static bool wait_for(Predicate predicate, std::chrono::milliseconds timeout = std::chrono::seconds(5)) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!predicate()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return true;
+    }
+
+    Connection* conn;
+    Connection* server;
+    std::atomic_bool running = true;
+    std::vector<std::thread> dispatch_threads;
+    std::vector<Connection*> dispatch_connections;
+};
+
+TEST_F(ConnectionTest, AsyncCallWithCallback) {
+    serve_echo("/simpledbus/test/echo");
+    dispatch_start(server);
+    dispatch_start(conn);
+
+    std::promise<Message> received;
+    Message msg = Message::create_method_call(server->unique_name(), "/simpledbus/test/echo", "simpledbus.test",
+                                              "Echo");
+    msg.append_argument(Holder::create_string("hello"), DBUS_TYPE_STRING_AS_STRING);
+    conn->send_with_reply_async(msg, [&received](Message& reply) { received.set_value(reply); });
+
+    // The callback is invoked by the dispatching thread once the reply arrives.
+    std::future<Message> reply = received.get_future();
+    ASSERT_EQ(reply.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    Message result = reply.get();
+    EXPECT_EQ(result.get_type(), Message::Type::METHOD_RETURN);
+    EXPECT_EQ(result.extract().get_string(), "hello");
+}
+
+TEST_F(ConnectionTest, AsyncCallWithFuture) {
+    serve_echo("/simpledbus/test/echo");
+    dispatch_start(server);
+    dispatch_start(conn);
+
+    Message msg = Message::create_method_call(server->unique_name(), "/simpledbus/test/echo", "simpledbus.test",
+                                              "Echo");
+    msg.append_argument(Holder::create_string("hello"), DBUS_TYPE_STRING_AS_STRING);
+    std::future<Message> reply = conn->send_with_reply_async(msg);
+    ASSERT_EQ(reply.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(reply.get().extract().get_string(), "hello");
+
+    // Error replies are rethrown by the future.
+    Message failing = Message::create_method_call(server->unique_name(), "/simpledbus/test/echo", "simpledbus.test",
+                                                  "Fail");
+    std::future<Message> error = conn->send_with_reply_async(failing);
+    ASSERT_EQ(error.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_THROW(error.get(), Exception::SendFailed);
+}
+
+TEST_F(ConnectionTest, BlockingCallDefaultTimeoutWithDispatchThread) {
+    // A peer answering after a delay, on its own dispatch thread.
+    server->register_object_path("/simpledbus/test/delayed", [this](Message& call) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        Message reply = Message::create_method_return(call);
+        server->send(reply);
+    });
+    dispatch_start(server);
+    dispatch_start(conn);
+
+    // Replies are delivered by the dispatch thread, and the default timeout still waits for them.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    Message msg = Message::create_method_call(server->unique_name(), "/simpledbus/test/delayed", "simpledbus.test",
+                                              "Delayed");
+    Message reply;
+    EXPECT_NO_THROW(reply = conn->send_with_reply_and_block(msg, Connection::TIMEOUT_DEFAULT));
+    EXPECT_EQ(reply.get_type(), Message::Type::METHOD_RETURN);
+}
+
+TEST_F(ConnectionTest, CallTimeout) {
+    // A peer that never answers.
+    server->register_object_path("/simpledbus/test/silent", [](Message&) {});
+    dispatch_start(server);
+    dispatch_start(conn);
+
+    Message msg = Message::create_method_call(server->unique_name(), "/simpledbus/test/silent", "simpledbus.test",
+                                              "Silent");
+    try {
+        conn->send_with_reply_and_block(msg, std::chrono::milliseconds(100));
+        ADD_FAILURE() << "The call did not time out";
+    } catch (const Exception::SendFailed& e) {
+        EXPECT_NE(std::string(e.what()).find(DBUS_ERROR_NO_REPLY), std::string::npos) << e.what();
+    }
+
+    std::promise<std::string> received;
+    Message async = Message::create_method_call(server->unique_name(), "/simpledbus/test/silent", "simpledbus.test",
+                                                "Silent");
+    conn->send_with_reply_async(
+        async,
+        [&received](Message& reply) {
+            const char* error = dbus_message_get_error_name(reply);
+            received.set_value(error != nullptr ? error : "");
+        },
+        std::chrono::milliseconds(100));
+
+    std::future<std::string> error = received.get_future();
+    ASSERT_EQ(error.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(error.get(), DBUS_ERROR_NO_REPLY);
+}
+
+TEST_F(ConnectionTest, CancelPendingCalls) {
+    // Peers that never answer.
+    std::atomic<size_t> calls = 0;
+    for (const char* path :
+         {"/simpledbus/test/silent/a", "/simpledbus/test/silent/b", "/simpledbus/test/silent_other"}) {
+        server->register_object_path(path, [&calls](Message&) { calls++; });
+    }
+    dispatch_start(server);
+    dispatch_start(conn);
+
+    auto call = [this](const std::string& path) {
+        return Message::create_method_call(server->unique_name(), path, "simpledbus.test", "Silent");
+    };
+
+    std::promise<std::string> received;
+    Message async = call("/simpledbus/test/silent/a");
+    conn->send_with_reply_async(async, [&received](Message& reply) {
+        const char* error = dbus_message_get_error_name(reply);
+        received.set_value(error != nullptr ? error : "");
+    });
+
+    std::promise<std::string> thrown;
+    std::thread blocking([this, &call, &thrown]() {
+        Message msg = call("/simpledbus/test/silent/b");
+        try {
+            conn->send_with_reply_and_block(msg, std::chrono::seconds(10));
+            thrown.set_value("");
+        } catch (const Exception::SendFailed& e) {
+            thrown.set_value(e.what());
+        }
+    });
+
+    // Calls to other objects are left alone.
+    Message other = call("/simpledbus/test/silent_other");
+    std::future<Message> untouched = conn->send_with_reply_async(other);
+
+    EXPECT_TRUE(wait_for([&calls]() { return calls == 3; }));
+    conn->cancel_pending_calls("/simpledbus/test/silent");
+
+    std::future<std::string> error = received.get_future();
+    ASSERT_EQ(error.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(error.get(), Connection::ERROR_CANCELLED);
+
+    std::future<std::string> what = thrown.get_future();
+    EXPECT_EQ(what.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    blocking.join();
+    EXPECT_NE(what.get().find(Connection::ERROR_CANCELLED), std::string::npos);
+
+    EXPECT_EQ(untouched.wait_for(std::chrono::milliseconds(100)), std::future_status::timeout);
+}
+
+TEST_F(ConnectionTest, DispatchWorkersKeepOrderPerObject) {
+    static constexpr size_t OBJECTS = 8;
+    static constexpr uint32_t SIGNALS = 50;
+
+    Connection receiver(DBUS_BUS_SESSION);
+    receiver.set_dispatch_workers(4);
+    receiver.init();
+
+    std::mutex received_mutex;
+    std::map<std::string, std::vector<uint32_t>> received;
+    for (size_t i = 0; i < OBJECTS; i++) {
+        std::string path = "/simpledbus/test/object_" + std::to_string(i);
+        receiver.register_signal_handler(path, [&received_mutex, &received, path](Message& msg) {
+            uint32_t sequence = msg.extract().get_uint32();
+            // Some work, so that the signals of different objects overlap on the workers.
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            std::lock_guard<std::mutex> lock(received_mutex);
+            received[path].push_back(sequence);
+        });
+    }
+    receiver.add_match("type='signal',sender='" + conn->unique_name() + "'");
+    dispatch_start(&receiver);
+
+    for (uint32_t sequence = 0; sequence < SIGNALS; sequence++) {
+        for (size_t i = 0; i < OBJECTS; i++) {
+            Message msg = Message::create_signal("/simpledbus/test/object_" + std::to_string(i), "simpledbus.test",
+                                                 "Changed");
+            msg.append_argument(Holder::create_uint32(sequence), DBUS_TYPE_UINT32_AS_STRING);
+            conn->send(msg);
+        }
+    }
+
+    EXPECT_TRUE(wait_for([&received_mutex, &received]() {
+        std::lock_guard<std::mutex> lock(received_mutex);
+        size_t total = 0;
+        for (const auto& [path, sequences] : received) {
+            total += sequences.size();
+        }
+        return total == OBJECTS * SIGNALS;
+    }));
+    dispatch_stop();
+
+    // Every object sees its own signals in the order they were sent.
+    std::vector<uint32_t> expected;
+    for (uint32_t sequence = 0; sequence < SIGNALS; sequence++) {
+        expected.push_back(sequence);
+    }
+    EXPECT_EQ(received.size(), OBJECTS);
+    for (const auto& [path, sequences] : received) {
+        EXPECT_EQ(sequences, expected) << path;
+    }
+
+    for (size_t i = 0; i < OBJECTS; i++) {
+        receiver.unregister_signal_handler("/simpledbus/test/object_" + std::to_string(i));
+    }
+    receiver.uninit();
+}
+
+TEST_F(ConnectionTest, SignalsOfAnnouncedObjectWithDispatchWorkers) {
+    static constexpr size_t OBJECTS = 32;
+
+    Connection receiver(DBUS_BUS_SESSION);
+    receiver.set_dispatch_workers(4);
+    receiver.init();
+
+    // Routes of the objects are registered when they are announced, as proxies do, and take a
+    // while to set up so that the signals following the announcement are dispatched meanwhile.
+    std::mutex received_mutex;
+    std::map<std::string, size_t> received;
+    receiver.register_signal_handler("/", [&receiver, &received_mutex, &received](Message& msg) {
+        if (!msg.is_signal("org.freedesktop.DBus.ObjectManager", "InterfacesAdded")) {
+            return;
+        }
+        std::string path = msg.extract().get_object_path();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        receiver.register_signal_handler(path, [&received_mutex, &received, path](Message&) {
+            std::lock_guard<std::mutex> lock(received_mutex);
+            received[path]++;
+        });
+    });
+    receiver.add_match("type='signal',sender='" + conn->unique_name() + "'");
+    dispatch_start(&receiver);
+
+    for (size_t i = 0; i < OBJECTS; i++) {
+        std::string path = "/simpledbus/test/object_" + std::to_string(i);
+
+        Message added = Message::create_signal("/", "org.freedesktop.DBus.ObjectManager", "InterfacesAdded");
+        added.append_argument(Holder::create_object_path(path), DBUS_TYPE_OBJECT_PATH_AS_STRING);
+        conn->send(added);
+
+        Message changed = Message::create_signal(path, "org.freedesktop.DBus.Properties", "PropertiesChanged");
+        conn->send(changed);
+    }
+
+    // Every object receives the signal sent right after it was announced.
+    EXPECT_TRUE(wait_for([&received_mutex, &received]() {
+        std::lock_guard<std::mutex> lock(received_mutex);
+        return received.size() == OBJECTS;
+    }));
+    dispatch_stop();
+
+    for (const auto& [path, count] : received) {
+        EXPECT_EQ(count, 1u) << path;
+    }
+    for (size_t i = 0; i < OBJECTS; i++) {
+        receiver.unregister_signal_handler("/simpledbus/test/object_" + std::to_string(i));
+    }
+    receiver.unregister_signal_handler("/");
+    receiver.uninit();
+}
+
+TEST_F(ConnectionTest, HeldSignalsReachLateRoute) {
+    for (size_t workers : {0, 4}) {
+        Connection receiver(DBUS_BUS_SESSION);
+        receiver.set_dispatch_workers(workers);
+        receiver.set_signal_hold(std::chrono::seconds(5));
+        receiver.init();
+        receiver.add_match("type='signal',sender='" + conn->unique_name() + "'");
+        running = true;
+        dispatch_start(&receiver);
+
+        auto send = [this](const std::string& value) {
+            Message msg = Message::create_signal("/simpledbus/test/late", "simpledbus.test", "Changed");
+            msg.append_argument(Holder::create_string(value), DBUS_TYPE_STRING_AS_STRING);
+            conn->send(msg);
+        };
+
+        // Signals arriving before the route are handed to it once registered, ahead of later ones.
+        send("first");
+        send("second");
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        std::mutex received_mutex;
+        std::vector<std::string> received;
+        receiver.register_signal_handler("/simpledbus/test/late", [&received_mutex, &received](Message& msg) {
+            std::lock_guard<std::mutex> lock(received_mutex);
+            received.push_back(msg.extract().get_string());
+        });
+        send("third");
+
+        EXPECT_TRUE(wait_for([&received_mutex, &received]() {
+            std::lock_guard<std::mutex> lock(received_mutex);
+            return received.size() == 3;
+        })) << workers << " workers";
+        dispatch_stop();
+
+        EXPECT_EQ(received, std::vector<std::string>({"first", "second", "third"})) << workers << " workers";
+        receiver.unregister_signal_handler("/simpledbus/test/late");
+        receiver.uninit();
+    }
+}
+
+TEST(Replayer, RoundTrip) {
+    const std::string filename = ::testing::TempDir() + "simpledbus_test_replay.rec";
+    const std::string path = "/simpledbus/test/replayed";
+
+    auto changed = [&path](const std::string& value, uint32_t serial) {
+        Message msg = Message::create_signal(path, "simpledbus.test", "Changed");
+        msg.append_argument(Holder::create_string(value), DBUS_TYPE_STRING_AS_STRING);
+        dbus_message_set_serial(msg, serial);
+        return msg;
+    };
+
+    // A session made of a signal, a call answered by the peer and another signal.
+    {
+        RecordingWriter writer(filename);
+        writer.write(RecordedMessage::Direction::RECEIVED, changed("one", 1));
+
+        Message call = Message::create_method_call("org.simpledbus.Test", path, "simpledbus.test", "Read");
+        dbus_message_set_serial(call, 2);
+        writer.write(RecordedMessage::Direction::SENT, call);
+
+        Message reply = Message::create_method_return(call);
+        reply.append_argument(Holder::create_string("value"), DBUS_TYPE_STRING_AS_STRING);
+        dbus_message_set_serial(reply, 3);
+        writer.write(RecordedMessage::Direction::RECEIVED, reply);
+
+        writer.write(RecordedMessage::Direction::RECEIVED, changed("two", 4));
+        writer.flush();
+    }
+
+    // The same calls made by a fresh connection get the recorded replies, without a bus.
+    Replayer replayer(filename);
+    Connection client(replayer.address());
+    replayer.start();
+    client.init();
+
+    std::mutex received_mutex;
+    std::vector<std::string> received;
+    client.register_signal_handler(path, [&received_mutex, &received](Message& msg) {
+        std::lock_guard<std::mutex> lock(received_mutex);
+        received.push_back(msg.extract().get_string());
+    });
+
+    std::atomic_bool running = true;
+    std::thread dispatch([&client, &running]() {
+        while (running) {
+            client.read_write_dispatch();
+            client.process_events(10);
+        }
+    });
+
+    Message call = Message::create_method_call("org.simpledbus.Test", path, "simpledbus.test", "Read");
+    Message reply;
+    EXPECT_NO_THROW(reply = client.send_with_reply_and_block(call, std::chrono::seconds(5)));
+    EXPECT_EQ(reply.extract().get_string(), "value");
+    replayer.wait();
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline) {
+        {
+            std::lock_guard<std::mutex> lock(received_mutex);
+            if (received.size() == 2) {
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    running = false;
+    client.wakeup();
+    dispatch.join();
+
+    EXPECT_EQ(received, std::vector<std::string>({"one", "two"}));
+    EXPECT_EQ(replayer.delivered(), 3u);
+    EXPECT_EQ(replayer.skipped(), 0u);
+
+    client.unregister_signal_handler(path);
+    client.uninit();
+    std::remove(filename.c_str());
+}
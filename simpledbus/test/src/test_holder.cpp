@@ -6,6 +6,7 @@
 #include <map>
 #include <string>
 #include <variant>
+#include <vector>
 
 using namespace SimpleDBus;
 
@@ -136,6 +137,31 @@ TEST(Holder, ArrayHeterogeneous) {
     EXPECT_EQ(h.represent(), "Array:\n  42\n  Hello, world!\n");
 }
 
+TEST(Holder, ByteArray) {
+    std::vector<uint8_t> bytes = {0x01, 0x02, 0xAB};
+    Holder h = Holder::create_byte_array(bytes);
+
+    EXPECT_EQ(h.get_byte_array(), bytes);
+    EXPECT_EQ(h.get_array().size(), 3);
+    EXPECT_EQ(h.get_array()[2].get_byte(), 0xAB);
+
+    EXPECT_EQ(h.type(), Holder::Type::BYTE_ARRAY);
+
+    EXPECT_EQ(h.signature(), "ay");
+
+    EXPECT_EQ(h.represent(), "Array:\n  01 02 ab \n");
+
+    Holder array = Holder::create_array();
+    for (uint8_t byte : bytes) {
+        array.array_append(Holder::create_byte(byte));
+    }
+    EXPECT_EQ(h, array);
+
+    h.array_append(Holder::create_string("Hello"));
+    EXPECT_EQ(h.type(), Holder::Type::ARRAY);
+    EXPECT_EQ(h.get_array().size(), 4);
+}
+
 TEST(Holder, DictionaryHomogeneousString) {
     Holder h = Holder::create_dict();
 
@@ -181,4 +207,103 @@ TEST(Holder, DictionaryHeterogeneous) {
     // TODO: Expand this test to check with all remaining types.
 }
 
+TEST(Holder, DictionaryLookup) {
+    Holder h = Holder::create_dict();
+    h.dict_append(Holder::Type::STRING, "b", Holder::create_int32(2));
+    h.dict_append(Holder::Type::STRING, "a", Holder::create_int32(1));
+    h.dict_append(Holder::Type::OBJ_PATH, "/a", Holder::create_int32(3));
+    h.dict_append(Holder::Type::STRING, "b", Holder::create_int32(4));
+
+    // Entries are kept sorted, and the last value of a duplicate key wins.
+    ASSERT_EQ(h.dict_entries().size(), 3);
+    EXPECT_EQ(h.dict_entries()[0].first.get_string(), "a");
+    EXPECT_EQ(h.dict_find("b")->get_int32(), 4);
+    EXPECT_EQ(h.dict_find(ObjectPath("/a"))->get_int32(), 3);
+    EXPECT_EQ(h.dict_find(Holder::create_string("a"))->get_int32(), 1);
+    EXPECT_EQ(h.dict_find("/a"), nullptr);
+    EXPECT_EQ(h.dict_find("c"), nullptr);
+
+    Holder unsorted = Holder::create_dict({{Holder::create_string("b"), Holder::create_int32(4)},
+                                           {Holder::create_object_path("/a"), Holder::create_int32(3)},
+                                           {Holder::create_string("a"), Holder::create_int32(1)}});
+    EXPECT_EQ(h, unsorted);
+}
+
+TEST(Holder, BorrowingViews) {
+    Holder array = Holder::create_array();
+    array.array_append(Holder::create_string("first"));
+    array.array_append(Holder::create_string("second"));
+
+    // Views point into the holder rather than into copies of its contents.
+    EXPECT_EQ(&array.array_view(), &array.array_view());
+    ASSERT_EQ(array.array_view().size(), 2);
+    EXPECT_EQ(array.array_view()[1].get_string_view(), "second");
+    EXPECT_THROW(Holder::create_byte_array({1, 2}).array_view(), std::invalid_argument);
+    EXPECT_TRUE(Holder::create_int32(1).get_string_view().empty());
+
+    Holder h = Holder::create_dict();
+    h.dict_append(Holder::Type::UINT16, static_cast<uint16_t>(2), Holder::create_int32(2));
+    h.dict_append(Holder::Type::STRING, "a", Holder::create_int32(3));
+    h.dict_append(Holder::Type::UINT16, static_cast<uint16_t>(1), Holder::create_int32(1));
+
+    auto view = h.dict_view<uint16_t>();
+    ASSERT_EQ(view.size(), 2);
+    EXPECT_EQ(view.begin()->first.get_uint16(), 1);
+    EXPECT_EQ(view.begin()->second.get_int32(), 1);
+    EXPECT_EQ(h.dict_view(Holder::Type::STRING).size(), 1);
+    EXPECT_TRUE(h.dict_view<ObjectPath>().empty());
+    EXPECT_TRUE(Holder().dict_view<std::string>().empty());
+}
+
+TEST(Holder, DictTake) {
+    Holder h = Holder::create_dict();
+    h.dict_append(Holder::Type::STRING, "b", Holder::create_byte_array({1, 2}));
+    h.dict_append(Holder::Type::STRING, "a", Holder::create_int32(1));
+    const uint8_t* bytes = h.dict_find("b")->byte_array().data();
+
+    // Entries are moved out in order, and leave an empty dictionary behind.
+    Holder::Dict entries = h.dict_take();
+    ASSERT_EQ(entries.size(), 2);
+    EXPECT_EQ(entries[0].first.get_string(), "a");
+    EXPECT_EQ(entries[1].second.byte_array().data(), bytes);
+    EXPECT_EQ(h.type(), Holder::Type::DICT);
+    EXPECT_TRUE(h.dict_entries().empty());
+    EXPECT_TRUE(Holder::create_int32(1).dict_take().empty());
+
+    Holder array = Holder::create_array({Holder::create_string("first"), Holder::create_string("second")});
+    EXPECT_EQ(array.type(), Holder::Type::ARRAY);
+    EXPECT_EQ(array.array_view()[1].get_string(), "second");
+}
+
+TEST(Holder, Hash) {
+    Holder a = Holder::create_dict();
+    a.dict_append(Holder::Type::UINT16, static_cast<uint16_t>(0x004C), Holder::create_byte_array({1, 2, 3}));
+    Holder b = Holder::create_dict();
+    Holder bytes = Holder::create_array();
+    for (uint8_t byte : {1, 2, 3}) {
+        bytes.array_append(Holder::create_byte(byte));
+    }
+    b.dict_append(Holder::Type::UINT16, static_cast<uint16_t>(0x004C), bytes);
+
+    // Holders that compare equal hash alike, byte arrays included.
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a.hash(), b.hash());
+    EXPECT_EQ(Holder::create_double(0.0).hash(), Holder::create_double(-0.0).hash());
+    EXPECT_NE(Holder::create_int16(1).hash(), Holder::create_uint16(1).hash());
+
+    // The cached hash follows modifications and copies.
+    size_t hash = a.hash();
+    a.dict_append(Holder::Type::UINT16, static_cast<uint16_t>(0x0059), Holder::create_byte_array({4}));
+    EXPECT_NE(a.hash(), hash);
+    EXPECT_NE(a, b);
+    Holder copy = a;
+    EXPECT_EQ(copy.hash(), a.hash());
+    EXPECT_EQ(copy, a);
+
+    // Values compare the same as with equality, byte arrays included.
+    EXPECT_TRUE(copy.same_value(a));
+    EXPECT_FALSE(b.same_value(a));
+    EXPECT_TRUE(Holder::create_byte_array({1, 2, 3}).same_value(bytes));
+}
+
 // TODO: Add tests for equality comparison of Holders.
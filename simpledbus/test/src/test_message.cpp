@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <simpledbus/base/CallTemplate.h>
 #include <simpledbus/base/Connection.h>
+#include <simpledbus/base/Cursor.h>
 #include <simpledbus/base/Message.h>
 
 #include <chrono>
@@ -398,4 +400,140 @@ TEST_F(MessageTest, MoveAssignment) {
     EXPECT_EQ(move_assigned.get_path(), "/org/example/Path");
     EXPECT_EQ(move_assigned.get_interface(), "org.example.Interface");
     EXPECT_EQ(move_assigned.get_member(), "ExampleMethod");
-}
\ No newline at end of file
+}
+TEST(Message, TypedAppendRead) {
+    static_assert(std::string_view(Marshal::signature<std::vector<uint8_t>, std::map<std::string, Holder>>.c_str()) ==
+                  "aya{sv}");
+
+    Message msg = Message::create_signal("/org/example/Path", "org.example.Interface", "ExampleSignal");
+    std::map<std::string, Holder> options = {{"type", Holder::create_string("request")}};
+    std::vector<uint8_t> value = {0x01, 0x02, 0x03};
+    msg.append(value, options, ObjectPath("/a"), std::vector<std::string>{"first", "second"});
+
+    // Typed arguments can be read back either way.
+    auto [bytes, dict, path, strings] =
+        msg.read<Marshal::ByteView, std::vector<std::pair<std::string, Holder>>, ObjectPath, std::vector<std::string>>();
+    EXPECT_EQ(std::vector<uint8_t>(bytes.data, bytes.data + bytes.size), value);
+    ASSERT_EQ(dict.size(), 1);
+    EXPECT_EQ(dict[0].first, "type");
+    EXPECT_EQ(dict[0].second.get_string(), "request");
+    EXPECT_EQ(std::string(path), "/a");
+    EXPECT_EQ(strings[1], "second");
+
+    EXPECT_EQ(msg.extract().byte_array(), value);
+    msg.extract_next();
+    EXPECT_EQ(msg.extract().dict_find("type")->get_string(), "request");
+
+    EXPECT_THROW(msg.read<std::string>(), Exception::SignatureMismatch);
+
+    // Arguments appended as Holders can be read typed.
+    Message other = Message::create_signal("/org/example/Path", "org.example.Interface", "ExampleSignal");
+    other.append_argument(Holder::create_int16(-5), "n");
+    other.append_argument(Holder::create_boolean(true), "b");
+    auto [number, flag] = other.read<int16_t, bool>();
+    EXPECT_EQ(number, -5);
+    EXPECT_TRUE(flag);
+}
+
+TEST(Message, CopyOnWrite) {
+    Message original = Message::create_signal("/org/example/Path", "org.example.Interface", "ExampleSignal");
+    original.append_argument(Holder::create_string("first"), "s");
+    original.append_argument(Holder::create_uint32(2), "u");
+    EXPECT_EQ(original.extract().get_string(), "first");
+    original.extract_next();
+
+    // Copies share the message and resume reading from the same argument.
+    Message copy(original);
+    EXPECT_EQ(static_cast<DBusMessage*>(copy), static_cast<DBusMessage*>(original));
+    EXPECT_EQ(copy.extract().get_uint32(), 2);
+
+    // Appending to a copy leaves the other one untouched.
+    copy.append_argument(Holder::create_boolean(true), "b");
+    EXPECT_NE(static_cast<DBusMessage*>(copy), static_cast<DBusMessage*>(original));
+    EXPECT_STREQ(dbus_message_get_signature(original), "su");
+    EXPECT_STREQ(dbus_message_get_signature(copy), "sub");
+    EXPECT_EQ(original.extract().get_uint32(), 2);
+
+    // Once the other copies are gone, the message is appended to in place.
+    DBusMessage* detached = copy;
+    copy.append_argument(Holder::create_boolean(false), "b");
+    EXPECT_EQ(static_cast<DBusMessage*>(copy), detached);
+
+    // Messages also referenced outside of the copies are always duplicated.
+    Message retained = Message::from_retained(original);
+    retained.append_argument(Holder::create_boolean(true), "b");
+    EXPECT_NE(static_cast<DBusMessage*>(retained), static_cast<DBusMessage*>(original));
+    EXPECT_STREQ(dbus_message_get_signature(original), "su");
+}
+
+TEST(Message, CallTemplate) {
+    CallTemplate call("org.example", "/org/example/Path", "org.example.Interface", "ExampleMethod");
+    ASSERT_TRUE(call.is_valid());
+
+    const std::map<std::string, Holder> options = {{"type", Holder::create_string("command")}};
+    std::vector<uint8_t> payload = {1, 2, 3};
+    Message first = call.create(Marshal::ByteView(payload.data(), payload.size()), options);
+    Message second = call.create(Marshal::ByteView(payload.data(), 2), options);
+
+    // Every call owns its message, which carries the header of the template.
+    EXPECT_NE(static_cast<DBusMessage*>(first), static_cast<DBusMessage*>(second));
+    EXPECT_EQ(first.get_type(), Message::Type::METHOD_CALL);
+    EXPECT_EQ(first.get_path(), "/org/example/Path");
+    EXPECT_EQ(first.get_interface(), "org.example.Interface");
+    EXPECT_EQ(first.get_member(), "ExampleMethod");
+    EXPECT_STREQ(dbus_message_get_destination(first), "org.example");
+    EXPECT_EQ(first.get_serial(), 0);
+    EXPECT_STREQ(dbus_message_get_signature(first), "aya{sv}");
+
+    auto [first_payload, first_options] = first.read<Marshal::ByteView, std::map<std::string, Holder>>();
+    auto [second_payload, second_options] = second.read<Marshal::ByteView, std::map<std::string, Holder>>();
+    EXPECT_EQ(first_payload.size, 3);
+    EXPECT_EQ(second_payload.size, 2);
+    EXPECT_EQ(first_options.at("type").get_string(), "command");
+
+    // The template itself never receives arguments.
+    EXPECT_STREQ(dbus_message_get_signature(call.create()), "");
+}
+
+TEST(Message, Cursor) {
+    Message msg = Message::create_signal("/org/example/Path", "org.example.Interface", "ExampleSignal");
+    std::map<std::string, std::map<std::string, Holder>> interfaces = {
+        {"org.example.First", {{"Value", Holder::create_uint32(7)}}},
+        {"org.example.Second", {{"Name", Holder::create_string("second")}, {"Flag", Holder::create_boolean(true)}}}};
+    msg.append(ObjectPath("/a"), interfaces, std::vector<std::string>{"x", "y"});
+
+    Cursor cursor(msg);
+    EXPECT_EQ(cursor.type(), DBUS_TYPE_OBJECT_PATH);
+    EXPECT_EQ(cursor.get<std::string_view>(), "/a");
+
+    // Entries can be skipped without being decoded, or extracted.
+    ASSERT_TRUE(cursor.next());
+    std::vector<std::string> visited;
+    Holder second;
+    cursor.for_each_entry([&](const Cursor& key, const Cursor& value) {
+        visited.emplace_back(key.get<std::string_view>());
+        if (visited.back() == "org.example.Second") {
+            second = value.extract();
+        }
+        return true;
+    });
+    EXPECT_EQ(visited, std::vector<std::string>({"org.example.First", "org.example.Second"}));
+    EXPECT_EQ(second.dict_find("Name")->get_string(), "second");
+    EXPECT_TRUE(second.dict_find("Flag")->get_boolean());
+
+    // Returning false stops the iteration.
+    size_t count = 0;
+    cursor.for_each_entry([&](const Cursor&, const Cursor&) { return ++count < 1; });
+    EXPECT_EQ(count, 1);
+
+    ASSERT_TRUE(cursor.next());
+    std::vector<std::string> strings;
+    for (Cursor name = cursor.recurse(); !name.at_end(); name.next()) {
+        strings.emplace_back(name.get<std::string_view>());
+    }
+    EXPECT_EQ(strings, std::vector<std::string>({"x", "y"}));
+
+    EXPECT_FALSE(cursor.next());
+    EXPECT_TRUE(cursor.at_end());
+    EXPECT_TRUE(cursor.recurse().at_end());
+}
@@ -36,6 +36,10 @@ TEST(Path, RecognizeDescendant) {
     EXPECT_TRUE(PathUtils::is_descendant("/a/b", "/a/b/c"));
     EXPECT_TRUE(PathUtils::is_descendant("/a/b", "/a/b/c/d"));
     EXPECT_TRUE(PathUtils::is_descendant("/a/b", "/a/b/c/d/e"));
+
+    // Sharing a prefix doesn't make a path a descendant, unless it ends on an element boundary.
+    EXPECT_FALSE(PathUtils::is_descendant("/a/b", "/a/bc"));
+    EXPECT_FALSE(PathUtils::is_descendant("/a/dev_1", "/a/dev_10/c"));
 }
 
 TEST(Path, RecognizeAscendant) {
@@ -74,3 +78,51 @@ TEST(Path, GenerateNextChild) {
     EXPECT_EQ("/a/b/c", PathUtils::next_child("/a/b", "/a/b/c/d/e"));
     EXPECT_EQ("/a/b/c/d", PathUtils::next_child("/a/b/c", "/a/b/c/d/e"));
 }
+
+TEST(Path, GenerateNextChildStrip) {
+    EXPECT_EQ("a", PathUtils::next_child_strip("/", "/a/b/c"));
+    EXPECT_EQ("b", PathUtils::next_child_strip("/a", "/a/b/c"));
+    EXPECT_EQ("c", PathUtils::next_child_strip("/a/b", "/a/b/c"));
+    EXPECT_EQ("", PathUtils::next_child_strip("/a/b/c", "/a/b/c"));
+}
+
+TEST(Path, Views) {
+    std::string path = "/a/b/c/d";
+    std::string_view child = PathUtils::next_child_view("/a", path);
+    EXPECT_EQ("/a/b", child);
+    EXPECT_EQ(path.data(), child.data());
+
+    EXPECT_EQ("/", PathUtils::fetch_elements_view(path, 0));
+    EXPECT_EQ("/a/b/c", PathUtils::fetch_elements_view(path, 3));
+    EXPECT_EQ("/a/b/c/d", PathUtils::fetch_elements_view(path, 9));
+    EXPECT_EQ("c", PathUtils::next_child_strip_view("/a/b", path));
+}
+
+TEST(Path, CachedElements) {
+    Path path("/a/bc/d");
+    EXPECT_EQ(3, path.count_elements());
+    EXPECT_EQ("a", path.element(0));
+    EXPECT_EQ("bc", path.element(1));
+    EXPECT_EQ("d", path.element(2));
+    EXPECT_EQ("", path.element(3));
+
+    EXPECT_EQ("/", path.prefix(0));
+    EXPECT_EQ("/a/bc", path.prefix(2));
+    EXPECT_EQ("/a/bc/d", path.prefix(3));
+    EXPECT_EQ("/a/bc", path.next_child(Path("/a")));
+    EXPECT_TRUE(path.is_child(Path("/a/bc")));
+    EXPECT_FALSE(path.is_child(Path("/a")));
+
+    EXPECT_EQ(0, Path("/").count_elements());
+}
+
+TEST(Path, Validate) {
+    EXPECT_NO_THROW(PathUtils::validate("/"));
+    EXPECT_NO_THROW(PathUtils::validate("/org/bluez/hci0/dev_00_11_22_33_44_55"));
+    EXPECT_NO_THROW(PathUtils::validate("/a/"));
+
+    EXPECT_THROW(PathUtils::validate(""), std::invalid_argument);
+    EXPECT_THROW(PathUtils::validate("a/b"), std::invalid_argument);
+    EXPECT_THROW(PathUtils::validate("/a//b"), std::invalid_argument);
+    EXPECT_THROW(PathUtils::validate("/a/b-c"), std::invalid_argument);
+}
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include <simpledbus/advanced/Interface.h>
+#include <simpledbus/advanced/Proxy.h>
+
+using namespace SimpleDBus;
+
+namespace {
+
+class TestInterface : public Interface {
+  public:
+    static constexpr Property<int16_t> RSSI{0, "RSSI"};
+    static constexpr Property<std::string> NAME{1, "Name"};
+    static constexpr Property<std::string> ADAPTER{2, "Adapter", false, Holder::OBJ_PATH};
+    static constexpr Property<std::vector<std::string>> UUIDS{3, "UUIDs"};
+    static constexpr Property<Holder> VALUE{4, "Value", true};
+
+    static const PropertyTable& property_table() {
+        static const PropertyTable table(RSSI, NAME, ADAPTER, UUIDS, VALUE);
+        return table;
+    }
+
+    TestInterface(std::shared_ptr<Proxy> proxy) : Interface(nullptr, proxy, "i.test", property_table()) {}
+
+    template <typename T>
+    T get(const Property<T>& key) {
+        std::scoped_lock lock(_property_update_mutex);
+        return property(key);
+    }
+
+    Holder get_undeclared(const std::string& name) {
+        std::scoped_lock lock(_property_update_mutex);
+        return property_view(name);
+    }
+
+    std::vector<PropertyId> changed_ids;
+    std::vector<std::string> changed_names;
+
+  protected:
+    void on_property_changed(PropertyId id) override { changed_ids.push_back(id); }
+    void property_changed(std::string option_name) override { changed_names.push_back(option_name); }
+};
+
+Holder string_array(const std::vector<std::string>& values) {
+    Holder array = Holder::create_array();
+    for (const auto& value : values) {
+        array.array_append(Holder::create_string(value));
+    }
+    return array;
+}
+
+}  // namespace
+
+TEST(PropertyTable, Lookup) {
+    const PropertyTable& table = TestInterface::property_table();
+
+    EXPECT_EQ(5, table.size());
+    EXPECT_EQ(TestInterface::RSSI.id, table.find("RSSI"));
+    EXPECT_EQ(TestInterface::UUIDS.id, table.find("UUIDs"));
+    EXPECT_EQ(TestInterface::VALUE.id, table.find("Value"));
+    EXPECT_EQ(PropertyTable::npos, table.find("Connected"));
+    EXPECT_EQ(PropertyTable::npos, PropertyTable::none().find("RSSI"));
+
+    EXPECT_TRUE(table.accepts(TestInterface::RSSI.id, Holder::create_int16(-60)));
+    EXPECT_FALSE(table.accepts(TestInterface::RSSI.id, Holder::create_string("-60")));
+    EXPECT_TRUE(table.accepts(TestInterface::VALUE.id, Holder::create_string("anything")));
+
+    // Properties must be given in the order of their ids.
+    EXPECT_THROW(PropertyTable(TestInterface::NAME, TestInterface::RSSI), std::invalid_argument);
+}
+
+TEST(InterfaceProperties, Load) {
+    auto proxy = std::make_shared<Proxy>(nullptr, "", "/");
+    TestInterface interface(proxy);
+
+    EXPECT_EQ(0, interface.get(TestInterface::RSSI));
+    EXPECT_EQ("", interface.get(TestInterface::NAME));
+
+    Holder properties = Holder::create_dict();
+    properties.dict_append(Holder::STRING, "RSSI", Holder::create_int16(-60));
+    properties.dict_append(Holder::STRING, "Name", Holder::create_string("Peripheral"));
+    properties.dict_append(Holder::STRING, "UUIDs", string_array({"180f", "180a"}));
+    properties.dict_append(Holder::STRING, "Paired", Holder::create_boolean(true));
+    interface.load(properties);
+
+    EXPECT_EQ(-60, interface.get(TestInterface::RSSI));
+    EXPECT_EQ("Peripheral", interface.get(TestInterface::NAME));
+    EXPECT_EQ(std::vector<std::string>({"180f", "180a"}), interface.get(TestInterface::UUIDS));
+    EXPECT_TRUE(interface.get_undeclared("Paired").get_boolean());
+
+    // Declared properties are dispatched by id, the others by name, in the order of the dictionary.
+    EXPECT_EQ(std::vector<PropertyId>({TestInterface::NAME.id, TestInterface::RSSI.id, TestInterface::UUIDS.id}),
+              interface.changed_ids);
+    EXPECT_EQ(std::vector<std::string>({"Paired"}), interface.changed_names);
+}
+
+TEST(InterfaceProperties, SignalChanges) {
+    auto proxy = std::make_shared<Proxy>(nullptr, "", "/");
+    TestInterface interface(proxy);
+
+    interface.signal_property_changed({{"RSSI", Holder::create_int16(-60)}, {"Value", Holder::create_byte(1)}}, {});
+    EXPECT_EQ(std::vector<PropertyId>({TestInterface::RSSI.id, TestInterface::VALUE.id}), interface.changed_ids);
+
+    // Updates carrying the cached value are only reported for events.
+    interface.changed_ids.clear();
+    interface.signal_property_changed({{"RSSI", Holder::create_int16(-60)}, {"Value", Holder::create_byte(1)}}, {});
+    EXPECT_EQ(std::vector<PropertyId>({TestInterface::VALUE.id}), interface.changed_ids);
+
+    interface.changed_ids.clear();
+    interface.signal_property_changed({{"RSSI", Holder::create_int16(-61)}}, {});
+    EXPECT_EQ(std::vector<PropertyId>({TestInterface::RSSI.id}), interface.changed_ids);
+    EXPECT_EQ(-61, interface.get(TestInterface::RSSI));
+
+    // Once invalidated, the same value is reported again.
+    interface.changed_ids.clear();
+    interface.signal_property_changed({}, {"RSSI"});
+    interface.signal_property_changed({{"RSSI", Holder::create_int16(-61)}}, {});
+    EXPECT_EQ(std::vector<PropertyId>({TestInterface::RSSI.id}), interface.changed_ids);
+
+    // Values of an unexpected type are dropped.
+    interface.changed_ids.clear();
+    interface.signal_property_changed({{"RSSI", Holder::create_string("-62")}}, {});
+    EXPECT_TRUE(interface.changed_ids.empty());
+    EXPECT_EQ(-61, interface.get(TestInterface::RSSI));
+    EXPECT_TRUE(interface.changed_names.empty());
+}
+
+TEST(InterfaceProperties, CollectAndAssign) {
+    auto proxy = std::make_shared<Proxy>(nullptr, "", "/");
+    TestInterface interface(proxy);
+
+    Holder properties = Holder::create_dict();
+    properties.dict_append(Holder::STRING, "RSSI", Holder::create_int16(-60));
+    properties.dict_append(Holder::STRING, "Adapter", Holder::create_object_path("/org/bluez/hci0"));
+    properties.dict_append(Holder::STRING, "UUIDs", string_array({"180f"}));
+    properties.dict_append(Holder::STRING, "Paired", Holder::create_boolean(true));
+    interface.load(properties);
+
+    // Only properties that have been received are collected, with the type they were received as.
+    Holder collected = interface.property_collect();
+    EXPECT_EQ(4, collected.dict_entries().size());
+    EXPECT_EQ(nullptr, collected.dict_find("Name"));
+    EXPECT_EQ(Holder::create_int16(-60), *collected.dict_find("RSSI"));
+    EXPECT_EQ(Holder::OBJ_PATH, collected.dict_find("Adapter")->type());
+    EXPECT_EQ("as", collected.dict_find("UUIDs")->signature());
+    EXPECT_EQ(Holder::create_boolean(true), *collected.dict_find("Paired"));
+
+    EXPECT_TRUE(interface.property_assign("RSSI", Holder::create_int16(-70)));
+    EXPECT_TRUE(interface.property_assign("Paired", Holder::create_boolean(false)));
+    EXPECT_FALSE(interface.property_assign("Name", Holder::create_string("Peripheral")));
+    EXPECT_FALSE(interface.property_assign("Connected", Holder::create_boolean(true)));
+    EXPECT_EQ(-70, interface.get(TestInterface::RSSI));
+    EXPECT_FALSE(interface.get_undeclared("Paired").get_boolean());
+}
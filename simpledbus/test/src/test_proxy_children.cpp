@@ -107,3 +107,38 @@ TEST(ProxyChildren, RemoveChildWithInterfaces) {
     p.path_remove("/a", removed_interfaces);
     ASSERT_EQ(0, p.children().size());
 }
+
+TEST(ProxyChildren, LookupDescendant) {
+    auto p = std::make_shared<Proxy>(nullptr, "", "/");
+    p->path_add("/a/b/c", Holder());
+    p->path_add("/a/d", Holder());
+
+    ASSERT_NE(nullptr, p->path_lookup("/a/b/c"));
+    EXPECT_EQ("/a/b/c", p->path_lookup("/a/b/c")->path());
+    EXPECT_EQ("/a/b", p->path_lookup("/a/b")->path());
+    EXPECT_EQ(nullptr, p->path_lookup("/a/b/c/e"));
+
+    // Any proxy of the tree finds the paths below it.
+    std::shared_ptr<Proxy> p_a = p->path_lookup("/a");
+    ASSERT_NE(nullptr, p_a);
+    EXPECT_EQ(p->path_lookup("/a/d"), p_a->path_lookup("/a/d"));
+    EXPECT_EQ(nullptr, p_a->path_lookup("/a"));
+
+    // Removed paths leave the index.
+    p->path_remove("/a/b/c", Holder::create_array());
+    EXPECT_EQ(nullptr, p->path_lookup("/a/b/c"));
+    EXPECT_EQ(0, p->path_lookup("/a/b")->children().size());
+
+    p->path_add("/a/b/c", Holder());
+    EXPECT_EQ(1, p->path_lookup("/a/b")->children().count("/a/b/c"));
+}
+
+TEST(ProxyChildren, AppendSiblingWithSharedPrefix) {
+    Proxy p = Proxy(nullptr, "", "/a");
+    p.path_add("/a/dev_1/x", Holder());
+    p.path_add("/a/dev_10/y", Holder());
+
+    ASSERT_EQ(2, p.children().size());
+    EXPECT_EQ(1, p.children().at("/a/dev_1")->children().count("/a/dev_1/x"));
+    EXPECT_EQ(1, p.children().at("/a/dev_10")->children().count("/a/dev_10/y"));
+}